@@ -26,6 +26,10 @@
 
 namespace antares {
 
+// How many times faster than normal the game runs while the fast motion key is held.
+const int kMinFastMotion = 2;
+const int kMaxFastMotion = 64;
+
 struct Preferences {
     Preferences();
     Preferences copy() const;
@@ -35,6 +39,7 @@ struct Preferences {
     bool       play_music_in_game;
     bool       speech_on;
     int16_t    volume;
+    int16_t    fast_motion;
     pn::string scenario_identifier;
 };
 
@@ -51,6 +56,7 @@ class PrefsDriver {
     bool            play_music_in_game() const { return get().play_music_in_game; }
     bool            speech_on() const { return get().speech_on; }
     int             volume() const { return get().volume; }
+    int             fast_motion() const;
     pn::string_view scenario_identifier() const { return get().scenario_identifier; }
 
     void set_key(size_t index, Key key);
@@ -58,6 +64,7 @@ class PrefsDriver {
     void set_play_music_in_game(bool on);
     void set_speech_on(bool on);
     void set_volume(int volume);
+    void set_fast_motion(int fast_motion);
     void set_scenario_identifier(pn::string_view id);
 
     static PrefsDriver* driver();
@@ -19,6 +19,7 @@
 #ifndef ANTARES_DATA_HANDLE_HPP_
 #define ANTARES_DATA_HANDLE_HPP_
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <pn/string>
 
@@ -54,6 +55,34 @@ inline bool operator!=(Handle<T> x, Handle<T> y) {
     return !(x == y);
 }
 
+// Space objects are freed and their slots reused constantly, so a Handle<SpaceObject> also
+// carries the generation of the slot it was taken from. Freeing an object bumps the generation
+// of its slot, so every outstanding handle to it becomes expired(), even once the slot holds a
+// new object. get() still returns the slot; check expired() before trusting what's there.
+//
+// Members that need the object pool are defined in game/space-object.hpp.
+template <>
+class Handle<SpaceObject> {
+  public:
+    Handle() : _number(-1), _generation(0) {}
+    explicit Handle(int number);
+    Handle(int number, uint32_t generation) : _number(number), _generation(generation) {}
+    int          number() const { return _number; }
+    uint32_t     generation() const { return _generation; }
+    bool         expired() const;
+    SpaceObject* get() const;
+    SpaceObject& operator*() const;
+    SpaceObject* operator->() const;
+
+  private:
+    int      _number;
+    uint32_t _generation;
+};
+inline bool operator==(Handle<SpaceObject> x, Handle<SpaceObject> y) {
+    return (x.number() == y.number()) && (x.generation() == y.generation());
+}
+inline bool operator!=(Handle<SpaceObject> x, Handle<SpaceObject> y) { return !(x == y); }
+
 template <typename T>
 class HandleList {
   public:
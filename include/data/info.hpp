@@ -23,6 +23,7 @@
 #include <sfz/sfz.hpp>
 
 #include "data/handle.hpp"
+#include "math/random.hpp"
 
 namespace antares {
 
@@ -44,6 +45,8 @@ struct Info {
     sfz::optional<pn::string> about;
 
     pn::string version;
+
+    RandomMode random;  // Defaults to LEGACY, which old replays depend on.
 };
 
 Info info(path_value x);
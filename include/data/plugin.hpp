@@ -39,6 +39,10 @@ struct ScenarioGlobals {
     std::map<pn::string, BaseObject> objects;
     std::map<pn::string, Race>       races;
 
+    // `objects` again, keyed by views of its keys, so that BaseObject::get() can look up a name
+    // without copying it. load_object() adds to both; clear both together.
+    std::map<pn::string_view, BaseObject*> objects_by_name;
+
     Texture splash;
     Texture starmap;
 };
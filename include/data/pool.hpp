@@ -0,0 +1,77 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_POOL_HPP_
+#define ANTARES_DATA_POOL_HPP_
+
+#include <memory>
+#include <vector>
+
+namespace antares {
+
+// Growable storage for the objects that a Handle<T> refers to.
+//
+// Elements live in fixed-size chunks, so growing the pool never moves an existing element.
+// Pointers obtained from get() remain valid until the next reset(), even if the pool grows in
+// the meantime (e.g. when an action creates objects while its subject is being updated).
+template <typename T>
+class Pool {
+  public:
+    static const int kChunkShift = 8;
+    static const int kChunkSize  = 1 << kChunkShift;
+
+    int size() const { return _size; }
+
+    T* get(int number) const {
+        if ((0 <= number) && (number < _size)) {
+            return &_chunks[number >> kChunkShift][number & (kChunkSize - 1)];
+        }
+        return nullptr;
+    }
+
+    // Discards all elements, then allocates room for at least `size` default elements.
+    void reset(int size) {
+        _chunks.clear();
+        _size = 0;
+        grow(size);
+    }
+
+    // Adds default elements until there is room for at least `size`.
+    void grow(int size) {
+        while (_size < size) {
+            _chunks.emplace_back(new T[kChunkSize]);
+            _size += kChunkSize;
+        }
+    }
+
+    // Discards chunks until there is room for no more than `size` elements (rounded up to a
+    // whole chunk). Like reset(), this invalidates pointers into the discarded chunks.
+    void shrink(int size) {
+        while (_size - kChunkSize >= size) {
+            _chunks.pop_back();
+            _size -= kChunkSize;
+        }
+    }
+
+  private:
+    std::vector<std::unique_ptr<T[]>> _chunks;
+    int                               _size = 0;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_POOL_HPP_
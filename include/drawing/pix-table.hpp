@@ -19,6 +19,8 @@
 #ifndef ANTARES_DRAWING_PIX_TABLE_HPP_
 #define ANTARES_DRAWING_PIX_TABLE_HPP_
 
+#include <memory>
+#include <pn/string>
 #include <vector>
 
 #include "drawing/pix-map.hpp"
@@ -31,6 +33,11 @@ class NatePixTable {
     class Frame;
 
     NatePixTable(pn::string_view name, Hue hue);
+
+    // The same images as `other`, in another hue. Shares the images, and their storage on the
+    // GPU if the video driver can tint them.
+    NatePixTable(const NatePixTable& other, Hue hue);
+
     NatePixTable(const NatePixTable&) = delete;
     NatePixTable(NatePixTable&&)      = default;
     NatePixTable& operator=(const NatePixTable&) = delete;
@@ -41,15 +48,16 @@ class NatePixTable {
     size_t       size() const;
 
   private:
+    pn::string         _name;
     size_t             _size;
     std::vector<Frame> _frames;
 };
 
 class NatePixTable::Frame {
   public:
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame);
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-          Hue hue);
+    Frame(Rect bounds, const PixMap& image, const PixMap& overlay, pn::string_view name,
+          int frame, Hue hue);
+    Frame(const Frame& other, pn::string_view name, int frame, Hue hue);
     Frame(Frame&&) = default;
     ~Frame();
 
@@ -57,17 +65,17 @@ class NatePixTable::Frame {
     uint16_t       height() const;
     Size           size() const { return Size{width(), height()}; };
     Point          center() const;
-    const PixMap&  pix_map() const;
+    ArrayPixMap    pix_map() const;  // With the overlay composited on the CPU.
     const Texture& texture() const;
 
   private:
-    void load_image(const PixMap& pix);
-    void load_overlay(const PixMap& pix, Hue hue);
-    void build(pn::string_view name, int frame);
+    void build(pn::string_view name, int frame, const Frame* other);
 
-    Rect        _bounds;
-    ArrayPixMap _pix_map;
-    Texture     _texture;
+    Rect                               _bounds;
+    Hue                                _hue;
+    std::shared_ptr<const ArrayPixMap> _image;
+    std::shared_ptr<const ArrayPixMap> _overlay;
+    Texture                            _texture;
 };
 
 }  // namespace antares
@@ -30,6 +30,8 @@
 
 namespace antares {
 
+struct RenderFrame;
+
 const int32_t kNoSpriteTable = -1;
 
 const int16_t kSpriteTableColorShift  = 11;
@@ -52,7 +54,7 @@ class Sprite {
   public:
     static Sprite*            get(int number);
     static Handle<Sprite>     none() { return Handle<Sprite>(-1); }
-    static HandleList<Sprite> all() { return HandleList<Sprite>(0, size); }
+    static HandleList<Sprite> all();
 
     Sprite();
 
@@ -70,12 +72,13 @@ class Sprite {
     } tinyColor;
     bool        killMe;
     draw_tiny_t draw_tiny;
+    int32_t     generation;  // Bumped each time AddSprite() reuses this one.
 
     BaseObject::Icon icon;
 
   private:
-    friend void         SpriteHandlingInit();
-    static const size_t size = 500;
+    friend void      SpriteHandlingInit();
+    static const int size = 500;  // Initial capacity; grows as needed.
 };
 
 extern Scale gAbsoluteScale;
@@ -88,8 +91,15 @@ class Pix {
     const NatePixTable* cursor();
 
   private:
-    std::map<std::pair<pn::string, Hue>, NatePixTable> _pix;
-    std::unique_ptr<NatePixTable>                      _cursor;
+    struct Entry {
+        pn::string   name;
+        NatePixTable table;
+    };
+
+    // Keyed by a view of the entry's own name, so that get() can look up a name without copying
+    // it, as it does whenever an object is created.
+    std::map<std::pair<pn::string_view, Hue>, std::unique_ptr<Entry>> _pix;
+    std::unique_ptr<NatePixTable>                                      _cursor;
 };
 
 void           SpriteHandlingInit();
@@ -100,7 +110,8 @@ Handle<Sprite> AddSprite(
         Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
         uint8_t tiny_shade);
 void RemoveSprite(Handle<Sprite> sprite);
-void draw_sprites();
+void capture_sprites(RenderFrame* frame);
+void draw_sprites(const RenderFrame& frame);
 void CullSprites();
 
 }  // namespace antares
@@ -20,11 +20,15 @@
 #define ANTARES_GAME_ACTION_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "data/base-object.hpp"
+#include "math/units.hpp"
 
 namespace antares {
 
+class SnapshotArchive;
+
 // Returns true iff {in,ex}clusive_filter() allows `action` to run over
 // `target`. The baseObject version uses the default attributes of the
 // object, and the spaceObject version uses the actual attributes in
@@ -35,10 +39,31 @@ void exec(
         const std::vector<Action>& actions, Handle<SpaceObject> sObject,
         Handle<SpaceObject> dObject, Point offset);
 
-struct actionQueueType;
+// Compiles `actions` into a flat program, with groups inlined and filters resolved. Levels
+// compile the lists they might run while loading, so that doing so doesn't allocate mid-level;
+// any others are compiled the first time they run.
+void compile_actions(const std::vector<Action>& actions);
+
+// The work done running and compiling actions since the level started.
+struct ActionStats {
+    int64_t executed = 0;  // Actions that passed or failed their filters.
+    int32_t compiled = 0;  // Action lists compiled.
+};
+extern ActionStats action_stats;
+
+// Actions waiting on a “delay” action, in a binary heap ordered by when they're due. Actions due
+// on the same tick run newest first, as they always have.
 struct ActionQueue {
-    actionQueueType*                   first;
-    std::unique_ptr<actionQueueType[]> data;
+    struct Entry;
+
+    ticks                               clock;    // Advanced by execute_action_queue().
+    int64_t                             queued;   // Total queued since the reset; orders ties.
+    size_t                              peak;     // Most actions pending at once since the reset.
+    std::vector<std::unique_ptr<Entry>> pending;  // Heap; the next action to run is at the front.
+    std::vector<std::unique_ptr<Entry>> spare;    // Entries to reuse, so delays don't allocate.
+
+    size_t depth() const { return pending.size(); }
+    void   snapshot(SnapshotArchive& a);
 
     ActionQueue();
     ~ActionQueue();
@@ -68,6 +68,8 @@ const size_t  kMaxPlayerNum    = 4;
 const int32_t kMaxDestObject   = 10;  // we keep special track of dest objects for AI
 const int32_t kAdmiralScoreNum = 3;
 
+class SnapshotArchive;
+
 struct Destination {
     static Destination*            get(int i);
     static Handle<Destination>     none() { return Handle<Destination>(-1); }
@@ -101,6 +103,8 @@ class Admiral {
     static Handle<Admiral>     none() { return Handle<Admiral>(-1); }
     static HandleList<Admiral> all() { return HandleList<Admiral>(0, kMaxPlayerNum); }
 
+    int32_t number() const;
+
     void think();
     bool build(int32_t buildWhichType);
     void pay(Cash howMuch);
@@ -115,13 +119,11 @@ class Admiral {
     uint32_t&           attributes() { return _attributes; }
     bool                has_destination() { return _has_destination; }
     Handle<SpaceObject> destinationObject() { return _destinationObject; }
-    int32_t             destinationObjectID() { return _destinationObjectID; }
 
     Handle<SpaceObject> flagship() { return _flagship; }
     void                set_flagship(Handle<SpaceObject> object) { _flagship = object; }
 
     Handle<SpaceObject>  considerShip() { return _considerShip; }
-    int32_t              considerShipID() { return _considerShipID; }
     int32_t              considerDestination() { return _considerDestination; }
     Handle<Destination>& buildAtObject() {
         return _buildAtObject;
@@ -149,6 +151,8 @@ class Admiral {
     pn::string_view                 name() { return _name; }
     uint32_t&                       cheats() { return _cheats; }
 
+    void snapshot(SnapshotArchive& a);
+
   private:
     static Handle<Admiral> make(
             int index, uint32_t attributes, pn::string_view name,
@@ -158,10 +162,8 @@ class Admiral {
     uint32_t                       _attributes;
     bool                           _has_destination = false;
     Handle<SpaceObject>            _destinationObject;
-    int32_t                        _destinationObjectID = -1;
     Handle<SpaceObject>            _flagship;
     Handle<SpaceObject>            _considerShip;
-    int32_t                        _considerShipID      = -1;
     int32_t                        _considerDestination = kNoShip;
     Handle<Destination>            _buildAtObject;  // # of destination object to build at
     NamedHandle<const Race>        _race;
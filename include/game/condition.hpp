@@ -19,11 +19,41 @@
 #ifndef ANTARES_GAME_CONDITION_HPP_
 #define ANTARES_GAME_CONDITION_HPP_
 
+#include <stdint.h>
+#include <vector>
+
+#include "data/handle.hpp"
 #include "data/level.hpp"
 
 namespace antares {
 
+// Counts changes to game state that conditions read. Changing an admiral's cash, ship count, or
+// score, or an object's health, owner, or type, bumps its count, which marks the conditions that
+// read it as dirty.
+struct ConditionInputs {
+    std::vector<uint32_t> admirals;  // By admiral number.
+    std::vector<uint32_t> objects;   // By object number.
+};
+
+// What a condition read when CheckLevelConditions() last evaluated it. If it reads the same thing
+// again, the condition is clean, and its last value still holds.
+struct ConditionCheck {
+    bool                 valid = false;
+    bool                 value = false;
+    std::vector<int64_t> inputs;
+};
+
+// How many conditions the last call to CheckLevelConditions() evaluated.
+struct ConditionStats {
+    int32_t evaluated = 0;  // Dirty, or read something that changes on its own, like the time.
+    int32_t skipped   = 0;  // Clean.
+};
+extern ConditionStats condition_stats;
+
+void build_condition_graphs();
 void CheckLevelConditions();
+void mark_conditions_dirty(Handle<Admiral> admiral);
+void mark_conditions_dirty(const SpaceObject& object);
 
 }  // namespace antares
 
@@ -25,9 +25,13 @@
 #include "data/enums.hpp"
 #include "data/handle.hpp"
 #include "data/level.hpp"
+#include "data/pool.hpp"
 #include "drawing/color.hpp"
 #include "game/action.hpp"
+#include "game/condition.hpp"
+#include "game/render-frame.hpp"
 #include "game/starfield.hpp"
+#include "lang/arena.hpp"
 #include "math/random.hpp"
 #include "math/units.hpp"
 #include "sound/fx.hpp"
@@ -55,7 +59,6 @@ struct miniComputerDataType {
 
 struct hotKeyType {
     Handle<SpaceObject> object;
-    int32_t             objectID;
 };
 
 class Admiral;
@@ -74,21 +77,28 @@ struct GlobalState {
     const Level* level = nullptr;
     int32_t      angle;
 
+    RandomMode random_mode;     // From the plugin; see random_source().
+    int32_t    level_seed;      // Value of random.seed when the level started.
+    int64_t    random_streams;  // Streams random_source() has keyed this level (COUNTER only).
+
     std::unique_ptr<Admiral[]> admirals;  // All admirals (whether active or not).
     Handle<Admiral>            admiral;   // Local player.
 
-    std::unique_ptr<SpaceObject[]> objects;  // All space objects (whether active or not).
-    Handle<SpaceObject>            ship;     // Local player's flagship.
-    Handle<SpaceObject>            root;     // Head of LL of active objs, in creation time order.
+    Pool<SpaceObject>     objects;         // All space objects (whether active or not).
+    std::vector<uint32_t> generations;     // Per object; bumped when the object is freed.
+    std::vector<int32_t>  free_objects;    // Min-heap of available object numbers.
+    std::vector<int32_t>  active_objects;  // Active object numbers, oldest first; -1 if freed.
+    Handle<SpaceObject>   ship;            // Local player's flagship.
 
-    std::unique_ptr<Vector[]>      vectors;       // Auxiliary info for kIsVector objects.
+    Pool<Vector>                   vectors;       // Auxiliary info for kIsVector objects.
     std::unique_ptr<Destination[]> destinations;  // Auxiliary info for kIsDestination objects.
-    std::unique_ptr<Sprite[]>      sprites;       // Auxiliary info for objects with sprites.
+    Pool<Sprite>                   sprites;       // Auxiliary info for objects with sprites.
 
-    std::vector<Handle<SpaceObject>> initials;     // May change due to assume initial.
-    std::vector<int32_t>             initial_ids;  // Ditto.
+    std::vector<Handle<SpaceObject>> initials;  // May change due to assume initial.
 
-    std::vector<bool> condition_enabled;  // Check conditions if enabled or persistent.
+    std::vector<bool>           condition_enabled;  // Check conditions if enabled or persistent.
+    std::vector<ConditionCheck> condition_checks;   // What each condition read when last checked.
+    ConditionInputs             condition_inputs;   // Changes to what conditions read.
 
     ActionQueue action_queue;  // Actions pending due to “delay” action.
 
@@ -124,6 +134,15 @@ extern GlobalState& g;  // head
 extern GlobalState  head;
 extern GlobalState  tail;
 
+// For data that only lives until the end of the current major tick, such as strings built to be
+// copied into a message or label. The game loops reset it after each major tick.
+extern Arena tick_arena;
+
+// Where `id` should draw random numbers for `purpose` on the current tick: g.random for
+// RandomMode::LEGACY, or for RandomMode::COUNTER, a stream keyed by the level seed, the tick,
+// `id`, and `serial`, which gives the same draws no matter what else has drawn before it.
+RandomSource random_source(RandomPurpose purpose, int32_t id, int32_t serial = 0);
+
 struct aresGlobalType {
     aresGlobalType();
     ~aresGlobalType();
@@ -131,12 +150,12 @@ struct aresGlobalType {
     hotKeyType hotKey[kHotKeyNum];
 
     Handle<SpaceObject> lastSelectedObject;
-    int32_t             lastSelectedObjectID;
 
     game_ticks next_klaxon;
 
-    Starfield   starfield;
-    Transitions transitions;
+    Starfield    starfield;
+    Transitions  transitions;
+    RenderFrames frames;  // What GamePlay draws; published after each tick.
 };
 
 aresGlobalType* globals();
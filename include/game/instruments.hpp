@@ -26,6 +26,7 @@
 namespace antares {
 
 class PlayerShip;
+struct RenderFrame;
 
 const int32_t kMiniBuildTimeHeight = 25;
 
@@ -35,7 +36,8 @@ void    UpdateRadar(ticks units);
 void    InstrumentCleanup();
 void    ResetInstruments();
 void    set_up_instruments();
-void    draw_instruments();
+void    capture_instruments(RenderFrame* frame);
+void    draw_instruments(const RenderFrame& frame);
 void    EraseSite();
 bool    update_site();
 void    draw_site(const PlayerShip& player);
@@ -26,6 +26,8 @@
 
 namespace antares {
 
+struct RenderFrame;
+
 class Label {
   public:
     static const int32_t kNone        = -1;
@@ -41,7 +43,8 @@ class Label {
     static Handle<Label> add(
             int16_t h, int16_t v, int16_t hoff, int16_t voff, Handle<SpaceObject> object,
             bool objectLink, Hue hue);
-    static void draw();
+    static void capture(RenderFrame* frame);
+    static void draw(const RenderFrame& frame);
     static void update_contents(ticks units_done);
     static void update_positions(ticks units_done);
     static void show_all();
@@ -79,6 +82,7 @@ class Label {
     Handle<SpaceObject> object;
     bool                objectLink = true;  // true if label requires an object to be seen
     int32_t             lineNum    = 1;
+    int32_t             generation = 0;  // Bumped each time add() reuses this label.
     bool  keepOnScreenAnyway = false;  // if not attached to object, keep on screen if it's off
     bool  attachedHintLine   = false;
     Point attachedToWhere;
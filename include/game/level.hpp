@@ -27,9 +27,12 @@
 #include "data/handle.hpp"
 #include "math/geometry.hpp"
 #include "math/scale.hpp"
+#include "math/units.hpp"
 
 namespace antares {
 
+class InputSource;
+class PlayerShip;
 union Level;
 
 struct LoadState {
@@ -44,6 +47,13 @@ void      DeclareWinner(Handle<Admiral> whichPlayer, const Level* nextLevel, pn:
 void      GetLevelFullScaleAndCorner(int32_t rotation, Point* corner, Scale* scale, Rect* bounds);
 Point     Translate_Coord_To_Level_Rotation(int32_t h, int32_t v);
 
+// Simulates `units` of play, which must not run past the end of a major tick. GamePlay,
+// simulate_loaded_level(), and Rollback all tick through here, so that they agree; GamePlay
+// updates what's drawn between play_tick() and end_play_tick(). On each major tick, `input` sends
+// the local player's input to `player_ship`, and ends the game if it has run out.
+void play_tick(ticks units, InputSource* input, PlayerShip* player_ship);
+void end_play_tick();
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_LEVEL_HPP_
@@ -61,6 +61,14 @@ class MainPlay : public Card {
     InputSource*      _input_source;
 };
 
+// Plays `level` to the end with input from `input`, without a Card stack and without updating
+// anything that is only drawn: the starfield, labels, radar, and so on. The simulation comes out
+// as it would from MainPlay, so a replay's outcome and g.sync can be checked much faster.
+GameResult simulate_level(const Level& level, InputSource* input);
+
+// The same, for a level that construct_level() has already finished loading.
+GameResult simulate_loaded_level(InputSource* input);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_MAIN_HPP_
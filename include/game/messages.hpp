@@ -20,7 +20,6 @@
 #define ANTARES_GAME_MESSAGES_HPP_
 
 #include <pn/string>
-#include <queue>
 
 #include "data/handle.hpp"
 #include "drawing/color.hpp"
@@ -30,6 +29,8 @@
 
 namespace antares {
 
+class SnapshotArchive;
+
 class Messages {
   public:
     static void init();
@@ -49,19 +50,23 @@ class Messages {
     static void max_ships_built();
 
     static void draw_long_message(ticks time_pass);
+    static void layout();
     static void draw_message_screen(ticks by_units);
     static void draw_message();
 
     static pn::string_view pause_string();
 
+    static void snapshot(SnapshotArchive& a);
+
   private:
+    struct MessageQueue;
     struct longMessageType;
 
     static void set_status(pn::string_view status, Hue hue);
 
-    static std::queue<pn::string> message_data;
-    static longMessageType*       long_message_data;
-    static ticks                  time_count;
+    static MessageQueue     message_data;
+    static longMessageType* long_message_data;
+    static ticks            time_count;
 };
 
 }  // namespace antares
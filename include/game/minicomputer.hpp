@@ -28,6 +28,8 @@
 
 namespace antares {
 
+class SnapshotArchive;
+
 enum MiniScreenLineKind {
     MINI_NONE       = 0,
     MINI_DIM        = 1,
@@ -94,6 +96,8 @@ void MiniComputerHandleMouseUp(Point, std::vector<PlayerEvent>* player_events);
 void MiniComputerHandleMouseStillDown(Point);
 void MiniComputer_SetScreenAndLineHack(Screen whichScreen, int32_t whichLine);
 
+void minicomputer_snapshot(SnapshotArchive& a);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_MINICOMPUTER_HPP_
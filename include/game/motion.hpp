@@ -19,6 +19,8 @@
 #ifndef ANTARES_GAME_MOTION_HPP_
 #define ANTARES_GAME_MOTION_HPP_
 
+#include <pn/string>
+
 #include "data/base-object.hpp"
 #include "math/scale.hpp"
 #include "math/units.hpp"
@@ -32,6 +34,25 @@ struct ScaledScreen {
 extern ScaledScreen scaled_screen;
 Point               scale_to_viewport(Point p);
 
+// How many pairs of nearby objects the last call to CollideSpaceObjects() looked at.
+struct CollisionStats {
+    int32_t near_pairs = 0;  // Candidates for collision.
+    int32_t far_pairs  = 0;  // Candidates for locality (strength, closest object, visibility).
+};
+extern CollisionStats collision_stats;
+
+// How CollideSpaceObjects() finds pairs of objects that might collide.
+//
+// GRID is the original: every pair of objects in the same or adjacent grid cells. SWEEP keeps
+// the objects sorted by their bounds from tick to tick, and only looks at the pairs whose bounds
+// overlap, retesting objects that a collision pushes. Both visit the same colliding pairs in the
+// same order, so a level plays out the same with either.
+enum class Broadphase { GRID, SWEEP };
+extern Broadphase broadphase;
+
+// Parses a --broadphase option: "grid" or "sweep". Throws on anything else.
+void broadphase_option(pn::string_view value, Broadphase* out);
+
 void ResetMotionGlobals();
 
 void MoveSpaceObjects(ticks unitsToDo);
@@ -36,6 +36,7 @@ void fire_weapon(
         Handle<SpaceObject> subject, Handle<SpaceObject> target, SpaceObject::Weapon& weapon,
         const std::vector<fixedPointType>& positions);
 void                NonplayerShipThink();
+void                SetThinkThreads(int threads);  // Same decisions for any number of threads.
 void                HitObject(Handle<SpaceObject> anObject, Handle<SpaceObject> sObject);
 Handle<SpaceObject> GetManualSelectObject(
         Handle<SpaceObject> sourceObject, int32_t direction, uint32_t inclusiveAttributes,
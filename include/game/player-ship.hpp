@@ -99,6 +99,7 @@ struct PlayerEvent {
 
 class GameCursor;
 class InputSource;
+class SnapshotArchive;
 
 class PlayerShip : public EventReceiver {
   public:
@@ -117,6 +118,9 @@ class PlayerShip : public EventReceiver {
 
     void update();
 
+    // Copies the keys and buttons held, which carry over from one tick to the next.
+    void snapshot(SnapshotArchive& a);
+
     bool    show_select() const;
     bool    show_target() const;
     int32_t control_direction() const;
@@ -0,0 +1,123 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_PROFILE_HPP_
+#define ANTARES_GAME_PROFILE_HPP_
+
+#include <stdint.h>
+#include <chrono>
+#include <limits>
+#include <pn/string>
+#include <vector>
+
+namespace antares {
+
+// The parts of a tick that are timed separately.
+enum class TickPhase {
+    MOVE,
+    THINK,
+    ADMIRAL,
+    ACTIONS,
+    COLLIDE,
+    CONDITIONS,
+    MINICOMPUTER,
+    MESSAGES,
+    LABELS,
+    VECTORS,
+    RADAR,
+};
+const int kTickPhaseCount = static_cast<int>(TickPhase::RADAR) + 1;
+
+pn::string_view phase_name(TickPhase phase);
+
+struct PhaseTimes {
+    int64_t                  ticks = 0;  // Number of samples.
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds max{0};
+};
+
+// Collects how long each phase of the game loop takes. Time spent in a phase adds up until
+// end_tick(), which the loops call once per major tick, so each sample covers a major tick and
+// the minor ticks before it. The wall time between calls to end_tick() (or reset()) is kept too,
+// as the time for the whole tick.
+//
+// Off by default; while off, PhaseTimer doesn't read the clock.
+class TickProfile {
+  public:
+    bool enabled() const { return _enabled; }
+    void set_enabled(bool enabled) { _enabled = enabled; }
+
+    // If set, called at each end_tick() to count the heap allocations made during the tick. The
+    // binaries that can count them pass allocation_count() from lang/alloc-count.hpp.
+    typedef int64_t (*AllocationCounter)();
+    void set_allocation_counter(AllocationCounter counter) { _allocation_counter = counter; }
+
+    void add(TickPhase phase, std::chrono::nanoseconds time) {
+        _current[static_cast<int>(phase)] += time;
+    }
+    void end_tick();
+    void reset();
+
+    // Percentiles over the last `last` samples, or all of them.
+    PhaseTimes times(TickPhase phase, size_t last = std::numeric_limits<size_t>::max()) const;
+    PhaseTimes tick_times(size_t last = std::numeric_limits<size_t>::max()) const;
+
+    // Allocations made during each tick, oldest first, if there's an allocation counter.
+    const std::vector<int64_t>& tick_allocations() const { return _tick_allocations; }
+
+    pn::string json() const;
+    pn::string csv() const;
+
+  private:
+    bool                                  _enabled = false;
+    std::chrono::nanoseconds              _current[kTickPhaseCount];
+    std::vector<int64_t>                  _samples[kTickPhaseCount];  // Nanoseconds.
+    std::chrono::steady_clock::time_point _tick_start;
+    std::vector<int64_t>                  _tick_samples;
+    AllocationCounter                     _allocation_counter = nullptr;
+    int64_t                               _allocation_start   = 0;
+    std::vector<int64_t>                  _tick_allocations;
+};
+extern TickProfile tick_profile;
+
+// Adds the time until it goes out of scope to `phase`.
+class PhaseTimer {
+  public:
+    explicit PhaseTimer(TickPhase phase) : _phase(phase), _on(tick_profile.enabled()) {
+        if (_on) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    ~PhaseTimer() {
+        if (_on) {
+            tick_profile.add(_phase, std::chrono::steady_clock::now() - _start);
+        }
+    }
+
+  private:
+    const TickPhase                       _phase;
+    const bool                            _on;
+    std::chrono::steady_clock::time_point _start;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_PROFILE_HPP_
@@ -0,0 +1,150 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_GAME_RENDER_FRAME_HPP_
+#define ANTARES_GAME_RENDER_FRAME_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "data/base-object.hpp"
+#include "data/cash.hpp"
+#include "drawing/color.hpp"
+#include "drawing/pix-table.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "math/geometry.hpp"
+#include "math/scale.hpp"
+#include "math/units.hpp"
+
+namespace antares {
+
+// What GamePlay::draw() shows of the simulation, copied out at the end of each tick. Drawing
+// reads only this, so it can happen between ticks, or while the next one runs, without seeing
+// state that is half updated.
+//
+// Each part is captured by the module that owns it, in the order that module used to draw it.
+// Sprites, stars, and labels carry their number and generation, which together identify the same
+// thing across frames: a number is reused once freed, but its generation is bumped when it is.
+// The vectors keep their capacity from tick to tick, so capturing doesn't allocate once a level
+// is underway.
+struct RenderFrame {
+    struct SpriteView {
+        int32_t                    number;  // For matching sprites across frames.
+        int32_t                    generation;
+        Point                      where;
+        const NatePixTable::Frame* frame;
+        Scale                      scale;
+        spriteStyleType            style;
+        RgbColor                   style_color;
+        int16_t                    style_data;
+        BaseObject::Layer          layer;
+        int32_t                    tiny_size;
+        RgbColor                   tiny_color;
+        draw_tiny_t                draw_tiny;
+    };
+
+    struct LineView {
+        Point    from, to;
+        RgbColor color;
+    };
+
+    struct StarView {
+        int32_t  number;  // Index into the starfield.
+        int32_t  generation;
+        Point    location;
+        Point    old_location;
+        RgbColor color;
+    };
+
+    struct LabelView {
+        int32_t number;
+        int32_t generation;
+        Rect    rect;
+        Hue     hue;
+    };
+
+    struct InstrumentView {
+        bool    ship = false;
+        int32_t ammo[3];
+        int32_t shield, max_shield;
+        int32_t energy, max_energy;
+        int32_t battery, max_battery;
+
+        bool    building   = false;
+        int32_t build_time = 0;  // Out of kMiniBuildTimeHeight.
+        Cash    cash;
+
+        bool               radar_on = false;
+        ticks              radar_count;
+        Rect               radar_range;
+        std::vector<Point> radar_blips;
+    };
+
+    wall_time at;     // The wall time of the tick this was captured after.
+    Scale     scale;  // gAbsoluteScale.
+
+    std::vector<SpriteView> sprites;
+    std::vector<LineView>   vectors;
+    std::vector<StarView>   stars;
+    bool                    star_streaks = false;  // Lines from old_location, while warping.
+    std::vector<StarView>   sparks;
+    std::vector<LabelView>  labels;
+    InstrumentView          instruments;
+
+    void capture(wall_time at);
+};
+
+// The last two frames that the simulation published. The simulation captures into the older
+// one and swaps; drawing reads the newer one, or a blend of the two.
+//
+// Whoever publishes and draws must not do both at once. The video drivers already ensure this:
+// the GLFW driver, which ticks on a thread of its own, holds the card stack's lock for both.
+class RenderFrames {
+  public:
+    RenderFrames() = default;
+    RenderFrames(const RenderFrames&) = delete;
+    RenderFrames& operator=(const RenderFrames&) = delete;
+
+    // Forgets earlier frames, so that the next blend() doesn't move anything from where it was
+    // in the previous level.
+    void reset();
+
+    void publish(wall_time at);
+
+    const RenderFrame& previous() const { return _frames[1 - _current]; }
+    const RenderFrame& current() const { return _frames[_current]; }
+
+    // Returns the frame to draw at `now`, which lags the simulation by one tick: positions of
+    // sprites, labels, and stars move from the previous frame towards the current one over the
+    // time that passed between them, so that a display faster than the tick rate sees them
+    // move on every refresh. Everything else is as in the current frame.
+    const RenderFrame& blend(wall_time now);
+
+  private:
+    RenderFrame _frames[2];
+    int         _current = 0;
+    RenderFrame _blended;
+};
+
+// Returns `from` moved `fraction` of the way to `to`, unless they are too far apart to have
+// moved between two ticks (a warp, or a number reused by something else), in which case `to`.
+Point interpolate(Point from, Point to, double fraction);
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_RENDER_FRAME_HPP_
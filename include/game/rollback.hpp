@@ -0,0 +1,117 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_GAME_ROLLBACK_HPP_
+#define ANTARES_GAME_ROLLBACK_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "data/handle.hpp"
+#include "data/replay.hpp"
+#include "game/input-source.hpp"
+#include "game/player-ship.hpp"
+#include "game/snapshot.hpp"
+
+namespace antares {
+
+// Head may run this many major ticks (two seconds) ahead of tail. Beyond that, advance() waits
+// for input instead of predicting further. It's also the most that one call to advance() will
+// simulate, counting both catching tail up and predicting; if more input arrives at once than
+// that, tail catches up over several calls.
+const int64_t kMaxPrediction = 40;
+
+struct RollbackStats {
+    int64_t rollbacks   = 0;  // Times head was discarded and re-simulated from tail.
+    int64_t simulated   = 0;  // Major ticks simulated, including re-simulations.
+    int64_t most        = 0;  // Most major ticks simulated by a single advance().
+    double  most_micros = 0;  // Longest time taken by a single advance().
+};
+
+// Predictive simulation, as described in doc/net.rst.
+//
+// Each player has an input log: keys pressed and released on each major tick, in the same form
+// as a replay, plus the major tick through which the log is complete. Tail is the state of the
+// level after the last major tick that every player's log covers, and is authoritative. Head is
+// tail, simulated forward to the present on the assumption that nobody presses or releases
+// anything past the end of their log. Whenever input arrives for a tick that head has already
+// simulated, head is discarded and re-simulated from tail.
+//
+// Logged keys are the flagship keys (thrust, turn, fire, and warp), which steer the admiral's
+// flagship when it's piloted by a player. The local player's go through a PlayerShip, as a
+// replay's do, and head ticks through play_tick(), so a rollback comes out as a replay of the same
+// input would.
+class Rollback {
+  public:
+    explicit Rollback(std::vector<Handle<Admiral>> players);
+
+    // Takes the level as it stands as tail, at major tick 0. Call it once play has begun: after
+    // set_up_instruments() and the first CheckLevelConditions(), as simulate_loaded_level() does.
+    void start();
+
+    // Adds input to `player`'s log: it's complete through major tick `through`, and `actions`
+    // holds (at least) every action after the end of the log as it was. Actions already in the
+    // log are ignored, so resent input is harmless.
+    void receive(
+            Handle<Admiral> player, uint64_t through,
+            const std::vector<ReplayData::Action>& actions);
+
+    // Brings head up to major tick `at`, or as near as kMaxPrediction allows, re-simulating from
+    // tail if necessary. Simulates at most kMaxPrediction major ticks. Returns the major tick head
+    // ended up at.
+    uint64_t advance(uint64_t at);
+
+    uint64_t             head() const { return _head; }
+    uint64_t             tail() const { return _tail; }
+    uint32_t             tail_sync() const { return _tail_sync; }  // g.sync as of tail.
+    const RollbackStats& stats() const { return _stats; }
+
+  private:
+    struct Log {
+        Handle<Admiral>                 player;
+        uint64_t                        through = 0;
+        std::vector<ReplayData::Action> actions;  // In order of `at`.
+    };
+
+    // Gives play_tick() the input logged for head.
+    class LogInput : public InputSource {
+      public:
+        explicit LogInput(const Rollback& rollback) : _rollback(rollback) {}
+        virtual void start() {}
+        virtual bool get(Handle<Admiral> admiral, game_ticks at, EventReceiver& receiver);
+
+      private:
+        const Rollback& _rollback;
+    };
+
+    void simulate();  // Simulates the major tick after head, applying logged input.
+
+    std::vector<Log> _logs;
+    LogInput         _input{*this};
+    PlayerShip       _player_ship;
+    Snapshot         _snapshot;  // Tail.
+    uint64_t         _tail         = 0;
+    uint64_t         _head         = 0;
+    uint32_t         _tail_sync    = 0;
+    bool             _mispredicted = false;  // Head used input that has since changed.
+    RollbackStats    _stats;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_ROLLBACK_HPP_
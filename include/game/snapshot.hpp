@@ -0,0 +1,156 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_GAME_SNAPSHOT_HPP_
+#define ANTARES_GAME_SNAPSHOT_HPP_
+
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "data/handle.hpp"
+#include "data/pool.hpp"
+
+namespace antares {
+
+class PlayerShip;
+
+// A copy of the simulation state in g, which can be restored later to re-simulate from that
+// point (see doc/net.rst).
+//
+// The copy lives in a single arena, which grows to fit the largest state it has held, so once a
+// level is underway, saving and restoring don't allocate. Everything the simulation reads is
+// copied, including the minicomputer and messages, which conditions can read; labels, the
+// starfield, and the text of the long message are only drawn, and are left as they are.
+class Snapshot {
+  public:
+    Snapshot();
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot();
+
+    // If given, the keys held on `player_ship` are copied along with g.
+    void save(PlayerShip* player_ship = nullptr);
+    void restore(PlayerShip* player_ship = nullptr);
+
+    bool   empty() const { return _size == 0; }
+    size_t size() const { return _size; }  // Bytes used by the last save().
+
+  private:
+    std::unique_ptr<uint8_t[]> _arena;
+    size_t                     _capacity = 0;
+    size_t                     _size     = 0;
+};
+
+// Copies state to or from a snapshot's arena. Each type that takes part implements a single
+// `snapshot(SnapshotArchive&)` method, called both when saving and when restoring, so that the two
+// directions can't get out of step.
+class SnapshotArchive {
+  public:
+    SnapshotArchive(bool saving, uint8_t* arena, size_t capacity)
+            : _saving(saving), _arena(arena), _capacity(capacity) {}
+
+    bool   saving() const { return _saving; }
+    size_t size() const { return _size; }  // When saving, may exceed the capacity.
+
+    // For types with no pointers to memory of their own, which are copied byte-for-byte.
+    template <typename T>
+    void value(T& x) {
+        bytes(&x, sizeof(T));
+    }
+    template <typename T>
+    void array(T* x, size_t count) {
+        bytes(x, sizeof(T) * count);
+    }
+    template <typename T>
+    void vector(std::vector<T>& v) {
+        size_t count = v.size();
+        value(count);
+        if (!_saving) {
+            v.resize(count);
+        }
+        array(v.data(), count);
+    }
+    template <typename T>
+    void pool(Pool<T>& p) {
+        int size = p.size();
+        value(size);
+        if (!_saving) {
+            p.shrink(size);
+            p.grow(size);
+        }
+        for (int i = 0; i < size; ++i) {
+            value(*p.get(i));
+        }
+    }
+
+    // For types with their own snapshot() method, or that need one defined by `fn`.
+    template <typename T, typename F>
+    void each(std::vector<T>& v, F fn) {
+        size_t count = v.size();
+        value(count);
+        if (!_saving) {
+            v.resize(count);
+        }
+        for (T& x : v) {
+            fn(*this, x);
+        }
+    }
+
+    void bits(std::vector<bool>& v);
+    void string(pn::string& s);
+    void string(sfz::optional<pn::string>& s);
+    template <typename T>
+    void name(NamedHandle<T>& h) {
+        if (_saving) {
+            save_string(h.name());
+        } else {
+            pn::string_view s = load_string();
+            if (s != h.name()) {
+                h = NamedHandle<T>(s);
+            }
+        }
+    }
+
+  private:
+    void bytes(void* data, size_t size) {
+        if (_saving) {
+            if (_size + size <= _capacity) {
+                memcpy(_arena + _size, data, size);
+            }
+        } else {
+            memcpy(data, _arena + _size, size);
+        }
+        _size += size;
+    }
+
+    void            save_string(pn::string_view s);
+    pn::string_view load_string();  // Points into the arena.
+
+    const bool     _saving;
+    uint8_t* const _arena;
+    const size_t   _capacity;
+    size_t         _size = 0;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SNAPSHOT_HPP_
@@ -28,6 +28,8 @@ namespace antares {
 
 struct BuildableObject;
 
+// The object pool starts with room for this many objects and grows as needed. Builds are still
+// refused once this many objects are active (see minicomputer.cpp).
 const int32_t kMaxSpaceObject = 250;
 
 const ticks kTimeToCheckHome = secs(15);
@@ -84,19 +86,20 @@ enum kPresenceStateType {
 
 class SpaceObject {
   public:
-    static SpaceObject* get(int number) {
-        if ((0 <= number) && (number < kMaxSpaceObject)) {
-            return &g.objects[number];
-        }
-        return nullptr;
-    }
+    class LiveList;
+    class AgeList;
 
-    static Handle<SpaceObject>     none() { return Handle<SpaceObject>(-1); }
-    static HandleList<SpaceObject> all() { return HandleList<SpaceObject>(0, kMaxSpaceObject); }
+    static SpaceObject*            get(int number) { return g.objects.get(number); }
+    static uint32_t                generation(int number);
+    static Handle<SpaceObject>     none() { return Handle<SpaceObject>(); }
+    static LiveList                all();
+    static AgeList                 by_age();
+    static Handle<SpaceObject>     newest();
+    static HandleList<SpaceObject> slots() { return HandleList<SpaceObject>(0, g.objects.size()); }
 
     SpaceObject() = default;
     SpaceObject(
-            const BaseObject& type, Random seed, int32_t object_id, const Point& initial_location,
+            const BaseObject& type, Random seed, const Point& initial_location,
             int32_t relative_direction, fixedPointType* relative_velocity,
             Handle<Admiral> new_owner, sfz::optional<pn::string_view> spriteIDOverride);
 
@@ -117,7 +120,11 @@ class SpaceObject {
 
     uint32_t          attributes = 0;
     const BaseObject* base       = nullptr;
-    int32_t           number() const;
+    int32_t           number() const { return _number; }
+    int32_t           _number = -1;  // Index into g.objects; fixed for the life of the slot.
+
+    Handle<SpaceObject> older() const;    // Next object in by_age() order, or none().
+    int32_t             _age_index = -1;  // Index into g.active_objects, or -1 if not linked.
 
     uint32_t keysDown = 0;
 
@@ -131,21 +138,15 @@ class SpaceObject {
     int32_t offlineTime = 0;
 
     Point location = {0, 0};  // [1073610752..1073872896), or [0x3ffe0000..0x40020000)
-    Point collisionGrid;      // [524224..524352), or [0x7ffc0..0x80040)
     Point distanceGrid;       // [32764..32772), or [0x7ffc..0x8004)
 
-    Handle<SpaceObject> nextNearObject;
     Handle<SpaceObject> nextFarObject;
-    Handle<SpaceObject> previousObject;
-    Handle<SpaceObject> nextObject;
 
     int32_t runTimeFlags        = 0;       // distance from origin to destination
     Point   destinationLocation = {0, 0};  // coords of our destination ( or kNoDestination)
     Handle<SpaceObject> destObject;        // target of this object.
     Handle<SpaceObject> destObjectDest;    // # of our destination's destination in case it dies
     Handle<Destination> asDestination;     // If this object kIsDestination.
-    int32_t             destObjectID     = kNoShip;  // ID of our dest object
-    int32_t             destObjectDestID = kNoShip;  // id of our dest's destination
 
     Fixed localFriendStrength  = Fixed::zero();
     Fixed localFoeStrength     = Fixed::zero();
@@ -205,7 +206,6 @@ class SpaceObject {
     bool            expires      = false;
     ticks           expire_after = ticks(-1);
     Scale           naturalScale = SCALE_SCALE;
-    int32_t         id           = kNoShip;
     ticks           rechargeTime = ticks(0);
     int16_t         active       = kObjectAvailable;
 
@@ -216,8 +216,7 @@ class SpaceObject {
     uint32_t            closestDistance    = kMaximumRelevantDistanceSquared;
     Handle<SpaceObject> closestObject;
     Handle<SpaceObject> targetObject;
-    int32_t             targetObjectID = kNoShip;
-    int32_t             targetAngle    = 0;
+    int32_t             targetAngle = 0;
     Handle<SpaceObject> lastTarget;
     int32_t             lastTargetDistance  = 0;
     int32_t             longestWeaponRange  = 0;
@@ -269,9 +268,100 @@ class SpaceObject {
     uint8_t                 originalColor = 0;
 };
 
+// Iterates over the objects that are in use (or about to be freed), skipping available slots.
+// Slots added by growing the pool during iteration are not visited.
+class SpaceObject::LiveList {
+  public:
+    class iterator {
+      public:
+        Handle<SpaceObject> operator*() const { return Handle<SpaceObject>(_number); }
+        iterator&           operator++() {
+            _number = next(_number + 1, _end);
+            return *this;
+        }
+        bool operator==(iterator other) const { return _number == other._number; }
+        bool operator!=(iterator other) const { return _number != other._number; }
+
+      private:
+        friend class LiveList;
+        iterator(int number, int end) : _number(next(number, end)), _end(end) {}
+        static int next(int number, int end) {
+            while ((number < end) && !g.objects.get(number)->active) {
+                ++number;
+            }
+            return number;
+        }
+        int _number;
+        int _end;
+    };
+    LiveList() : _end(g.objects.size()) {}
+    iterator begin() const { return iterator(0, _end); }
+    iterator end() const { return iterator(_end, _end); }
+
+  private:
+    int _end;
+};
+
+inline SpaceObject::LiveList SpaceObject::all() { return LiveList(); }
+
+// Iterates over g.active_objects from newest to oldest, which is the order the game has always
+// updated objects in. Objects created during iteration are not visited, and objects freed
+// during iteration are skipped.
+class SpaceObject::AgeList {
+  public:
+    class iterator {
+      public:
+        Handle<SpaceObject> operator*() const {
+            return Handle<SpaceObject>(g.active_objects[_index]);
+        }
+        iterator& operator++() {
+            _index = next(_index - 1);
+            return *this;
+        }
+        bool operator==(iterator other) const { return _index == other._index; }
+        bool operator!=(iterator other) const { return _index != other._index; }
+
+      private:
+        friend class AgeList;
+        explicit iterator(int index) : _index(next(index)) {}
+        static int next(int index) {
+            while ((index >= 0) && (g.active_objects[index] < 0)) {
+                --index;
+            }
+            return index;
+        }
+        int _index;
+    };
+    AgeList() : _begin(g.active_objects.size()) {}
+    iterator begin() const { return iterator(_begin - 1); }
+    iterator end() const { return iterator(-1); }
+
+  private:
+    int _begin;
+};
+
+inline SpaceObject::AgeList SpaceObject::by_age() { return AgeList(); }
+
+inline uint32_t SpaceObject::generation(int number) {
+    if ((0 <= number) && (number < g.objects.size())) {
+        return g.generations[number];
+    }
+    return 0;
+}
+
+inline Handle<SpaceObject>::Handle(int number)
+        : _number(number), _generation(SpaceObject::generation(number)) {}
+inline bool Handle<SpaceObject>::expired() const {
+    return !get() || (_generation != SpaceObject::generation(_number));
+}
+inline SpaceObject* Handle<SpaceObject>::get() const { return SpaceObject::get(_number); }
+inline SpaceObject& Handle<SpaceObject>::operator*() const { return *get(); }
+inline SpaceObject* Handle<SpaceObject>::operator->() const { return get(); }
+
 void SpaceObjectHandlingInit(void);
 void ResetAllSpaceObjects(void);
 void RemoveAllSpaceObjects(void);
+void CompactActiveObjects(void);
 
 Handle<SpaceObject> CreateAnySpaceObject(
         const BaseObject& whichBase, fixedPointType* velocity, Point* location, int32_t direction,
@@ -27,6 +27,7 @@
 
 namespace antares {
 
+struct RenderFrame;
 class SpaceObject;
 
 const int32_t kMaxSparkAge          = 1023;
@@ -47,6 +48,7 @@ struct scrollStarType {
     int32_t        age;
     int32_t        speed;
     Hue            hue;
+    int32_t        generation = 0;  // Bumped each time the star or spark is placed anew.
 };
 
 class Starfield {
@@ -65,9 +67,11 @@ class Starfield {
             int32_t sparkNum, int32_t sparkSpeed, Fixed maxVelocity, Hue hue, Point* location);
     void prepare_to_move();
     void move(ticks by_units);
-    void draw() const;
+    void capture(RenderFrame* frame) const;
     void show();
 
+    static void draw(const RenderFrame& frame);
+
   private:
     scrollStarType _stars[kScrollStarNum + kSparkStarNum];
     int32_t        _last_clip_bottom;
@@ -0,0 +1,48 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_TEST_LEVEL_HPP_
+#define ANTARES_GAME_TEST_LEVEL_HPP_
+
+#include <stdint.h>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "sound/driver.hpp"
+#include "video/text-driver.hpp"
+
+namespace antares {
+
+// Sets up enough of the game to load levels from the factory scenario and simulate them, with
+// no window and no sound. Shared by the tests that run the simulation.
+class TestLevel {
+  public:
+    TestLevel();
+
+    // Loads `chapter`, with the random seed at 0, as construct_level() leaves it.
+    void load(int32_t chapter);
+
+  private:
+    NullPrefsDriver _prefs;
+    NullSoundDriver _sound;
+    NullLedger      _ledger;
+    TextVideoDriver _video;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_TEST_LEVEL_HPP_
@@ -27,6 +27,7 @@
 
 namespace antares {
 
+struct RenderFrame;
 class SpaceObject;
 
 static const int kBoltPointNum = 10;
@@ -34,7 +35,7 @@ static const int kBoltPointNum = 10;
 struct Vector {
     static Vector*            get(int number);
     static Handle<Vector>     none() { return Handle<Vector>(-1); }
-    static HandleList<Vector> all() { return HandleList<Vector>(0, size); }
+    static HandleList<Vector> all();
 
     Vector();
 
@@ -49,9 +50,7 @@ struct Vector {
     sfz::optional<Hue>  hue;
     bool                killMe;
     bool                active;
-    int32_t             fromObjectID;
     Handle<SpaceObject> fromObject;
-    int32_t             toObjectID;
     Handle<SpaceObject> toObject;
     Point               toRelativeCoord;
     int32_t             boltState;
@@ -61,7 +60,7 @@ struct Vector {
 
   private:
     friend class Vectors;
-    const static size_t size = 256;
+    const static int size = 256;  // Initial capacity; grows as needed.
 };
 
 class Vectors {
@@ -72,7 +71,8 @@ class Vectors {
     static Handle<Vector> add(Point* location, const BaseObject::Bolt& b);
     static void set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObject> sourceObject);
     static void update();
-    static void draw();
+    static void capture(RenderFrame* frame);
+    static void draw(const RenderFrame& frame);
     static void cull();
 };
 
@@ -19,6 +19,8 @@
 #ifndef ANTARES_GLFW_VIDEO_DRIVER_HPP_
 #define ANTARES_GLFW_VIDEO_DRIVER_HPP_
 
+#include <exception>
+#include <mutex>
 #include <queue>
 #include <stack>
 
@@ -48,6 +50,7 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     virtual void stop_editing(TextReceiver* text);
 
     virtual wall_time now() const;
+    virtual bool      real_time() const { return true; }
 
     void loop(Card* initial);
 
@@ -58,6 +61,7 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     void        mouse_button(int button, int action, int mods);
     void        mouse_move(double x, double y);
     void        window_size(int width, int height);
+    void        simulate();
     static void key_callback(GLFWwindow* w, int key, int scancode, int action, int mods);
     static void char_callback(GLFWwindow* w, unsigned int code_point);
     static void mouse_button_callback(GLFWwindow* w, int button, int action, int mods);
@@ -71,6 +75,14 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     wall_time     _last_click_usecs;
     int           _last_click_count;
     TextReceiver* _text;
+
+    // Held by the main thread while it sends an event, fires a timer, or records a frame, and by
+    // the simulation thread while it ticks the top card, so that only one of them touches the
+    // cards at once. GLFW's callbacks, which send events, take it themselves.
+    std::mutex         _cards;
+    Card*              _ticking   = nullptr;  // The card the simulation thread is ticking.
+    bool               _stopped   = false;
+    std::exception_ptr _sim_error = nullptr;
 };
 
 }  // namespace antares
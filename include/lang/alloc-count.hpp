@@ -0,0 +1,37 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_ALLOC_COUNT_HPP_
+#define ANTARES_LANG_ALLOC_COUNT_HPP_
+
+#include <stdint.h>
+
+namespace antares {
+
+// The number of heap allocations so far, on any thread.
+//
+// With glibc, these are calls to malloc(), calloc() and realloc(). src/lang/alloc-count.cpp
+// replaces them with versions that count and then call glibc's own. The global operator new
+// allocates with malloc(), so it is counted there, once, as are strings. With other C libraries,
+// only calls to the global operator new are counted.
+//
+// Only available in binaries that include src/lang/alloc-count.cpp.
+int64_t allocation_count();
+
+}  // namespace antares
+
+#endif  // ANTARES_LANG_ALLOC_COUNT_HPP_
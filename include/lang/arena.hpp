@@ -0,0 +1,68 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_ARENA_HPP_
+#define ANTARES_LANG_ARENA_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <pn/string>
+#include <vector>
+
+namespace antares {
+
+// Hands out memory for data that's only needed until the next reset(), which frees it all at
+// once. Memory comes from blocks that are kept across resets, so once the arena has grown to fit
+// the most that's needed between resets, allocating from it doesn't touch the heap.
+//
+// Nothing allocated from the arena is destroyed, so it only suits types that don't need to be.
+class Arena {
+  public:
+    explicit Arena(size_t block_size = 64 * 1024);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    // Strings in the arena, for building text that's copied or dropped before the next reset().
+    pn::string_view copy(pn::string_view s);
+    pn::string_view join(std::initializer_list<pn::string_view> parts);
+    pn::string_view dump(int64_t value);
+
+    void reset();
+
+    size_t used() const;      // Bytes allocated since the last reset().
+    size_t capacity() const;  // Bytes in all blocks.
+
+  private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t                     size;
+    };
+
+    const size_t       _block_size;
+    std::vector<Block> _blocks;
+    size_t             _block = 0;  // The block being allocated from,
+    size_t             _used  = 0;  // and how much of it is taken.
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_LANG_ARENA_HPP_
@@ -0,0 +1,77 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_THREAD_POOL_HPP_
+#define ANTARES_LANG_THREAD_POOL_HPP_
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace antares {
+
+// Runs loops across several threads.
+//
+// Each thread starts on its own share of the loop, and when it runs out, steals work from the
+// other end of another thread's share. The calling thread takes part, so a pool of one thread
+// starts no threads at all.
+class ThreadPool {
+  public:
+    explicit ThreadPool(int threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    int threads() const { return _queues.size(); }
+
+    // Calls `fn(i)` for each `i` in [0, count), and returns once all calls have returned. Calls
+    // may happen in any order, on any thread, so `fn` must be safe to run concurrently.
+    void parallel_for(int32_t count, const std::function<void(int32_t)>& fn);
+
+  private:
+    typedef std::pair<int32_t, int32_t> Range;
+
+    struct Queue {
+        std::mutex        mutex;
+        std::deque<Range> ranges;
+    };
+
+    void work(int thread);
+    bool take(int thread, Range* range);
+    void run(int thread);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread>            _threads;
+
+    std::mutex                          _mutex;
+    std::condition_variable             _start;
+    std::condition_variable             _done;
+    const std::function<void(int32_t)>* _fn      = nullptr;
+    uint64_t                            _job     = 0;
+    int                                 _busy    = 0;
+    bool                                _stopped = false;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_LANG_THREAD_POOL_HPP_
@@ -0,0 +1,68 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_LANG_TRACE_HPP_
+#define ANTARES_LANG_TRACE_HPP_
+
+#include <stdint.h>
+#include <pn/string>
+
+namespace antares {
+
+// Records spans of time on each thread, for writing out as Chrome trace events, which
+// chrome://tracing and Perfetto can show on a timeline.
+//
+// Each thread records into its own ring buffer, which keeps only its most recent spans, so tracing
+// can stay on for a whole session and be written out when something goes wrong. Nothing is
+// recorded until start_tracing(). Building without ANTARES_TRACING removes the trace points.
+void start_tracing();
+void stop_tracing();
+bool tracing();
+
+// The spans still in the buffers, as a JSON object with a "traceEvents" array.
+pn::string trace_json();
+void       write_trace(pn::string_view path);
+
+// Records the time from its construction to its destruction. `category` and `name` must be
+// string literals; `detail`, if given, must outlive the span, and is copied when it ends.
+class TraceSpan {
+  public:
+    TraceSpan(const char* category, const char* name, pn::string_view detail = pn::string_view{});
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan();
+
+  private:
+    const char* const     _category;
+    const char* const     _name;
+    const pn::string_view _detail;
+    const int64_t         _start;  // Nanoseconds, or -1 if not tracing.
+};
+
+#define ANTARES_TRACE_CONCAT_(a, b) a##b
+#define ANTARES_TRACE_CONCAT(a, b) ANTARES_TRACE_CONCAT_(a, b)
+
+#ifdef ANTARES_TRACING
+#define ANTARES_TRACE(category, ...) \
+    ::antares::TraceSpan ANTARES_TRACE_CONCAT(trace_span_, __LINE__)(category, __VA_ARGS__)
+#else
+#define ANTARES_TRACE(category, ...) static_cast<void>(0)
+#endif
+
+}  // namespace antares
+
+#endif  // ANTARES_LANG_TRACE_HPP_
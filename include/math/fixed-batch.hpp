@@ -0,0 +1,57 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_MATH_FIXED_BATCH_HPP_
+#define ANTARES_MATH_FIXED_BATCH_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "math/fixed.hpp"
+
+namespace antares {
+
+// Element-wise Fixed arithmetic over arrays, for passes that do the same thing to every object.
+//
+// Each operation gives exactly the result of the scalar operators in fixed.hpp, element by
+// element. Builds targeting AVX2 or SSE2 use those instructions; others use the scalar
+// operators directly. `out` may be one of the inputs, but must not partially overlap them.
+class FixedBatch {
+  public:
+    // The instruction set in use: "avx2", "sse2", or "scalar".
+    static const char* isa();
+
+    // out[i] = a[i] + b[i]
+    static void add(const Fixed* a, const Fixed* b, Fixed* out, size_t size);
+
+    // out[i] = a[i] * b[i]
+    static void mul(const Fixed* a, const Fixed* b, Fixed* out, size_t size);
+
+    // out[i] = a[i] * b
+    static void mul(const Fixed* a, Fixed b, Fixed* out, size_t size);
+
+    // Caps a[i] at limit[i], the way thrust is capped: out[i] is at most limit[i] if limit[i]
+    // is zero or positive, and at least limit[i] if it is negative.
+    static void cap(const Fixed* a, const Fixed* limit, Fixed* out, size_t size);
+
+    // out[i] = evil_fixed_to_long(a[i])
+    static void to_long(const Fixed* a, int32_t* out, size_t size);
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_MATH_FIXED_BATCH_HPP_
@@ -22,6 +22,8 @@
 #include <math.h>
 #include <pn/string>
 
+#include "lang/arena.hpp"
+
 namespace antares {
 
 class Fixed {
@@ -105,7 +107,8 @@ inline int32_t more_evil_fixed_to_long(Fixed value) { return (value >> 8).val();
 inline float   mFixedToFloat(Fixed m_f) { return floorf(m_f.val() * 1e3 / 256.0) / 1e3; }
 inline int32_t mFixedToLong(Fixed m_f) { return evil_fixed_to_long(m_f); }
 
-pn::string stringify(Fixed fixed);
+pn::string      stringify(Fixed fixed);
+pn::string_view stringify(Fixed fixed, Arena* arena);  // Lasts until the arena is reset.
 
 struct fixedPointType {
     Fixed h;
@@ -20,6 +20,7 @@
 #define ANTARES_MATH_RANDOM_HPP_
 
 #include <stdint.h>
+#include <array>
 
 #include "math/fixed.hpp"
 #include "math/units.hpp"
@@ -34,6 +35,57 @@ struct Random {
     Fixed   next(Fixed range) { return Fixed::from_val(next(range.val())); }
 };
 
+// How a plugin's levels draw random numbers. LEGACY draws from g.random, in the order that the
+// game asks for them, and is what all existing replays depend on. COUNTER draws from streams keyed
+// by who is drawing and when, so draws don't depend on each other.
+enum class RandomMode { LEGACY, COUNTER };
+
+// What a keyed stream is used for, so that one object's draws for different purposes on the same
+// tick are independent.
+enum class RandomPurpose : uint32_t {
+    LEVEL      = 0,  // Starting view angle.
+    OBJECT     = 1,  // Seed of a new object's own Random.
+    BLITZKRIEG = 2,  // How long an admiral attacks or holds back.
+    BUILD      = 3,  // What an admiral builds next.
+};
+
+// Philox4x32-10, from Salmon et al., “Parallel Random Numbers: As Easy as 1, 2, 3” (SC11).
+std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+
+// A counter-based random stream: the nth draw depends only on the stream's key and n, so streams
+// can be created and drawn from in any order, on any thread. Draws are scaled from 15 bits, like
+// Random's, so the same ranges work with either.
+class RandomStream {
+  public:
+    RandomStream() = default;
+    RandomStream(int32_t seed, RandomPurpose purpose, int64_t tick, int32_t id, int32_t serial);
+
+    int16_t next(int16_t range);
+    ticks   next(ticks range) { return ticks(next(range.count())); }
+    Fixed   next(Fixed range) { return Fixed::from_val(next(range.val())); }
+
+  private:
+    std::array<uint32_t, 2> _key     = {{0, 0}};
+    std::array<uint32_t, 4> _counter = {{0, 0, 0, 0}};
+    std::array<uint32_t, 4> _block;
+    int                     _used = 4;  // Words of _block already drawn.
+};
+
+// Either g.random or a RandomStream, depending on the plugin's RandomMode.
+class RandomSource {
+  public:
+    RandomSource(Random* shared) : _shared(shared) {}
+    RandomSource(const RandomStream& stream) : _stream(stream) {}
+
+    int16_t next(int16_t range) { return _shared ? _shared->next(range) : _stream.next(range); }
+    ticks   next(ticks range) { return _shared ? _shared->next(range) : _stream.next(range); }
+    Fixed   next(Fixed range) { return _shared ? _shared->next(range) : _stream.next(range); }
+
+  private:
+    Random*      _shared = nullptr;
+    RandomStream _stream;
+};
+
 int          Randomize(int range);
 inline Fixed Randomize(Fixed range) { return Fixed::from_val(Randomize(range.val())); }
 
@@ -103,6 +103,17 @@ class Card : public EventReceiver {
     // at that time, subject to the caveat given in the documentation for `next_timer()`.
     virtual void fire_timer();
 
+    // Called instead of `fire_timer()` by video drivers which run the simulation on a thread of
+    // its own, so that drawing and waiting for the display don't hold it up.
+    //
+    // The card stack is locked for the call, so nothing else happens meanwhile, but the video
+    // driver can't be used from that thread, so this must not draw, create textures, or push or
+    // pop cards. A Card which can't advance without doing those returns false, and then
+    // `fire_timer()` is called on the main thread as usual, until `tick()` next returns true.
+    //
+    // @returns             True if the timer was handled; false to have `fire_timer()` called.
+    virtual bool tick();
+
     // Returns the stack this Card is in.
     //
     // If this Card has not yet been added to a stack, then returns NULL.  This method is probably
@@ -0,0 +1,71 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_ATLAS_HPP_
+#define ANTARES_VIDEO_ATLAS_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/geometry.hpp"
+
+namespace antares {
+
+// Places rects on a page of fixed size, without overlap, for packing many small images into one
+// texture.
+//
+// Keeps the "skyline" made by the tops of the rects placed so far, and puts each new rect where
+// it would sit lowest on it, leftmost on a tie. Space under an overhang is never reused.
+//
+// A removed rect is kept on a free list, and a later rect that fits inside one goes there
+// before it goes on the skyline, splitting off what it leaves over. Free rects aren't merged
+// with their neighbors, so a page that sees much churn fragments until it's cleared.
+class SkylinePacker {
+  public:
+    explicit SkylinePacker(Size size);
+
+    // Finds room for a rect of `size`, and stores where it goes in `at`. Returns false, leaving
+    // `at` unchanged, if the page is too full.
+    bool add(Size size, Point* at);
+
+    // Makes `rect`, which add() placed, free for later rects.
+    void remove(const Rect& rect);
+
+    // Makes the whole page free again.
+    void clear();
+
+  private:
+    // A stretch of the skyline: [x, x + width) is free from y down.
+    struct Segment {
+        int32_t x, y, width;
+    };
+
+    // The height at which a rect of `width` could sit starting at `_skyline[index]`, or -1 if it
+    // would stick out of the page.
+    int32_t fit(size_t index, int32_t width) const;
+
+    // Places a rect of `size` in the smallest free rect that holds it, if any.
+    bool reuse(Size size, Point* at);
+
+    const Size           _size;
+    std::vector<Segment> _skyline;
+    std::vector<Rect>    _free;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_ATLAS_HPP_
@@ -65,6 +65,30 @@ class VideoDriver {
 
     virtual wall_time now() const = 0;
 
+    // True if now() follows the real clock, and frames are drawn as the display refreshes, rather
+    // than on a simulated clock that stops while cards work. Moving things are then drawn
+    // between where the last two ticks left them, and timers should not run long.
+    virtual bool real_time() const { return false; }
+
+    // What drawing the last frame cost, for drivers that count it, and how much texture storage
+    // is held.
+    struct DrawStats {
+        int32_t draw_calls       = 0;
+        int32_t vertices         = 0;
+        int32_t instances        = 0;
+        int32_t texture_switches = 0;
+        int32_t program_switches = 0;
+        int64_t texture_bytes    = 0;
+
+        // GPU time spent in each of the driver's shader programs, if it timed them.
+        struct ProgramTime {
+            const char* name  = nullptr;
+            int64_t     nsecs = 0;
+        };
+        ProgramTime program_times[8];
+    };
+    virtual DrawStats draw_stats() const { return DrawStats(); }
+
     virtual Texture texture(pn::string_view name, const PixMap& content, int scale)      = 0;
     virtual void    dither_rect(const Rect& rect, const RgbColor& color)                 = 0;
     virtual void    draw_point(const Point& at, const RgbColor& color)                   = 0;
@@ -73,6 +97,17 @@ class VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color)                = 0;
     virtual void    draw_plus(const Rect& rect, const RgbColor& color)                   = 0;
 
+    // Like texture(), for the many small images that sprites are made of. A driver may pack them
+    // together, so that many sprites can be drawn without switching textures.
+    virtual Texture sprite_texture(pn::string_view name, const PixMap& content);
+
+    // A sprite image with an overlay to be tinted: the overlay's red channel is a shade of the
+    // hue, and its alpha is how much of that covers `content`. Returns a texture drawn without
+    // the overlay, whose tinted() copies draw with it, or a null texture if the driver can't
+    // tint; the caller must then composite and upload each hue itself.
+    virtual Texture sprite_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay);
+
   private:
     friend class Points;
     friend class Lines;
@@ -113,6 +148,8 @@ class Texture {
                 const RgbColor& fill_color) const = 0;
         virtual const Size& size() const          = 0;
 
+        virtual std::unique_ptr<Impl> tinted(Hue hue) const { return nullptr; }
+
         virtual void begin_quads() const {}
         virtual void end_quads() const {}
         virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
@@ -161,6 +198,10 @@ class Texture {
 
     const Size& size() const { return _impl->size(); }
 
+    // The same image, drawn with its overlay tinted with `hue`, sharing storage with this one. A
+    // null texture unless this came from the overlay form of sprite_texture().
+    Texture tinted(Hue hue) const { return _impl ? _impl->tinted(hue) : nullptr; }
+
   private:
     friend class Quads;
 
@@ -21,11 +21,14 @@
 
 #include <stdint.h>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
 #include "math/random.hpp"
 #include "ui/card.hpp"
+#include "video/atlas.hpp"
 #include "video/driver.hpp"
 
 namespace antares {
@@ -34,6 +37,7 @@ class Event;
 
 typedef int sampler2D;
 typedef int sampler2DRect;
+typedef int sampler2DArray;
 struct vec2 {
     float x, y;
 };
@@ -41,13 +45,28 @@ struct vec4 {
     float x, y, z, w;
 };
 
+// The driver's shader programs: one for each color mode, and one for instances that mix the
+// sprite modes.
+const int kShaderPrograms = 7;
+
+// A uniform of every program. Setting it only records its value; each program is given the latest
+// value just before it next draws.
 template <typename T>
 struct Uniform {
     const char* name;
-    int         location;
+    int         locations[kShaderPrograms];
+    T           value;
+    uint32_t    stale;  // A bit for each program that hasn't been given `value`.
+
+    void load(int index, int program);
+    void set(T v) {
+        value = v;
+        stale = ~0u;
+    }
+    void apply(int index);
 
-    void load(int program);
-    void set(T value) const;
+  private:
+    void upload(int location) const;
 };
 
 class OpenGlVideoDriver : public VideoDriver {
@@ -57,6 +76,9 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual int scale() const;
 
     virtual Texture texture(pn::string_view name, const PixMap& content, int scale);
+    virtual Texture sprite_texture(pn::string_view name, const PixMap& content);
+    virtual Texture sprite_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay);
     virtual void    dither_rect(const Rect& rect, const RgbColor& color);
     virtual void    draw_point(const Point& at, const RgbColor& color);
     virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
@@ -64,16 +86,169 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
     virtual void    draw_plus(const Rect& rect, const RgbColor& color);
 
+    virtual DrawStats draw_stats() const;
+
     struct Uniforms {
-        Uniform<vec2>          screen          = {"screen"};
-        Uniform<int>           scale           = {"scale"};
-        Uniform<int>           color_mode      = {"color_mode"};
-        Uniform<sampler2DRect> sprite          = {"sprite"};
-        Uniform<sampler2D>     static_image    = {"static_image"};
-        Uniform<float>         static_fraction = {"static_fraction"};
-        Uniform<vec2>          unit            = {"unit"};
-        Uniform<vec4>          outline_color   = {"outline_color"};
-        Uniform<int>           seed            = {"seed"};
+        Uniform<vec2>           screen        = {"screen"};
+        Uniform<int>            scale         = {"scale"};
+        Uniform<sampler2DRect>  sprite        = {"sprite"};
+        Uniform<sampler2DArray> atlas         = {"atlas"};
+        Uniform<int>            use_atlas     = {"use_atlas"};
+        Uniform<sampler2D>      static_image  = {"static_image"};
+        Uniform<sampler2D>      tints         = {"tints"};
+        Uniform<vec2>           unit          = {"unit"};
+        Uniform<vec4>           bounds        = {"bounds"};
+        Uniform<vec4>           outline_color = {"outline_color"};
+        Uniform<int>            seed          = {"seed"};
+
+        void load(int index, uint32_t program);
+        void apply(int index);
+    };
+
+    // Collects vertices until the primitive, color mode, or texture changes, then draws them all
+    // with a single call. Vertices are streamed through a ring buffer, which is only orphaned
+    // when it wraps, so the driver never waits on the GPU to finish with earlier draws.
+    //
+    // Textured quads are instead collected as instances, which carry their own color mode and
+    // static fraction, and are streamed through a second ring; the vertex shader makes each
+    // one's corners. Sprites from the atlas thus share a call however they're drawn, and a
+    // layer of them takes just one.
+    //
+    // Each call uses the program for its color mode, or for instances in several modes, the
+    // one that reads each instance's. Calls are made in the order they were batched, since
+    // anything drawn later may cover what was drawn earlier, so programs are switched only
+    // when the mode changes.
+    class Batch {
+      public:
+        // Where a quad's texels come from, besides its texture coordinates.
+        struct Sheet {
+            int16_t page;     // Of the atlas; ignored for other textures.
+            int16_t hue;      // Tints the overlay. Gray leaves it out.
+            int16_t overlay;  // How far right of the image its overlay is, in texels.
+        };
+
+        struct Vertex {
+            float   x, y;
+            uint8_t r, g, b, a;
+            int16_t u, v;
+            Sheet   sheet;
+        };
+
+        struct Instance {
+            float   left, top, right, bottom;
+            int16_t u_left, v_top, u_right, v_bottom;
+            uint8_t r, g, b, a;
+            uint8_t color_mode;
+            uint8_t fraction;  // Of the image shown as static, out of 255.
+            Sheet   sheet;
+        };
+
+        Batch(Uniforms& uniforms);
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        // Takes the programs, indexed by color mode.
+        void setup(const uint32_t* programs);
+
+        // Draws pending vertices first if they can't share a call with the ones to come. Sprites
+        // packed into the atlas pass `atlas`; otherwise, a texture of 0 keeps whichever texture
+        // is bound.
+        void use(uint32_t primitive, int color_mode, uint32_t texture, bool atlas = false);
+
+        // Returns space for `count` vertices of the current primitive.
+        Vertex* add(size_t count);
+        void    add_quad(
+                   const Rect& dest, const Rect& source, const RgbColor& tint,
+                   const Sheet& sheet = Sheet());
+
+        // Like use(), for instances, which only need to share a texture.
+        void use_instances(uint32_t texture, bool atlas = false);
+        void add_instance(
+                const Rect& dest, const Rect& source, const RgbColor& tint, int color_mode,
+                uint8_t fraction, const Sheet& sheet);
+
+        // Draws pending vertices or instances. Must be called before changing any other GL
+        // state.
+        void flush();
+
+        // Call after binding a texture other than through use().
+        void forget_texture() { _texture = 0; }
+
+        // While timing, each call is timed on the GPU, and counted towards its program. Call
+        // collect_times() once the GPU has finished the frame, so that the times are ready.
+        void set_timing(bool timing) { _timing = timing; }
+        void collect_times();
+
+        DrawStats take_stats();
+
+      private:
+        bool same_texture(uint32_t texture, bool atlas) const;
+        void bind(uint32_t texture, bool atlas);
+        void set_instanced(bool instanced);
+        void point_instances(size_t first);
+        void flush_instances();
+        void start_draw(int program);
+        void finish_draw();
+
+        Uniforms&             _uniforms;
+        std::vector<Vertex>   _vertices;
+        std::vector<Instance> _instances;
+        uint32_t              _instance_modes  = 0;  // A bit for each mode they use.
+        uint32_t              _vertex_array    = 0;
+        uint32_t              _instance_array  = 0;
+        uint32_t              _buffer          = 0;
+        uint32_t              _instance_buffer = 0;
+        size_t                _offset          = 0;  // In vertices.
+        size_t                _instance_offset = 0;  // In instances.
+        bool                  _instanced       = false;
+        uint32_t              _primitive       = 0;
+        int                   _color_mode      = -1;
+        uint32_t              _texture         = 0;
+        bool                  _atlas           = false;
+        uint32_t              _programs[kShaderPrograms];
+        int                   _program = -1;
+        bool                  _timing  = false;
+        DrawStats             _stats;
+
+        std::vector<std::pair<uint32_t, int>> _queries;  // Query and program, of each timed call.
+        std::vector<uint32_t>                 _free_queries;
+    };
+
+    // Packs sprite images into the pages of a single GL_TEXTURE_2D_ARRAY, so that sprites on
+    // any page can share a draw call. Each image gets a clear 1-pixel border, as other textures
+    // do, and so does its overlay, if it has one, which goes just to the right of it. A removed
+    // image's space is reused by later images that fit in it, and a page is cleared once none of
+    // its images are in use; when no page has room, the array grows. It never shrinks: the most
+    // pages a session needed at once stay allocated until the driver goes away.
+    class Atlas {
+      public:
+        struct Entry {
+            int16_t page;
+            Rect    rect;  // Including the border.
+        };
+
+        Atlas(Batch& batch);
+        Atlas(const Atlas&) = delete;
+        Atlas& operator=(const Atlas&) = delete;
+        ~Atlas();
+
+        // Uploads `image` and `overlay`, if given, and returns false if they don't fit on a page.
+        bool    add(const PixMap& image, const PixMap* overlay, Entry* entry);
+        void    remove(const Entry& entry);
+        int64_t bytes() const;
+
+      private:
+        struct Page {
+            SkylinePacker packer;
+            int32_t       images;
+        };
+
+        void grow();
+
+        Batch&            _batch;
+        uint32_t          _texture = 0;
+        int32_t           _layers  = 0;
+        std::vector<Page> _pages;
     };
 
   protected:
@@ -83,10 +258,15 @@ class OpenGlVideoDriver : public VideoDriver {
         MainLoop(const MainLoop&) = delete;
         MainLoop& operator=(const MainLoop&) = delete;
 
-        void  draw();
+        void  draw();  // record(), then submit().
         bool  done() const;
         Card* top() const;
 
+        // Records the top card's drawing into the batch. This reads the cards, so nothing may
+        // tick them meanwhile; submit() doesn't, so it can run while they tick.
+        void record();
+        void submit();
+
       private:
         struct Setup {
             Setup(OpenGlVideoDriver& driver);
@@ -99,27 +279,21 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual Size viewport_size() const = 0;
 
   private:
-    virtual void begin_points();
-    virtual void end_points();
     virtual void batch_point(const Point& at, const RgbColor& color);
-
-    virtual void begin_lines();
-    virtual void end_lines();
     virtual void batch_line(const Point& from, const Point& to, const RgbColor& color);
-
-    virtual void begin_rects();
-    virtual void end_rects();
     virtual void batch_rect(const Rect& rect, const RgbColor& color);
 
     Random _static_seed;
 
-    Uniforms _uniforms;
+    Uniforms  _uniforms;
+    Batch     _batch{_uniforms};
+    Atlas     _atlas{_batch};
+    DrawStats _draw_stats;
+    int64_t   _texture_bytes = 0;  // Of textures outside the atlas.
 
     std::map<size_t, Texture> _triangles;
     std::map<size_t, Texture> _diamonds;
     std::map<size_t, Texture> _pluses;
-
-    uint32_t _vbuf[3];
 };
 
 }  // namespace antares
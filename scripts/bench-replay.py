@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+# -*- encoding: utf-8 -*-
+# Copyright (C) 2017 The Antares Authors
+# This file is part of Antares, a tactical space combat game.
+# Antares is free software, distributed under the LGPL+. See COPYING.
+
+from __future__ import print_function
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+
+# For each measurement, whether bigger is better.
+METRICS = [
+    ("ticks_per_s", True),
+    ("major_tick_p50_us", False),
+    ("major_tick_p99_us", False),
+    ("allocations", False),
+    ("peak_rss_kb", False),
+]
+
+
+def bench(opts, path):
+    cmd = ["out/cur/bench-replay", path, "--runs=%d" % opts.runs, "--warmup=%d" % opts.warmup]
+    return json.loads(subprocess.check_output(cmd).decode("utf-8"))
+
+
+# Returns how much worse `new` is than `old`, in percent.
+def regression(old, new, higher_is_better):
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    change = 100.0 * (new - old) / old
+    return -change if higher_is_better else change
+
+
+def compare(opts, baseline, results):
+    regressed = False
+    for name in sorted(results):
+        if name not in baseline:
+            print("%s: not in baseline" % name)
+            continue
+        old, new = baseline[name], results[name]
+        if old["sync"] != new["sync"]:
+            # The replay no longer plays out the same, so its timings can't be compared either.
+            print("%s: sync changed from %d to %d" % (name, old["sync"], new["sync"]))
+            regressed = True
+            continue
+        for metric, higher_is_better in METRICS:
+            worse = regression(old[metric], new[metric], higher_is_better)
+            if worse > opts.threshold:
+                print("%s: %s regressed %.1f%% (%s -> %s)" %
+                      (name, metric, worse, old[metric], new[metric]))
+                regressed = True
+    return not regressed
+
+
+def main():
+    os.chdir(os.path.dirname(os.path.dirname(os.path.realpath(__file__))))
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-n", "--runs", type=int, default=5)
+    parser.add_argument("-w", "--warmup", type=int, default=1)
+    parser.add_argument("--save", metavar="FILE", help="write results as a baseline")
+    parser.add_argument("--compare", metavar="FILE", help="compare results to a baseline")
+    parser.add_argument(
+        "--threshold", type=float, default=5.0, help="regression to flag, in percent")
+    parser.add_argument("replay", nargs="*")
+    opts = parser.parse_args()
+
+    replays = opts.replay or sorted(glob.glob("test/*.NLRP"))
+    results = {}
+    for path in replays:
+        name = os.path.splitext(os.path.basename(path))[0]
+        sys.stderr.write("%s\n" % name)
+        results[name] = bench(opts, path)
+        print("%s: %.0f ticks/s, p50 %.1fus, p99 %.1fus, %d allocations, %d KB" % (
+            name, results[name]["ticks_per_s"], results[name]["major_tick_p50_us"],
+            results[name]["major_tick_p99_us"], results[name]["allocations"],
+            results[name]["peak_rss_kb"]))
+
+    if opts.save:
+        with open(opts.save, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+            f.write("\n")
+    if opts.compare:
+        with open(opts.compare) as f:
+            baseline = json.load(f)
+        if not compare(opts, baseline, results):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,12 +23,21 @@ FAILED = "FAILED"
 EXCEPT = "EXCEPT"
 
 WINE_TESTS = [
+    "arena-test",
+    "atlas-test",
     "color-test",
     "editable-text-test",
+    "fixed-batch-test",
     "fixed-test",
     "object-data",
+    "profile-test",
+    "random-test",
+    "render-frame-test",
+    "rollback-test",
     "shapes",
+    "snapshot-test",
     "tint",
+    "trace-test",
 ]
 
 
@@ -73,6 +82,11 @@ def offscreen_test(opts, queue, name, args=[]):
     return diff_test(opts, queue, name, cmd + args, expected)
 
 
+def sprite_test(opts, queue, name, args=[]):
+    cmd = ["out/cur/bench-sprites"] + args
+    return diff_test(opts, queue, name, cmd, "test/%s" % name)
+
+
 def replay_test(opts, queue, name, args=[]):
     cmd = ["out/cur/replay", "test/%s.NLRP" % name, "--text"]
     if opts.smoke:
@@ -83,6 +97,59 @@ def replay_test(opts, queue, name, args=[]):
     return diff_test(opts, queue, name, cmd + args, expected)
 
 
+def replay_outcome(opts, name, args):
+    """Returns the sync lines and debriefing that a run of the replay ends with, or None."""
+    with NamedTemporaryDir() as d:
+        cmd = ["out/cur/replay", "test/%s.NLRP" % name, "--output=%s" % d] + args
+        if opts.wine:
+            cmd[0] += ".exe"
+            cmd.insert(0, "wine")
+        sub = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        output, _ = sub.communicate()
+        if sub.returncode != 0:
+            print("%s failed:\n%s" % (" ".join(cmd), output))
+            return None
+        sync = [line for line in output.splitlines() if line.startswith("sync: ")]
+        debriefing = ""
+        path = os.path.join(d, "debriefing.txt")
+        if os.path.exists(path):
+            with open(path) as f:
+                debriefing = f.read()
+        return sync, debriefing
+
+
+def same_outcome(opts, replay, a, b):
+    """Plays the replay with args `a` and with args `b`, and checks that both end the same way."""
+    outcome_a = replay_outcome(opts, replay, a)
+    outcome_b = replay_outcome(opts, replay, b)
+    if (outcome_a is None) or (outcome_b is None):
+        return False
+    if outcome_a != outcome_b:
+        print("%s differs from %s:\n  %r\n  %r" %
+              (" ".join(b), " ".join(a), outcome_a, outcome_b))
+        return False
+    return True
+
+
+def simulate_test(opts, queue, name, replay):
+    return same_outcome(opts, replay, ["--smoke"], ["--simulate-only"])
+
+
+def broadphase_test(opts, queue, name, replay):
+    return same_outcome(opts, replay, ["--simulate-only", "--broadphase=grid"],
+                        ["--simulate-only", "--broadphase=sweep"])
+
+
+def threads_test(opts, queue, name, replay):
+    return same_outcome(opts, replay, ["--simulate-only", "--threads=1"],
+                        ["--simulate-only", "--threads=4"])
+
+
+def alloc_test(opts, queue, name, replay):
+    cmd = ["out/cur/bench-replay", "test/%s.NLRP" % replay, "--runs=1", "--warmup=0"]
+    return run(opts, queue, name, cmd + ["--check-allocations"])
+
+
 def call(args):
     fn = args[0]
     opts = args[1]
@@ -124,7 +191,7 @@ def main():
         print("test data submodule is missing; fetching it")
         subprocess.check_call("git submodule update --init test".split())
 
-    test_types = "unit data offscreen replay".split()
+    test_types = "unit data offscreen sprites replay simulate broadphase threads alloc".split()
     parser = argparse.ArgumentParser()
     parser.add_argument("--smoke", action="store_true")
     parser.add_argument("--wine", action="store_true")
@@ -135,9 +202,18 @@ def main():
     queue = multiprocessing.Queue()
     pool = multiprocessing.pool.ThreadPool()
     tests = [
+        (unit_test, opts, queue, "arena-test"),
+        (unit_test, opts, queue, "atlas-test"),
         (unit_test, opts, queue, "color-test"),
         (unit_test, opts, queue, "editable-text-test"),
+        (unit_test, opts, queue, "fixed-batch-test"),
         (unit_test, opts, queue, "fixed-test"),
+        (unit_test, opts, queue, "profile-test"),
+        (unit_test, opts, queue, "random-test"),
+        (unit_test, opts, queue, "render-frame-test"),
+        (unit_test, opts, queue, "rollback-test"),
+        (unit_test, opts, queue, "snapshot-test"),
+        (unit_test, opts, queue, "trace-test"),
         (data_test, opts, queue, "build-pix", [], ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
@@ -147,6 +223,7 @@ def main():
         (offscreen_test, opts, queue, "mission-briefing", ["--text"]),
         (offscreen_test, opts, queue, "options"),
         (offscreen_test, opts, queue, "pause", ["--text"]),
+        (sprite_test, opts, queue, "bench-sprites", ["--sprites=400"]),
         (replay_test, opts, queue, "and-it-feels-so-good"),
         (replay_test, opts, queue, "astrotrash-plus"),
         (replay_test, opts, queue, "blood-toil-tears-sweat"),
@@ -164,11 +241,20 @@ def main():
         (replay_test, opts, queue, "yo-ho-ho"),
         (replay_test, opts, queue, "you-should-have-seen-the-one-that-got-away"),
     ]
+    replays = [t[3] for t in tests if t[0] == replay_test]
+    tests += [(simulate_test, opts, queue, "%s-simulate" % name, name) for name in replays]
+    tests += [(broadphase_test, opts, queue, "%s-broadphase" % name, name) for name in replays]
+    tests += [(threads_test, opts, queue, "%s-threads" % name, name) for name in replays]
+    tests += [(alloc_test, opts, queue, "%s-alloc" % name, name) for name in replays]
 
     if opts.test:
         test_map = dict((t[3], t) for t in tests)
         tests = [test_map[test] for test in opts.test]
 
+    if not (opts.type or opts.test):
+        # The sprites test has no expected frames in test/ yet, so it only runs when asked for.
+        opts.type = [t for t in test_types if t != "sprites"]
+
     if opts.type:
         if "unit" not in opts.type:
             tests = [t for t in tests if t[0] != unit_test]
@@ -176,8 +262,22 @@ def main():
             tests = [t for t in tests if t[0] != data_test]
         if "offscreen" not in opts.type:
             tests = [t for t in tests if t[0] != offscreen_test]
+        if "sprites" not in opts.type:
+            tests = [t for t in tests if t[0] != sprite_test]
         if "replay" not in opts.type:
             tests = [t for t in tests if t[0] != replay_test]
+        if "simulate" not in opts.type:
+            tests = [t for t in tests if t[0] != simulate_test]
+        if "broadphase" not in opts.type:
+            tests = [t for t in tests if t[0] != broadphase_test]
+        if "threads" not in opts.type:
+            tests = [t for t in tests if t[0] != threads_test]
+        if "alloc" not in opts.type:
+            tests = [t for t in tests if t[0] != alloc_test]
+
+    if opts.smoke:
+        # Compares pixels, which smoke tests (run without a GPU) can't draw.
+        tests = [t for t in tests if t[0] != sprite_test]
 
     if opts.wine:
         tests = [t for t in tests if t[3] in WINE_TESTS]
@@ -0,0 +1,313 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "data/replay.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/level.hpp"
+#include "game/main.hpp"
+#include "game/messages.hpp"
+#include "game/non-player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "lang/alloc-count.hpp"
+#include "lang/exception.hpp"
+#include "sound/driver.hpp"
+#include "ui/card.hpp"
+#include "video/text-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+// `values` must not be empty; main() rejects --runs below 1.
+template <typename T>
+T median(std::vector<T> values) {
+    if (values.empty()) {
+        throw std::runtime_error("median of no values");
+    }
+    auto mid = values.begin() + (values.size() / 2);
+    std::nth_element(values.begin(), mid, values.end());
+    return *mid;
+}
+
+// Pools, queues and arenas grow to fit a level during its first moments. After that, a major tick
+// shouldn't need the heap at all.
+const ticks kAllocationWarmup = secs(30);
+
+int64_t peak_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Bytes on macOS.
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Plays a replay headlessly several times, after a few runs to warm up, and prints what the
+// timed runs took as a JSON object. scripts/bench-replay.py runs it over the test replays.
+//
+// With `check_allocations`, also fails if any major tick after kAllocationWarmup allocated;
+// scripts/test.py checks each test replay this way.
+class BenchMaster : public Card {
+  public:
+    BenchMaster(
+            pn::string_view name, pn::data_view data, int32_t runs, int32_t warmup,
+            bool check_allocations)
+            : _name(name),
+              _data(data),
+              _runs(runs),
+              _warmup(warmup),
+              _check_allocations(check_allocations) {}
+
+    virtual void become_front() {
+        for (int32_t i = 0; i < _warmup; ++i) {
+            run();
+        }
+
+        std::vector<double>  walls, tick_p50s, tick_p99s;
+        std::vector<int64_t> allocations, steady_allocations;
+        int64_t              ticks = 0;
+        uint32_t             sync  = 0;
+        for (int32_t i = 0; i < _runs; ++i) {
+            Run r = run();
+            if ((i > 0) && ((r.ticks != ticks) || (r.sync != sync))) {
+                throw std::runtime_error(pn::format("run {0} diverged from run 0", i).c_str());
+            }
+            ticks = r.ticks;
+            sync  = r.sync;
+            walls.push_back(r.wall);
+            tick_p50s.push_back(r.tick_p50);
+            tick_p99s.push_back(r.tick_p99);
+            allocations.push_back(r.allocations);
+            steady_allocations.push_back(r.steady_allocations);
+        }
+
+        double wall = median(walls);
+        pn::out.write("{\n");
+        pn::out.format("  \"replay\": \"{0}\",\n", _name);
+        pn::out.format("  \"runs\": {0},\n", _runs);
+        pn::out.format("  \"ticks\": {0},\n", ticks);
+        pn::out.format("  \"sync\": {0},\n", sync);
+        pn::out.format("  \"wall_s\": {0},\n", wall);
+        pn::out.format("  \"ticks_per_s\": {0},\n", ticks / wall);
+        pn::out.format("  \"major_tick_p50_us\": {0},\n", median(tick_p50s));
+        pn::out.format("  \"major_tick_p99_us\": {0},\n", median(tick_p99s));
+        pn::out.format("  \"allocations\": {0},\n", median(allocations));
+        pn::out.format("  \"steady_allocations\": {0},\n", median(steady_allocations));
+        pn::out.format("  \"peak_rss_kb\": {0}\n", peak_rss_kb());
+        pn::out.write("}\n");
+
+        if (_check_allocations && report_allocations()) {
+            throw std::runtime_error("major ticks allocated after warming up");
+        }
+        stack()->pop(this);
+    }
+
+  private:
+    struct Run {
+        double   wall;
+        int64_t  ticks;
+        uint32_t sync;
+        double   tick_p50;
+        double   tick_p99;
+        int64_t  allocations;
+        int64_t  steady_allocations;  // In major ticks after kAllocationWarmup.
+    };
+
+    // Loads the level fresh, then times playing it out. Loading isn't counted.
+    Run run() {
+        init();
+        ReplayData        data(_data);
+        ReplayInputSource input(&data);
+        g.random.seed = data.global_seed;
+        RemoveAllSpaceObjects();
+        g.game_over = false;
+        LoadState s = start_construct_level(*Level::get(data.chapter_id));
+        while (!s.done) {
+            construct_level(&s);
+        }
+
+        tick_profile.set_enabled(true);
+        tick_profile.set_allocation_counter(allocation_count);
+        tick_profile.reset();
+        game_ticks start_time  = g.time;
+        int64_t    start_count = allocation_count();
+        auto       start       = std::chrono::steady_clock::now();
+        simulate_loaded_level(&input);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        Run        r;
+        PhaseTimes t  = tick_profile.tick_times();
+        r.wall        = std::chrono::duration<double>(elapsed).count();
+        r.ticks       = (g.time - start_time).count();
+        r.sync        = g.sync;
+        r.tick_p50    = std::chrono::duration<double, std::micro>(t.p50).count();
+        r.tick_p99    = std::chrono::duration<double, std::micro>(t.p99).count();
+        r.allocations = allocation_count() - start_count;
+
+        r.steady_allocations = 0;
+        const auto& per_tick = tick_profile.tick_allocations();
+        for (size_t i = kAllocationWarmup / kMajorTick; i < per_tick.size(); ++i) {
+            r.steady_allocations += per_tick[i];
+        }
+        return r;
+    }
+
+    // Lists the major ticks of the last run that allocated after warming up. Returns true if
+    // there were any.
+    bool report_allocations() {
+        const auto& per_tick = tick_profile.tick_allocations();
+        bool        found    = false;
+        for (size_t i = kAllocationWarmup / kMajorTick; i < per_tick.size(); ++i) {
+            if (per_tick[i] > 0) {
+                pn::err.format(
+                        "{0}: major tick {1} made {2} allocations\n", _name, i, per_tick[i]);
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    void init() {
+        init_globals();
+        sys_init();
+        Label::init();
+        Messages::init();
+        InstrumentInit();
+        SpriteHandlingInit();
+        PluginInit();
+        SpaceObjectHandlingInit();  // MUST be after PluginInit()
+        Admiral::init();
+        Vectors::init();
+    }
+
+    const pn::string_view _name;
+    const pn::data_view   _data;
+    const int32_t         _runs;
+    const int32_t         _warmup;
+    const bool            _check_allocations;
+};
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] replay\n"
+            "\n"
+            "  Times a replay played without drawing anything\n"
+            "\n"
+            "  arguments:\n"
+            "    replay              an Antares replay script\n"
+            "\n"
+            "  options:\n"
+            "    -n, --runs=COUNT    timed runs (default: 5)\n"
+            "    -w, --warmup=COUNT  untimed runs first (default: 1)\n"
+            "        --check-allocations\n"
+            "                        fail if major ticks allocate after warming up\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    sfz::optional<pn::string> replay_path;
+    callbacks.argument = [&replay_path](pn::string_view arg) {
+        if (!replay_path.has_value()) {
+            replay_path.emplace(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    int32_t runs              = 5;
+    int32_t warmup            = 1;
+    bool    check_allocations = false;
+    callbacks.short_option =
+            [&runs, &warmup](pn::rune opt, const args::callbacks::get_value_f& get_value) {
+                switch (opt.value()) {
+                    case 'n': sfz::args::integer_option(get_value(), &runs); return true;
+                    case 'w': sfz::args::integer_option(get_value(), &warmup); return true;
+                    default: return false;
+                }
+            };
+
+    callbacks.long_option =
+            [&argv, &callbacks, &check_allocations](
+                    pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "runs") {
+                    return callbacks.short_option(pn::rune{'n'}, get_value);
+                } else if (opt == "warmup") {
+                    return callbacks.short_option(pn::rune{'w'}, get_value);
+                } else if (opt == "check-allocations") {
+                    check_allocations = true;
+                    return true;
+                } else if (opt == "help") {
+                    usage(pn::out, sfz::path::basename(argv[0]), 0);
+                    return true;
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!replay_path.has_value()) {
+        throw std::runtime_error("missing required argument 'replay'");
+    } else if (runs < 1) {
+        throw std::runtime_error("--runs must be at least 1");
+    } else if (warmup < 0) {
+        throw std::runtime_error("--warmup must not be negative");
+    }
+
+    Preferences     preferences;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+
+    sfz::mapped_file replay_file(*replay_path);
+    EventScheduler   scheduler;
+    TextVideoDriver  video({640, 480}, sfz::optional<pn::string>());
+    video.loop(
+            new BenchMaster(
+                    sfz::path::basename(*replay_path), replay_file.data(), runs, warmup,
+                    check_allocations),
+            scheduler);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
@@ -0,0 +1,338 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/level.hpp"
+#include "data/plugin.hpp"
+#include "drawing/color.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/level.hpp"
+#include "game/messages.hpp"
+#include "game/profile.hpp"
+#include "game/render-frame.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "lang/exception.hpp"
+#include "math/random.hpp"
+#include "math/scale.hpp"
+#include "sound/driver.hpp"
+#include "ui/card.hpp"
+#include "video/driver.hpp"
+#include "video/offscreen-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+// The scales that still draw sprites, rather than blips, from the most zoomed-out.
+const struct {
+    const char* name;
+    const char* file;  // For --output.
+    Scale       scale;
+} kScales[] = {
+        {"1/4", "quarter", kOneQuarterScale},
+        {"1/2", "half", kOneHalfScale},
+        {"1/1", "full", SCALE_SCALE},
+};
+
+template <typename T>
+T median(std::vector<T> values) {
+    auto mid = values.begin() + (values.size() / 2);
+    std::nth_element(values.begin(), mid, values.end());
+    return *mid;
+}
+
+// Loads a level, scatters copies of its sprites across the screen, and draws them at each scale
+// in kScales. The level's sprites come in each admiral's hue, so most are tinted; some copies are
+// drawn as static, and some outlined, as the briefing screen draws them, so that every sprite
+// program is exercised.
+//
+// OffscreenVideoDriver::capture() pushes a card per frame, and finishes drawing each frame
+// before it pushes the next, so the time from one card's draw() to the next is what the frame
+// took to draw, through glFinish().
+class SpriteBench {
+  public:
+    SpriteBench(int32_t chapter, int32_t sprites) : _chapter(chapter), _sprites(sprites) {}
+
+    void load() {
+        init();
+        const Level* level = Level::get(_chapter);
+        if (!level) {
+            throw std::runtime_error(pn::format("no chapter {0}", _chapter).c_str());
+        }
+
+        g.random.seed = 0;
+        RemoveAllSpaceObjects();
+        g.game_over = false;
+        LoadState s = start_construct_level(*level);
+        while (!s.done) {
+            construct_level(&s);
+        }
+
+        RenderFrame level_frame;
+        capture_sprites(&level_frame);
+        if (level_frame.sprites.empty()) {
+            throw std::runtime_error("level has no sprites to copy");
+        }
+
+        // One in eight is drawn as static, as cloaking ships and flashing sprites are, and
+        // another one in eight is outlined.
+        Random random{1};
+        Size   screen = sys.video->screen_size();
+        for (int32_t i = 0; i < _sprites; ++i) {
+            RenderFrame::SpriteView view = level_frame.sprites[i % level_frame.sprites.size()];
+            view.number = i;
+            view.where  = Point(random.next(screen.width), random.next(screen.height));
+            if ((i % 8) == 0) {
+                view.style      = spriteColor;
+                view.style_data = random.next(256);
+            } else if ((i % 8) == 4) {
+                _outlined.push_back(view);
+                continue;
+            }
+            _frame.sprites.push_back(view);
+        }
+    }
+
+    // Draws every sprite at `scale`. Only frames that are `timed` are counted.
+    void draw(Scale scale, bool timed) {
+        mark(scale, timed);
+        _frame.scale = scale;
+        draw_sprites(_frame);
+
+        const RgbColor outline = GetRGBTranslateColorShade(Hue::GREEN, LIGHTER);
+        const RgbColor fill    = GetRGBTranslateColorShade(Hue::GREEN, DARKER);
+        for (const RenderFrame::SpriteView& view : _outlined) {
+            Rect rect = scale_sprite_rect(*view.frame, view.where, scale_by(view.scale, scale));
+            view.frame->texture().draw_outlined(rect, outline, fill);
+        }
+    }
+
+    void report() {
+        mark(SCALE_SCALE, false);
+        for (const auto& s : kScales) {
+            std::vector<double>    frame_us;
+            VideoDriver::DrawStats stats;
+            for (const Sample& sample : _samples) {
+                if (sample.scale == s.scale) {
+                    frame_us.push_back(sample.frame_us);
+                    stats = sample.stats;
+                }
+            }
+            if (frame_us.empty()) {
+                continue;
+            }
+            pn::out.format(
+                    "{0} scale: {1} sprites, {2} us per frame (p50 of {3})\n", s.name,
+                    _frame.sprites.size() + _outlined.size(), median(frame_us), frame_us.size());
+            pn::out.format(
+                    "  {0} draw calls, {1} instances, {2} vertices, {3} texture switches, {4} "
+                    "program switches\n",
+                    stats.draw_calls, stats.instances, stats.vertices, stats.texture_switches,
+                    stats.program_switches);
+            for (const auto& p : stats.program_times) {
+                if (p.name && (p.nsecs > 0)) {
+                    pn::out.format("  {0}: {1} us on the GPU\n", p.name, p.nsecs / 1000.0);
+                }
+            }
+        }
+    }
+
+  private:
+    struct Sample {
+        Scale                  scale;
+        double                 frame_us;
+        VideoDriver::DrawStats stats;
+    };
+
+    // Called as each frame starts, by which time the last one has been drawn.
+    void mark(Scale scale, bool timed) {
+        auto now = std::chrono::steady_clock::now();
+        if (_timed) {
+            _samples.push_back(
+                    Sample{_scale,
+                           std::chrono::duration<double, std::micro>(now - _start).count(),
+                           sys.video->draw_stats()});
+        }
+        _start = now;
+        _scale = scale;
+        _timed = timed;
+    }
+
+    // sys_init() was already called by OffscreenVideoDriver::capture().
+    void init() {
+        init_globals();
+        Label::init();
+        Messages::init();
+        InstrumentInit();
+        SpriteHandlingInit();
+        PluginInit();
+        SpaceObjectHandlingInit();  // MUST be after PluginInit()
+        Admiral::init();
+        Vectors::init();
+    }
+
+    const int32_t _chapter;
+    const int32_t _sprites;
+
+    RenderFrame                           _frame;
+    std::vector<RenderFrame::SpriteView>  _outlined;
+    std::vector<Sample>                   _samples;
+    std::chrono::steady_clock::time_point _start;
+    Scale                                 _scale = SCALE_SCALE;
+    bool                                  _timed = false;
+};
+
+// Draws one frame of the benchmark.
+class Step : public Card {
+  public:
+    Step(std::function<void()> fn) : _fn(fn) {}
+
+    virtual void draw() const { _fn(); }
+
+  private:
+    const std::function<void()> _fn;
+};
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS]\n"
+            "\n"
+            "  Times drawing a screen full of sprites at each zoomed-out scale\n"
+            "\n"
+            "  With --output, draws one frame at each scale instead, and saves it as\n"
+            "  OUTPUT/quarter.png, half.png, and full.png, for comparison with earlier output.\n"
+            "\n"
+            "  options:\n"
+            "    -c, --chapter=CHAPTER\n"
+            "                        chapter whose sprites to draw (default: 1)\n"
+            "    -n, --sprites=COUNT number of sprites to draw (default: 2000)\n"
+            "    -f, --frames=COUNT  timed frames at each scale (default: 100)\n"
+            "    -o, --output=OUTPUT save frames in this directory\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    callbacks.argument = [](pn::string_view arg) { return false; };
+
+    int32_t                   chapter = 1;
+    int32_t                   sprites = 2000;
+    int32_t                   frames  = 100;
+    sfz::optional<pn::string> output_dir;
+    callbacks.short_option =
+            [&chapter, &sprites, &frames, &output_dir](
+                    pn::rune opt, const args::callbacks::get_value_f& get_value) {
+                switch (opt.value()) {
+                    case 'c': sfz::args::integer_option(get_value(), &chapter); return true;
+                    case 'n': sfz::args::integer_option(get_value(), &sprites); return true;
+                    case 'f': sfz::args::integer_option(get_value(), &frames); return true;
+                    case 'o': output_dir.emplace(get_value().copy()); return true;
+                    default: return false;
+                }
+            };
+
+    callbacks.long_option =
+            [&argv, &callbacks](
+                    pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "chapter") {
+                    return callbacks.short_option(pn::rune{'c'}, get_value);
+                } else if (opt == "sprites") {
+                    return callbacks.short_option(pn::rune{'n'}, get_value);
+                } else if (opt == "frames") {
+                    return callbacks.short_option(pn::rune{'f'}, get_value);
+                } else if (opt == "output") {
+                    return callbacks.short_option(pn::rune{'o'}, get_value);
+                } else if (opt == "help") {
+                    usage(pn::out, sfz::path::basename(argv[0]), 0);
+                    return true;
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (frames < 1) {
+        throw std::runtime_error("--frames must be at least 1");
+    }
+
+    Preferences     preferences;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+
+    SpriteBench                                                bench(chapter, sprites);
+    std::vector<std::pair<std::unique_ptr<Card>, pn::string>> steps;
+
+    auto add = [&steps](std::function<void()> fn, pn::string_view path) {
+        steps.emplace_back(std::unique_ptr<Card>(new Step(fn)), path.copy());
+    };
+    if (output_dir.has_value()) {
+        // Every step is saved, so the level is loaded as part of the first.
+        for (const auto& s : kScales) {
+            Scale scale = s.scale;
+            bool  load  = (&s == kScales);
+            auto  draw  = [&bench, scale, load] {
+                if (load) {
+                    bench.load();
+                }
+                bench.draw(scale, false);
+            };
+            add(draw, pn::format("{0}.png", s.file));
+        }
+    } else {
+        // The first frame at each scale isn't timed, in case it has anything left to upload.
+        add([&bench] { bench.load(); }, "");
+        for (const auto& s : kScales) {
+            Scale scale = s.scale;
+            add([&bench, scale] { bench.draw(scale, false); }, "");
+            for (int32_t i = 0; i < frames; ++i) {
+                add([&bench, scale] { bench.draw(scale, true); }, "");
+            }
+        }
+        add([&bench] { bench.report(); }, "");
+
+        // Has the driver time each program on the GPU.
+        tick_profile.set_enabled(true);
+    }
+
+    OffscreenVideoDriver video({640, 480}, output_dir);
+    video.capture(steps);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
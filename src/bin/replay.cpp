@@ -39,10 +39,13 @@
 #include "game/main.hpp"
 #include "game/messages.hpp"
 #include "game/motion.hpp"
+#include "game/non-player-ship.hpp"
+#include "game/profile.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/exception.hpp"
+#include "lang/trace.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "sound/driver.hpp"
@@ -62,10 +65,16 @@ namespace path = sfz::path;
 namespace antares {
 namespace {
 
+enum class ProfileFormat { NONE, JSON, CSV };
+
 class ReplayMaster : public Card {
   public:
-    ReplayMaster(pn::data_view data, const sfz::optional<pn::string>& output_path)
+    ReplayMaster(
+            pn::data_view data, const sfz::optional<pn::string>& output_path, bool simulate_only,
+            ProfileFormat profile)
             : _state(NEW),
+              _simulate_only(simulate_only),
+              _profile(profile),
               _replay_data(data),
               _random_seed(_replay_data.global_seed),
               _game_result(NO_GAME),
@@ -83,43 +92,72 @@ class ReplayMaster : public Card {
                 Randomize(4);  // For the decision to replay intro.
                 _game_result  = NO_GAME;
                 g.random.seed = _random_seed;
-                stack()->push(new MainPlay(
-                        *Level::get(_replay_data.chapter_id), true, &_input_source, false,
-                        &_game_result));
-                break;
-
-            case REPLAY:
-                if (_output_path.has_value()) {
-                    pn::string path = pn::format("{0}/debriefing.txt", *_output_path);
-                    sfz::makedirs(path::dirname(path), 0755);
-                    pn::output outcome{path, pn::text};
-                    if (g.victory_text.has_value()) {
-                        outcome.write(*g.victory_text);
-                        if (_game_result == WIN_GAME) {
-                            outcome.write("\n");
-                            Handle<Admiral> player(0);
-                            pn::string      text = DebriefingScreen::build_score_text(
-                                    g.time, g.level->solo.par.time, GetAdmiralLoss(player),
-                                    g.level->solo.par.losses, GetAdmiralKill(player),
-                                    g.level->solo.par.kills);
-                            outcome.write(text);
-                            outcome.write("\n");
-                        }
-                    }
+                tick_profile.set_enabled(_profile != ProfileFormat::NONE);
+                if (_simulate_only) {
+                    _game_result = simulate_level(
+                            *Level::get(_replay_data.chapter_id), &_input_source);
+                    finish();
+                } else {
+                    stack()->push(new MainPlay(
+                            *Level::get(_replay_data.chapter_id), true, &_input_source, false,
+                            &_game_result));
                 }
-                stack()->pop(this);
                 break;
+
+            case REPLAY: finish(); break;
         }
     }
 
   private:
     void init();
 
+    // Writes the tick profile to OUTPUT/profile.json or .csv, or without an output directory, to
+    // stdout.
+    void write_profile() {
+        bool       csv    = (_profile == ProfileFormat::CSV);
+        pn::string report = csv ? tick_profile.csv() : tick_profile.json();
+        if (_output_path.has_value()) {
+            pn::string path = pn::format("{0}/profile.{1}", *_output_path, csv ? "csv" : "json");
+            pn::output out{path, pn::text};
+            out.write(report);
+        } else {
+            pn::out.write(report);
+        }
+    }
+
+    void finish() {
+        pn::out.format("sync: {0}\n", g.sync);
+        if (_profile != ProfileFormat::NONE) {
+            write_profile();
+        }
+        if (_output_path.has_value()) {
+            pn::string path = pn::format("{0}/debriefing.txt", *_output_path);
+            sfz::makedirs(path::dirname(path), 0755);
+            pn::output outcome{path, pn::text};
+            if (g.victory_text.has_value()) {
+                outcome.write(*g.victory_text);
+                if (_game_result == WIN_GAME) {
+                    outcome.write("\n");
+                    Handle<Admiral> player(0);
+                    pn::string      text = DebriefingScreen::build_score_text(
+                            g.time, g.level->solo.par.time, GetAdmiralLoss(player),
+                            g.level->solo.par.losses, GetAdmiralKill(player),
+                            g.level->solo.par.kills);
+                    outcome.write(text);
+                    outcome.write("\n");
+                }
+            }
+        }
+        stack()->pop(this);
+    }
+
     enum State {
         NEW,
         REPLAY,
     };
-    State _state;
+    State               _state;
+    const bool          _simulate_only;
+    const ProfileFormat _profile;
 
     sfz::optional<pn::string> _output_path;
     ReplayData                _replay_data;
@@ -144,6 +182,16 @@ void ReplayMaster::init() {
     Vectors::init();
 }
 
+void profile_option(pn::string_view value, ProfileFormat* out) {
+    if (value == "json") {
+        *out = ProfileFormat::JSON;
+    } else if (value == "csv") {
+        *out = ProfileFormat::CSV;
+    } else {
+        throw std::runtime_error(pn::format("invalid profile format: {0}", value).c_str());
+    }
+}
+
 void usage(pn::output_view out, pn::string_view progname, int retcode) {
     out.format(
             "usage: {0} [OPTIONS]\n"
@@ -161,6 +209,13 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "    -h, --height=HEIGHT screen height (default: 480)\n"
             "    -t, --text          produce text output\n"
             "    -s, --smoke         run as smoke text\n"
+            "        --simulate-only only check the outcome, skipping everything drawn\n"
+            "        --profile=json|csv\n"
+            "                        report time spent in each phase of the game loop\n"
+            "        --trace=FILE    write a Chrome trace of the replay here\n"
+            "        --broadphase=grid|sweep\n"
+            "                        how to find colliding objects (default: grid)\n"
+            "        --threads=COUNT threads for ship AI (default: 1)\n"
             "        --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -185,6 +240,10 @@ void main(int argc, char* const* argv) {
     int                       height   = 480;
     bool                      text     = false;
     bool                      smoke    = false;
+    int                       threads  = 1;
+    bool                      simulate = false;
+    ProfileFormat             profile  = ProfileFormat::NONE;
+    sfz::optional<pn::string> trace_path;
     callbacks.short_option             = [&output_dir, &interval, &width, &height, &text, &smoke](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
@@ -198,7 +257,7 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option = [&argv, &callbacks](
+    callbacks.long_option = [&argv, &callbacks, &threads, &simulate, &profile, &trace_path](
                                     pn::string_view                     opt,
                                     const args::callbacks::get_value_f& get_value) {
         if (opt == "output") {
@@ -213,6 +272,21 @@ void main(int argc, char* const* argv) {
             return callbacks.short_option(pn::rune{'t'}, get_value);
         } else if (opt == "smoke") {
             return callbacks.short_option(pn::rune{'s'}, get_value);
+        } else if (opt == "broadphase") {
+            broadphase_option(get_value(), &broadphase);
+            return true;
+        } else if (opt == "threads") {
+            sfz::args::integer_option(get_value(), &threads);
+            return true;
+        } else if (opt == "simulate-only") {
+            simulate = true;
+            return true;
+        } else if (opt == "profile") {
+            profile_option(get_value(), &profile);
+            return true;
+        } else if (opt == "trace") {
+            trace_path.emplace(get_value().copy());
+            return true;
         } else if (opt == "help") {
             usage(pn::out, sfz::path::basename(argv[0]), 0);
             return true;
@@ -222,6 +296,7 @@ void main(int argc, char* const* argv) {
     };
 
     args::parse(argc - 1, argv + 1, callbacks);
+    SetThinkThreads(threads);
     if (!replay_path.has_value()) {
         throw std::runtime_error("missing required argument 'replay'");
     }
@@ -242,7 +317,7 @@ void main(int argc, char* const* argv) {
     }
 
     unique_ptr<SoundDriver> sound;
-    if (!smoke && output_dir.has_value()) {
+    if (!smoke && !simulate && output_dir.has_value()) {
         pn::string out = pn::format("{0}/sound.log", *output_dir);
         sound.reset(new LogSoundDriver(out));
     } else {
@@ -251,15 +326,23 @@ void main(int argc, char* const* argv) {
     NullLedger ledger;
 
     sfz::mapped_file replay_file(*replay_path);
-    if (smoke) {
+    if (trace_path.has_value()) {
+        start_tracing();
+    }
+
+    if (smoke || simulate) {
         TextVideoDriver video({width, height}, sfz::optional<pn::string>());
-        video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, simulate, profile), scheduler);
     } else if (text) {
         TextVideoDriver video({width, height}, output_dir);
-        video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, false, profile), scheduler);
     } else {
         OffscreenVideoDriver video({width, height}, output_dir);
-        video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, false, profile), scheduler);
+    }
+
+    if (trace_path.has_value()) {
+        write_trace(*trace_path);
     }
 }
 
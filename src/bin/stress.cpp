@@ -0,0 +1,300 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/level.hpp"
+#include "data/plugin.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/action.hpp"
+#include "game/admiral.hpp"
+#include "game/condition.hpp"
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/level.hpp"
+#include "game/messages.hpp"
+#include "game/motion.hpp"
+#include "game/non-player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/snapshot.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "lang/exception.hpp"
+#include "math/random.hpp"
+#include "math/rotation.hpp"
+#include "sound/driver.hpp"
+#include "ui/card.hpp"
+#include "video/text-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+// Loads a level, floods it with copies of its initial objects, and runs the simulation as fast
+// as it can, to see whether a battle of that size keeps up with the game's tick rate.
+//
+// With a small `spread`, the copies start packed around the originals, so ships are in range of
+// each other from the start: a weapon- and collision-heavy battle, for timing the phases that run
+// actions (firing in THINK, delayed actions in ACTIONS, and hits in COLLIDE).
+class StressMaster : public Card {
+  public:
+    StressMaster(int32_t chapter, int32_t objects, int32_t seconds, int32_t spread)
+            : _chapter(chapter), _objects(objects), _seconds(seconds), _spread(spread) {}
+
+    virtual void become_front() {
+        init();
+        const Level* level = Level::get(_chapter);
+        if (!level) {
+            throw std::runtime_error(pn::format("no chapter {0}", _chapter).c_str());
+        }
+
+        g.random.seed = 0;
+        RemoveAllSpaceObjects();
+        g.game_over = false;
+        LoadState s = start_construct_level(*level);
+        while (!s.done) {
+            construct_level(&s);
+        }
+        populate();
+
+        tick_profile.set_enabled(true);
+        tick_profile.reset();
+        int32_t max_live   = 0;
+        int64_t near_pairs = 0;
+        int64_t far_pairs  = 0;
+        int64_t evaluated  = 0;
+        int64_t skipped    = 0;
+        auto    start      = std::chrono::steady_clock::now();
+        for (game_ticks end = g.time + secs(_seconds); g.time < end;) {
+            g.time += kMajorTick;
+            MoveSpaceObjects(kMajorTick);
+            NonplayerShipThink();
+            AdmiralThink();
+            execute_action_queue();
+            CollideSpaceObjects();
+            near_pairs += collision_stats.near_pairs;
+            far_pairs += collision_stats.far_pairs;
+            if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
+                CheckLevelConditions();
+                evaluated += condition_stats.evaluated;
+                skipped += condition_stats.skipped;
+            }
+            CullSprites();
+            Vectors::cull();
+            tick_profile.end_tick();
+            tick_arena.reset();
+            max_live = std::max(max_live, CountObjectsOfBaseType(nullptr, Admiral::none()));
+        }
+        auto   elapsed     = std::chrono::steady_clock::now() - start;
+        double wall        = std::chrono::duration<double>(elapsed).count();
+        double ticks       = _seconds * 60.0;
+        double major_ticks = ticks / kMajorTick.count();
+
+        pn::out.format(
+                "objects: {0} created, {1} at peak, {2} capacity\n", _created, max_live,
+                g.objects.size());
+        pn::out.format(
+                "pairs tested per major tick: {0} near, {1} far\n", near_pairs / major_ticks,
+                far_pairs / major_ticks);
+        pn::out.format("conditions checked: {0} evaluated, {1} clean\n", evaluated, skipped);
+        pn::out.format(
+                "delayed actions: {0} queued, {1} pending at peak\n", g.action_queue.queued,
+                g.action_queue.peak);
+        pn::out.format(
+                "actions run: {0} from {1} compiled lists\n", action_stats.executed,
+                action_stats.compiled);
+        for (TickPhase phase : {TickPhase::THINK, TickPhase::ACTIONS, TickPhase::COLLIDE}) {
+            PhaseTimes t = tick_profile.times(phase);
+            pn::out.format(
+                    "{0} per major tick: {1} us p50, {2} us p99\n", phase_name(phase),
+                    std::chrono::duration<double, std::micro>(t.p50).count(),
+                    std::chrono::duration<double, std::micro>(t.p99).count());
+        }
+        tick_profile.set_enabled(false);
+        report_snapshot();
+        pn::out.format(
+                "simulated {0}s in {1}s: {2} ticks/s ({3}x real time)\n", _seconds, wall,
+                ticks / wall, ticks / wall / 60.0);
+        stack()->pop(this);
+    }
+
+  private:
+    // Times saving and restoring the state the simulation ended in.
+    void report_snapshot() {
+        const int kTrials = 100;
+        Snapshot  snapshot;
+        snapshot.save();  // Sizes the arena.
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTrials; ++i) {
+            snapshot.save();
+        }
+        auto saved = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTrials; ++i) {
+            snapshot.restore();
+        }
+        auto restored = std::chrono::steady_clock::now();
+        pn::out.format(
+                "snapshot: {0} bytes, {1} us to save, {2} us to restore\n", snapshot.size(),
+                std::chrono::duration<double, std::micro>(saved - start).count() / kTrials,
+                std::chrono::duration<double, std::micro>(restored - saved).count() / kTrials);
+    }
+
+    void init() {
+        init_globals();
+        sys_init();
+        Label::init();
+        Messages::init();
+        InstrumentInit();
+        SpriteHandlingInit();
+        PluginInit();
+        SpaceObjectHandlingInit();  // MUST be after PluginInit()
+        Admiral::init();
+        Vectors::init();
+    }
+
+    // Scatters copies of the level's initial objects (which are sure to have their media loaded)
+    // around the objects they were copied from, keeping their owners.
+    void populate() {
+        std::vector<Handle<SpaceObject>> sources;
+        for (auto o : g.initials) {
+            if (o.get() && o->active) {
+                sources.push_back(o);
+            }
+        }
+        if (sources.empty()) {
+            throw std::runtime_error("level has no initial objects to copy");
+        }
+
+        Random random{1};
+        for (_created = 0; _created < _objects; ++_created) {
+            auto           source    = sources[_created % sources.size()];
+            Point          location  = source->location;
+            fixedPointType velocity  = {Fixed::zero(), Fixed::zero()};
+            int32_t        direction = random.next(ROT_POS);
+            location.h += random.next(int16_t(_spread)) - (_spread / 2);
+            location.v += random.next(int16_t(_spread)) - (_spread / 2);
+            auto o = CreateAnySpaceObject(
+                    *source->base, &velocity, &location, direction, source->owner, 0,
+                    sfz::nullopt);
+            if (!o.get()) {
+                break;
+            }
+        }
+    }
+
+    const int32_t _chapter;
+    const int32_t _objects;
+    const int32_t _seconds;
+    const int32_t _spread;  // Width of the square that copies are scattered over.
+    int32_t       _created = 0;
+};
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS]\n"
+            "\n"
+            "  Runs a level with thousands of objects and reports the tick rate\n"
+            "\n"
+            "  options:\n"
+            "    -c, --chapter=CHAPTER\n"
+            "                        chapter to load (default: 1)\n"
+            "    -n, --objects=COUNT number of objects to add (default: 5000)\n"
+            "    -s, --seconds=SECS  game time to simulate (default: 60)\n"
+            "        --spread=UNITS  width of the area copies are scattered over;\n"
+            "                        smaller is more crowded (default: 16384)\n"
+            "        --broadphase=grid|sweep\n"
+            "                        how to find colliding objects (default: grid)\n"
+            "        --threads=COUNT threads for ship AI (default: 1)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    callbacks.argument = [](pn::string_view arg) { return false; };
+
+    int32_t chapter = 1;
+    int32_t objects = 5000;
+    int32_t seconds = 60;
+    int32_t threads = 1;
+    int32_t spread  = 16384;
+    callbacks.short_option =
+            [&chapter, &objects, &seconds](
+                    pn::rune opt, const args::callbacks::get_value_f& get_value) {
+                switch (opt.value()) {
+                    case 'c': sfz::args::integer_option(get_value(), &chapter); return true;
+                    case 'n': sfz::args::integer_option(get_value(), &objects); return true;
+                    case 's': sfz::args::integer_option(get_value(), &seconds); return true;
+                    default: return false;
+                }
+            };
+
+    callbacks.long_option =
+            [&argv, &callbacks, &threads, &spread](
+                    pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "chapter") {
+                    return callbacks.short_option(pn::rune{'c'}, get_value);
+                } else if (opt == "objects") {
+                    return callbacks.short_option(pn::rune{'n'}, get_value);
+                } else if (opt == "seconds") {
+                    return callbacks.short_option(pn::rune{'s'}, get_value);
+                } else if (opt == "broadphase") {
+                    broadphase_option(get_value(), &broadphase);
+                    return true;
+                } else if (opt == "spread") {
+                    sfz::args::integer_option(get_value(), &spread);
+                    return true;
+                } else if (opt == "threads") {
+                    sfz::args::integer_option(get_value(), &threads);
+                    return true;
+                } else if (opt == "help") {
+                    usage(pn::out, sfz::path::basename(argv[0]), 0);
+                    return true;
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if ((spread < 2) || (spread > 32767)) {
+        throw std::runtime_error("--spread must be from 2 to 32767");
+    }
+    SetThinkThreads(threads);
+
+    Preferences     preferences;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+
+    EventScheduler  scheduler;
+    TextVideoDriver video({640, 480}, sfz::optional<pn::string>());
+    video.loop(new StressMaster(chapter, objects, seconds, spread), scheduler);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
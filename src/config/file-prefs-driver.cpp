@@ -113,6 +113,7 @@ FilePrefsDriver::FilePrefsDriver() {
     set_from<bool>(m, "sound", "speech", _current, &Preferences::speech_on);
     set_from<bool>(m, "sound", "idle music", _current, &Preferences::play_idle_music);
     set_from<bool>(m, "sound", "game music", _current, &Preferences::play_music_in_game);
+    set_from<int>(m, "game", "fast motion", _current, &Preferences::fast_motion);
 
     for (auto i : range<size_t>(KEY_COUNT)) {
         set_from<Key>(m, "keys", kKeyNames[i], _current, &Preferences::keys, i);
@@ -134,6 +135,7 @@ void FilePrefsDriver::set(const Preferences& p) {
                                           {"speech", p.speech_on},
                                           {"idle music", p.play_idle_music},
                                           {"game music", p.play_music_in_game}}},
+                        {"game", pn::map{{"fast motion", p.fast_motion}}},
                         {"keys", std::move(keys)}});
 }
 
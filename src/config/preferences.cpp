@@ -98,6 +98,8 @@ Preferences::Preferences() {
 
     volume = 7;
 
+    fast_motion = 12;
+
     scenario_identifier = kFactoryScenarioIdentifier;
 }
 
@@ -108,6 +110,7 @@ Preferences Preferences::copy() const {
     copy.play_music_in_game  = play_music_in_game;
     copy.speech_on           = speech_on;
     copy.volume              = volume;
+    copy.fast_motion         = fast_motion;
     copy.scenario_identifier = scenario_identifier.copy();
     return copy;
 }
@@ -151,6 +154,16 @@ void PrefsDriver::set_volume(int volume) {
     set(p);
 }
 
+int PrefsDriver::fast_motion() const {
+    return std::min(std::max<int>(get().fast_motion, kMinFastMotion), kMaxFastMotion);
+}
+
+void PrefsDriver::set_fast_motion(int fast_motion) {
+    Preferences p(get().copy());
+    p.fast_motion = fast_motion;
+    set(p);
+}
+
 void PrefsDriver::set_scenario_identifier(pn::string_view id) {
     Preferences p(get().copy());
     p.scenario_identifier = id.copy();
@@ -45,6 +45,12 @@ FIELD_READER(Info::Identifier) {
     return {id.has_value() ? id->copy() : ""};
 }
 
+FIELD_READER(RandomMode) {
+    return optional_enum<RandomMode>(
+                   x, {{"legacy", RandomMode::LEGACY}, {"counter", RandomMode::COUNTER}})
+            .value_or(RandomMode::LEGACY);
+}
+
 static Info fill_identifier(Info info) {
     if (!info.identifier.hash.empty()) {
         return info;
@@ -65,7 +71,8 @@ Info info(path_value x) {
                 {"author_url", &Info::author_url},
                 {"version", &Info::version},
                 {"intro", &Info::intro},
-                {"about", &Info::about}}));
+                {"about", &Info::about},
+                {"random", &Info::random}}));
 }
 
 }  // namespace antares
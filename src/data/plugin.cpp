@@ -83,7 +83,8 @@ void load_object(const NamedHandle<const BaseObject>& o) {
     if (plug.objects.find(o.name().copy()) != plug.objects.end()) {
         return;  // already loaded.
     }
-    plug.objects.emplace(o.name().copy(), Resource::object(o.name()));
+    auto it = plug.objects.emplace(o.name().copy(), Resource::object(o.name())).first;
+    plug.objects_by_name.emplace(it->first, &it->second);
 }
 
 }  // namespace antares
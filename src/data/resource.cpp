@@ -40,6 +40,7 @@
 #include "data/sprite-data.hpp"
 #include "drawing/text.hpp"
 #include "game/sys.hpp"
+#include "lang/trace.hpp"
 #include "video/driver.hpp"
 
 namespace path = sfz::path;
@@ -99,6 +100,7 @@ std::vector<pn::string> Resource::list_levels() { return list_resources("levels"
 std::vector<pn::string> Resource::list_replays() { return list_resources("replays", ".NLRP"); }
 
 static std::unique_ptr<sfz::mapped_file> load(pn::string_view resource_path) {
+    ANTARES_TRACE("resource", "load", resource_path);
     pn::string      scenario = scenario_path();
     pn::string_view factory  = factory_scenario_path();
     pn::string_view app      = application_path();
@@ -114,6 +116,7 @@ static std::unique_ptr<sfz::mapped_file> load(pn::string_view resource_path) {
 }
 
 static pn::value procyon(pn::string_view path) {
+    ANTARES_TRACE("resource", "parse", path);
     pn::value  x;
     pn_error_t e;
     if (!pn::parse(load(path)->data().input(), &x, &e)) {
@@ -138,6 +141,7 @@ static bool exists(pn::string_view resource_path) {
 }
 
 static Texture load_hidpi_texture(pn::string_view name) {
+    ANTARES_TRACE("resource", "texture", name);
     int scale = sys.video->scale();
     while (scale) {
         pn::string path;
@@ -162,6 +166,7 @@ static Texture load_hidpi_texture(pn::string_view name) {
 }
 
 static SoundData load_audio(pn::string_view name) {
+    ANTARES_TRACE("resource", "audio", name);
     static const struct {
         const char ext[6];
         SoundData (*fn)(pn::data_view);
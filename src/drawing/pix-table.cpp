@@ -27,6 +27,7 @@
 #include "data/sprite-data.hpp"
 #include "drawing/color.hpp"
 #include "game/sys.hpp"
+#include "lang/trace.hpp"
 #include "video/driver.hpp"
 
 using sfz::range;
@@ -36,7 +37,8 @@ using std::vector;
 
 namespace antares {
 
-NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
+NatePixTable::NatePixTable(pn::string_view name, Hue hue) : _name(name.copy()) {
+    ANTARES_TRACE("load", "NatePixTable", name);
     SpriteData  data    = Resource::sprite_data(name);
     ArrayPixMap image   = Resource::sprite_image(name);
     ArrayPixMap overlay = Resource::sprite_overlay(name);
@@ -49,11 +51,14 @@ NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
         Rect      sprite{frame.left, frame.top, frame.right, frame.bottom};
         Rect      bounds = sprite;
         bounds.offset(-frame.cx, -frame.cy);
-        if (hue == Hue::GRAY) {
-            _frames.emplace_back(bounds, image.view(sprite), name, i);
-        } else {
-            _frames.emplace_back(bounds, image.view(sprite), name, i, overlay.view(sprite), hue);
-        }
+        _frames.emplace_back(bounds, image.view(sprite), overlay.view(sprite), name, i, hue);
+    }
+}
+
+NatePixTable::NatePixTable(const NatePixTable& other, Hue hue) : _name(other._name.copy()) {
+    ANTARES_TRACE("load", "NatePixTable", _name);
+    for (const Frame& frame : other._frames) {
+        _frames.emplace_back(frame, _name, _frames.size(), hue);
     }
 }
 
@@ -64,50 +69,71 @@ const NatePixTable::Frame& NatePixTable::at(size_t index) const { return _frames
 size_t NatePixTable::size() const { return _size; }
 
 NatePixTable::Frame::Frame(
-        Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
+        Rect bounds, const PixMap& image, const PixMap& overlay, pn::string_view name, int frame,
         Hue hue)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    load_overlay(overlay, hue);
-    build(name, frame);
+        : _bounds(bounds), _hue(hue) {
+    std::shared_ptr<ArrayPixMap> image_copy(new ArrayPixMap(bounds.width(), bounds.height()));
+    std::shared_ptr<ArrayPixMap> overlay_copy(new ArrayPixMap(bounds.width(), bounds.height()));
+    image_copy->copy(image);
+    overlay_copy->copy(overlay);
+    _image   = image_copy;
+    _overlay = overlay_copy;
+    build(name, frame, nullptr);
 }
 
-NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    build(name, frame);
+NatePixTable::Frame::Frame(const Frame& other, pn::string_view name, int frame, Hue hue)
+        : _bounds(other._bounds), _hue(hue), _image(other._image), _overlay(other._overlay) {
+    build(name, frame, &other);
 }
 
 NatePixTable::Frame::~Frame() {}
 
-void NatePixTable::Frame::load_image(const PixMap& pix) { _pix_map.copy(pix); }
+uint16_t       NatePixTable::Frame::width() const { return _bounds.width(); }
+uint16_t       NatePixTable::Frame::height() const { return _bounds.height(); }
+Point          NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
+const Texture& NatePixTable::Frame::texture() const { return _texture; }
 
-void NatePixTable::Frame::load_overlay(const PixMap& pix, Hue hue) {
+ArrayPixMap NatePixTable::Frame::pix_map() const {
+    ArrayPixMap result(width(), height());
+    result.copy(*_image);
+    if (_hue == Hue::GRAY) {
+        return result;
+    }
     for (auto x : range(width())) {
         for (auto y : range(height())) {
-            RgbColor over  = pix.get(x, y);
+            RgbColor over  = _overlay->get(x, y);
             uint8_t  value = over.red;
             uint8_t  frac  = over.alpha;
-            over           = RgbColor::tint(hue, value);
-            RgbColor under = _pix_map.get(x, y);
+            over           = RgbColor::tint(_hue, value);
+            RgbColor under = result.get(x, y);
             RgbColor composite;
             composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
             composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
             composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
             composite.alpha = under.alpha;
-            _pix_map.set(x, y, composite);
+            result.set(x, y, composite);
         }
     }
+    return result;
 }
 
-uint16_t       NatePixTable::Frame::width() const { return _bounds.width(); }
-uint16_t       NatePixTable::Frame::height() const { return _bounds.height(); }
-Point          NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
-const PixMap&  NatePixTable::Frame::pix_map() const { return _pix_map; }
-const Texture& NatePixTable::Frame::texture() const { return _texture; }
-
-void NatePixTable::Frame::build(pn::string_view name, int frame) {
-    _texture = sys.video->texture(pn::format("/sprites/{0}%{1}", name, frame), _pix_map, 1);
+// Gray sprites don't show their overlays at all. Other hues share one upload of the image and its
+// overlay, which the video driver tints as it draws, unless it can't.
+void NatePixTable::Frame::build(pn::string_view name, int frame, const Frame* other) {
+    pn::string texture_name = pn::format("/sprites/{0}%{1}", name, frame);
+    if (_hue == Hue::GRAY) {
+        _texture = sys.video->sprite_texture(texture_name, *_image);
+        return;
+    } else if (other) {
+        _texture = other->_texture.tinted(_hue);
+        if (_texture) {
+            return;
+        }
+    }
+    _texture = sys.video->sprite_texture(texture_name, *_image, *_overlay).tinted(_hue);
+    if (!_texture) {
+        _texture = sys.video->sprite_texture(texture_name, pix_map());
+    }
 }
 
 }  // namespace antares
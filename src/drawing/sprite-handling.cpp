@@ -27,6 +27,7 @@
 #include "drawing/shapes.hpp"
 #include "drawing/text.hpp"
 #include "game/globals.hpp"
+#include "game/render-frame.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 #include "math/random.hpp"
@@ -71,7 +72,7 @@ static draw_tiny_t draw_tiny_function(BaseObject::Icon::Shape shape, int size) {
 Scale ANTARES_GLOBAL gAbsoluteScale = MIN_SCALE;
 
 void SpriteHandlingInit() {
-    g.sprites.reset(new Sprite[Sprite::size]);
+    g.sprites.reset(Sprite::size);
     ResetAllSprites();
 
     for (int i = 0; i < 4000; ++i) {
@@ -79,12 +80,9 @@ void SpriteHandlingInit() {
     }
 }
 
-Sprite* Sprite::get(int number) {
-    if ((0 <= number) && (number < size)) {
-        return &g.sprites[number];
-    }
-    return nullptr;
-}
+Sprite* Sprite::get(int number) { return g.sprites.get(number); }
+
+HandleList<Sprite> Sprite::all() { return HandleList<Sprite>(0, g.sprites.size()); }
 
 Sprite::Sprite()
         : table(NULL),
@@ -93,7 +91,8 @@ Sprite::Sprite()
           styleData(0),
           whichLayer(BaseObject::Layer::NONE),
           killMe(false),
-          draw_tiny(NULL) {}
+          draw_tiny(NULL),
+          generation(0) {}
 
 void ResetAllSprites() {
     for (auto sprite : Sprite::all()) {
@@ -112,44 +111,66 @@ NatePixTable* Pix::add(pn::string_view name, Hue hue) {
         return result;
     }
 
-    auto it = _pix.emplace(std::make_pair(name.copy(), hue), NatePixTable(name, hue)).first;
-    return &it->second;
+    // Another hue of the same sprite has its images loaded already, and maybe tintable textures.
+    const NatePixTable* other = nullptr;
+    for (auto it = _pix.lower_bound({name, Hue::GRAY}); it != _pix.end(); ++it) {
+        if (it->first.first != name) {
+            break;
+        } else if (!other || (it->first.second != Hue::GRAY)) {
+            other = &it->second->table;
+        }
+    }
+
+    std::unique_ptr<Entry> entry(
+            other ? new Entry{name.copy(), NatePixTable(*other, hue)}
+                  : new Entry{name.copy(), NatePixTable(name, hue)});
+    pn::string_view        key = entry->name;
+    auto                   it  = _pix.emplace(std::make_pair(key, hue), std::move(entry)).first;
+    return &it->second->table;
 }
 
 NatePixTable* Pix::get(pn::string_view id, Hue hue) {
-    auto it = _pix.find({id.copy(), hue});
+    auto it = _pix.find({id, hue});
     if (it != _pix.end()) {
-        return &it->second;
+        return &it->second->table;
     }
     return nullptr;
 }
 
 const NatePixTable* Pix::cursor() { return _cursor.get(); }
 
-Handle<Sprite> AddSprite(
-        Point where, NatePixTable* table, pn::string_view name, Hue hue, int16_t whichShape,
-        Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
-        uint8_t tiny_shade) {
+static Handle<Sprite> next_free_sprite() {
     for (Handle<Sprite> sprite : Sprite::all()) {
         if (sprite->table == NULL) {
-            sprite->where      = where;
-            sprite->table      = table;
-            sprite->whichShape = whichShape;
-            sprite->scale      = scale;
-            sprite->whichLayer = layer;
-            sprite->icon = icon.value_or(BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 0});
-            sprite->tinyColor  = {tiny_hue, tiny_shade};
-            sprite->draw_tiny  = draw_tiny_function(sprite->icon.shape, sprite->icon.size);
-            sprite->killMe     = false;
-            sprite->style      = spriteNormal;
-            sprite->styleColor = RgbColor::white();
-            sprite->styleData  = 0;
-
             return sprite;
         }
     }
+    Handle<Sprite> sprite(g.sprites.size());
+    g.sprites.grow(g.sprites.size() + 1);
+    return sprite;
+}
 
-    return Sprite::none();
+Handle<Sprite> AddSprite(
+        Point where, NatePixTable* table, pn::string_view name, Hue hue, int16_t whichShape,
+        Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
+        uint8_t tiny_shade) {
+    auto sprite = next_free_sprite();
+
+    sprite->where      = where;
+    sprite->table      = table;
+    sprite->whichShape = whichShape;
+    sprite->scale      = scale;
+    sprite->whichLayer = layer;
+    sprite->icon       = icon.value_or(BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 0});
+    sprite->tinyColor  = {tiny_hue, tiny_shade};
+    sprite->draw_tiny  = draw_tiny_function(sprite->icon.shape, sprite->icon.size);
+    sprite->killMe     = false;
+    sprite->style      = spriteNormal;
+    sprite->styleColor = RgbColor::white();
+    sprite->styleData  = 0;
+    ++sprite->generation;
+
+    return sprite;
 }
 
 void RemoveSprite(Handle<Sprite> sprite) {
@@ -165,25 +186,46 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scal
     };
 }
 
-void draw_sprites() {
-    if (gAbsoluteScale >= kBlipThreshhold) {
+void capture_sprites(RenderFrame* frame) {
+    frame->sprites.clear();
+    for (auto aSprite : Sprite::all()) {
+        if ((aSprite->table == NULL) || aSprite->killMe) {
+            continue;
+        }
+        const auto&             tiny = aSprite->tinyColor;
+        RenderFrame::SpriteView view;
+        view.number      = aSprite.number();
+        view.generation  = aSprite->generation;
+        view.where       = aSprite->where;
+        view.frame       = &aSprite->table->at(aSprite->whichShape);
+        view.scale       = aSprite->scale;
+        view.style       = aSprite->style;
+        view.style_color = aSprite->styleColor;
+        view.style_data  = aSprite->styleData;
+        view.layer       = aSprite->whichLayer;
+        view.tiny_size   = aSprite->icon.size;
+        view.tiny_color  = GetRGBTranslateColorShade(tiny.hue, tiny.shade);
+        view.draw_tiny   = aSprite->draw_tiny;
+        frame->sprites.push_back(view);
+    }
+}
+
+void draw_sprites(const RenderFrame& frame) {
+    if (frame.scale >= kBlipThreshhold) {
         for (BaseObject::Layer layer :
              {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                if ((aSprite->table != NULL) && !aSprite->killMe &&
-                    (aSprite->whichLayer == layer)) {
-                    Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
-
-                    Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
+            for (const RenderFrame::SpriteView& aSprite : frame.sprites) {
+                if (aSprite.layer == layer) {
+                    Scale trueScale = scale_by(aSprite.scale, frame.scale);
+                    Rect  draw_rect = scale_sprite_rect(*aSprite.frame, aSprite.where, trueScale);
 
-                    switch (aSprite->style) {
-                        case spriteNormal: frame.texture().draw(draw_rect); break;
+                    switch (aSprite.style) {
+                        case spriteNormal: aSprite.frame->texture().draw(draw_rect); break;
 
                         case spriteColor:
                             Randomize(63);
-                            frame.texture().draw_static(
-                                    draw_rect, aSprite->styleColor, aSprite->styleData);
+                            aSprite.frame->texture().draw_static(
+                                    draw_rect, aSprite.style_color, aSprite.style_data);
                             break;
                     }
                 }
@@ -192,15 +234,12 @@ void draw_sprites() {
     } else {
         for (BaseObject::Layer layer :
              {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                int tinySize = aSprite->icon.size;
-                if ((aSprite->table != NULL) && !aSprite->killMe && tinySize &&
-                    (aSprite->draw_tiny != NULL) && (aSprite->whichLayer == layer)) {
+            for (const RenderFrame::SpriteView& aSprite : frame.sprites) {
+                int tinySize = aSprite.tiny_size;
+                if (tinySize && (aSprite.draw_tiny != NULL) && (aSprite.layer == layer)) {
                     Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
-                    tiny_rect.offset(aSprite->where.h, aSprite->where.v);
-                    aSprite->draw_tiny(
-                            tiny_rect, GetRGBTranslateColorShade(
-                                               aSprite->tinyColor.hue, aSprite->tinyColor.shade));
+                    tiny_rect.offset(aSprite.where.h, aSprite.where.v);
+                    aSprite.draw_tiny(tiny_rect, aSprite.tiny_color);
                 }
             }
         }
@@ -18,8 +18,11 @@
 
 #include "game/action.hpp"
 
+#include <algorithm>
+#include <map>
 #include <set>
 #include <sfz/sfz.hpp>
+#include <unordered_map>
 
 #include "data/base-object.hpp"
 #include "data/plugin.hpp"
@@ -37,6 +40,8 @@
 #include "game/motion.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
@@ -55,57 +60,138 @@ using std::unique_ptr;
 
 namespace antares {
 
-const size_t kActionQueueLength = 120;
+// A cursor keeps the frames of groups nested up to this deep inline, so that copying it into and
+// out of the action queue doesn't allocate. Deeper groups are rare, and spill onto the heap.
+static const int kInlineGroupDepth = 16;
+
+typedef void (*ApplyFunction)(
+        const Action& a, Handle<SpaceObject> subject, Handle<SpaceObject> direct, Point offset);
+
+// One step of a compiled action list.
+//
+// APPLY, DELAY, and ENTER each come from an action, and run its overrides and filters before
+// doing anything. ENTER starts a group, whose actions are inlined after it, up to the matching
+// LEAVE; if the group is filtered out, execution skips past the LEAVE instead.
+struct ActionOp {
+    enum class Code : uint8_t { APPLY, DELAY, ENTER, LEAVE };
+
+    Code             code          = Code::LEAVE;
+    bool             reflexive     = false;
+    Owner            owner         = Owner::ANY;
+    bool             filtered      = false;    // Filtered by attributes or tags.
+    uint32_t         attributes    = 0;        // Attributes the direct object must have.
+    bool             tags_resolved = false;    // If false, falls back to tags_match().
+    uint64_t         tag_mask      = 0;        // Bits of the tags the filter checks,
+    uint64_t         tag_values    = 0;        // and which of them must be set.
+    const ObjectRef* subject       = nullptr;  // Override, if any.
+    const ObjectRef* direct        = nullptr;  // Override, if any.
+    const Action*    action        = nullptr;
+    ApplyFunction    apply         = nullptr;  // For APPLY.
+    int32_t          skip          = 0;        // For ENTER: index of the op after its LEAVE.
+};
+
+struct ActionProgram {
+    std::vector<ActionOp> ops;
+};
 
 struct ActionCursor {
-    const Action* begin = nullptr;
-    const Action* end   = nullptr;
+    struct Frame {
+        Handle<SpaceObject> subject;
+        Handle<SpaceObject> direct;
+    };
+
+    const ActionProgram* program = nullptr;
+    int32_t              pc      = 0;
 
     Handle<SpaceObject> subject;
-    int32_t             subject_id;
     Handle<SpaceObject> direct;
-    int32_t             direct_id;
 
     Point offset;
 
-    std::unique_ptr<ActionCursor> continuation;
+    // Subject and direct object of the groups that enclose `pc`, outermost first. The first
+    // kInlineGroupDepth are in `frames`, and any past that in `deep_frames`.
+    int32_t            depth = 0;
+    Frame              frames[kInlineGroupDepth];
+    std::vector<Frame> deep_frames;
 
     ActionCursor() = default;
     ActionCursor(
-            const std::vector<Action>& actions, Handle<SpaceObject> subject,
-            Handle<SpaceObject> direct, Point offset)
-            : begin{actions.data()},
-              end{actions.data() + actions.size()},
-              subject{subject},
-              subject_id{subject.get() ? subject->id : -1},
-              direct{direct},
-              direct_id{direct.get() ? direct->id : -1},
-              offset{offset} {}
-    ActionCursor(
-            const std::vector<Action>& actions, Handle<SpaceObject> subject,
-            Handle<SpaceObject> direct, Point offset, ActionCursor continuation)
-            : begin{actions.data()},
-              end{actions.data() + actions.size()},
-              subject{subject},
-              subject_id{subject.get() ? subject->id : -1},
-              direct{direct},
-              direct_id{direct.get() ? direct->id : -1},
-              offset{offset},
-              continuation{new ActionCursor{std::move(continuation)}} {}
-};
+            const ActionProgram& program, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
+            Point offset)
+            : program{&program}, subject{subject}, direct{direct}, offset{offset} {}
+
+    void push(const Frame& frame) {
+        if (depth < kInlineGroupDepth) {
+            frames[depth] = frame;
+        } else {
+            deep_frames.push_back(frame);
+        }
+        ++depth;
+    }
+
+    Frame pop() {
+        --depth;
+        if (depth < kInlineGroupDepth) {
+            return frames[depth];
+        }
+        Frame frame = deep_frames.back();
+        deep_frames.pop_back();
+        return frame;
+    }
 
-struct actionQueueType {
-    ActionCursor     cursor;
-    ticks            scheduledTime;
-    actionQueueType* nextActionQueue;
+    void snapshot(SnapshotArchive& a) {
+        a.value(program);
+        a.value(pc);
+        a.value(subject);
+        a.value(direct);
+        a.value(offset);
+        a.value(depth);
+        a.array(frames, kInlineGroupDepth);
+        a.vector(deep_frames);
+    }
+};
 
-    bool empty() const { return cursor.begin == cursor.end; }
+struct ActionQueue::Entry {
+    ActionCursor cursor;
+    ticks        due;  // In terms of ActionQueue::clock.
+    int64_t      id;   // Position in the order actions were queued.
 };
 
 ActionQueue::ActionQueue()  = default;
 ActionQueue::~ActionQueue() = default;
 
-static void queue_action(ActionCursor cursor, ticks delayTime);
+// Each entry's cursor is archived by ActionCursor::snapshot(). Entries are reused rather than
+// reallocated: a cursor's handles, inline frames and pointer to its program (which lives until the
+// end of the level) are plain values, and only groups nested past kInlineGroupDepth, in
+// `deep_frames`, are stored on the heap.
+void ActionQueue::snapshot(SnapshotArchive& a) {
+    a.value(clock);
+    a.value(queued);
+    a.value(peak);
+    size_t count = pending.size();
+    a.value(count);
+    while (pending.size() > count) {
+        spare.push_back(std::move(pending.back()));
+        pending.pop_back();
+    }
+    while (pending.size() < count) {
+        if (spare.empty()) {
+            pending.emplace_back(new Entry);
+        } else {
+            pending.push_back(std::move(spare.back()));
+            spare.pop_back();
+        }
+    }
+    for (auto& entry : pending) {
+        entry->cursor.snapshot(a);
+        a.value(entry->due);
+        a.value(entry->id);
+    }
+}
+
+ANTARES_GLOBAL ActionStats action_stats;
+
+static void queue_action(const ActionCursor& cursor, ticks delayTime);
 
 bool action_filter_applies_to(const Action& action, Handle<SpaceObject> target) {
     if (!tags_match(*target->base, action.base.filter.tags)) {
@@ -194,16 +280,13 @@ static void apply(
             } else {
                 product->timeFromOrigin = kTimeToCheckHome;
                 product->runTimeFlags &= ~kHasArrived;
-                product->destObject       = direct;  // a->destinationObject;
-                product->destObjectDest   = direct->destObject;
-                product->destObjectID     = direct->id;
-                product->destObjectDestID = direct->destObjectID;
+                product->destObject     = direct;  // a->destinationObject;
+                product->destObjectDest = direct->destObject;
             }
             product->attributes = save_attributes;
         }
-        product->targetObject   = direct->targetObject;
-        product->targetObjectID = direct->targetObjectID;
-        product->closestObject  = product->targetObject;
+        product->targetObject  = direct->targetObject;
+        product->closestObject = product->targetObject;
 
         //  ugly though it is, we have to fill in the rest of
         //  a new beam's fields after it's created.
@@ -278,9 +361,8 @@ static void apply(
 static void apply(
         const HoldAction& a, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
         Point offset) {
-    direct->targetObject   = SpaceObject::none();
-    direct->targetObjectID = kNoShip;
-    direct->lastTarget     = SpaceObject::none();
+    direct->targetObject = SpaceObject::none();
+    direct->lastTarget   = SpaceObject::none();
 }
 
 static void apply(
@@ -720,108 +802,233 @@ static void apply(
 static void apply(
         const AssumeAction& a, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
         Point offset) {
-    int index            = a.which + GetAdmiralScore({Handle<Admiral>{0}, 0});
-    g.initials[index]    = direct;
-    g.initial_ids[index] = direct->id;
+    int index         = a.which + GetAdmiralScore({Handle<Admiral>{0}, 0});
+    g.initials[index] = direct;
+}
+
+template <typename T, T Action::*member>
+static void apply_as(
+        const Action& a, Handle<SpaceObject> subject, Handle<SpaceObject> direct, Point offset) {
+    apply(a.*member, subject, direct, offset);
 }
 
-static ActionCursor apply(
-        const Action& a, Handle<SpaceObject> subject, Handle<SpaceObject> direct, Point offset,
-        ActionCursor next) {
-    switch (a.type()) {
+// Returns the function that applies an action of type `type`. Delays and groups aren't applied
+// like the rest; they become their own ops.
+static ApplyFunction apply_function(Action::Type type) {
+    switch (type) {
         case Action::Type::DELAY:
-            queue_action(std::move(next), a.delay.duration);
-            return ActionCursor{};
-
-        case Action::Type::GROUP:
-            return ActionCursor{a.group.of, subject, direct, offset, std::move(next)};
-
-        case Action::Type::AGE: apply(a.age, subject, direct, offset); break;
-        case Action::Type::ASSUME: apply(a.assume, subject, direct, offset); break;
-        case Action::Type::CAPTURE: apply(a.capture, subject, direct, offset); break;
-        case Action::Type::CAP_SPEED: apply(a.cap_speed, subject, direct, offset); break;
-        case Action::Type::CHECK: apply(a.check, subject, direct, offset); break;
-        case Action::Type::CLOAK: apply(a.cloak, subject, direct, offset); break;
-        case Action::Type::CONDITION: apply(a.condition, subject, direct, offset); break;
-        case Action::Type::CREATE: apply(a.create, subject, direct, offset); break;
-        case Action::Type::DESTROY: apply(a.destroy, subject, direct, offset); break;
-        case Action::Type::DISABLE: apply(a.disable, subject, direct, offset); break;
-        case Action::Type::ENERGIZE: apply(a.energize, subject, direct, offset); break;
-        case Action::Type::EQUIP: apply(a.equip, subject, direct, offset); break;
-        case Action::Type::FIRE: apply(a.fire, subject, direct, offset); break;
-        case Action::Type::FLASH: apply(a.flash, subject, direct, offset); break;
-        case Action::Type::HEAL: apply(a.heal, subject, direct, offset); break;
-        case Action::Type::HOLD: apply(a.hold, subject, direct, offset); break;
-        case Action::Type::KEY: apply(a.key, subject, direct, offset); break;
-        case Action::Type::LAND: apply(a.land, subject, direct, offset); break;
-        case Action::Type::MESSAGE: apply(a.message, subject, direct, offset); break;
-        case Action::Type::MORPH: apply(a.morph, subject, direct, offset); break;
-        case Action::Type::MOVE: apply(a.move, subject, direct, offset); break;
-        case Action::Type::OCCUPY: apply(a.occupy, subject, direct, offset); break;
-        case Action::Type::PAY: apply(a.pay, subject, direct, offset); break;
-        case Action::Type::PLAY: apply(a.play, subject, direct, offset); break;
-        case Action::Type::PUSH: apply(a.push, subject, direct, offset); break;
-        case Action::Type::REMOVE: apply(a.remove, subject, direct, offset); break;
-        case Action::Type::REVEAL: apply(a.reveal, subject, direct, offset); break;
-        case Action::Type::SCORE: apply(a.score, subject, direct, offset); break;
-        case Action::Type::SELECT: apply(a.select, subject, direct, offset); break;
-        case Action::Type::SLOW: apply(a.slow, subject, direct, offset); break;
-        case Action::Type::SPEED: apply(a.speed, subject, direct, offset); break;
-        case Action::Type::STOP: apply(a.stop, subject, direct, offset); break;
-        case Action::Type::SPARK: apply(a.spark, subject, direct, offset); break;
-        case Action::Type::SPIN: apply(a.spin, subject, direct, offset); break;
-        case Action::Type::TARGET: apply(a.target, subject, direct, offset); break;
-        case Action::Type::THRUST: apply(a.thrust, subject, direct, offset); break;
-        case Action::Type::WARP: apply(a.warp, subject, direct, offset); break;
-        case Action::Type::WIN: apply(a.win, subject, direct, offset); break;
-        case Action::Type::ZOOM: apply(a.zoom, subject, direct, offset); break;
-    }
-
-    return next;
+        case Action::Type::GROUP: return nullptr;
+
+        case Action::Type::AGE: return apply_as<AgeAction, &Action::age>;
+        case Action::Type::ASSUME: return apply_as<AssumeAction, &Action::assume>;
+        case Action::Type::CAPTURE: return apply_as<CaptureAction, &Action::capture>;
+        case Action::Type::CAP_SPEED: return apply_as<CapSpeedAction, &Action::cap_speed>;
+        case Action::Type::CHECK: return apply_as<CheckAction, &Action::check>;
+        case Action::Type::CLOAK: return apply_as<CloakAction, &Action::cloak>;
+        case Action::Type::CONDITION: return apply_as<ConditionAction, &Action::condition>;
+        case Action::Type::CREATE: return apply_as<CreateAction, &Action::create>;
+        case Action::Type::DESTROY: return apply_as<DestroyAction, &Action::destroy>;
+        case Action::Type::DISABLE: return apply_as<DisableAction, &Action::disable>;
+        case Action::Type::ENERGIZE: return apply_as<EnergizeAction, &Action::energize>;
+        case Action::Type::EQUIP: return apply_as<EquipAction, &Action::equip>;
+        case Action::Type::FIRE: return apply_as<FireAction, &Action::fire>;
+        case Action::Type::FLASH: return apply_as<FlashAction, &Action::flash>;
+        case Action::Type::HEAL: return apply_as<HealAction, &Action::heal>;
+        case Action::Type::HOLD: return apply_as<HoldAction, &Action::hold>;
+        case Action::Type::KEY: return apply_as<KeyAction, &Action::key>;
+        case Action::Type::LAND: return apply_as<LandAction, &Action::land>;
+        case Action::Type::MESSAGE: return apply_as<MessageAction, &Action::message>;
+        case Action::Type::MORPH: return apply_as<MorphAction, &Action::morph>;
+        case Action::Type::MOVE: return apply_as<MoveAction, &Action::move>;
+        case Action::Type::OCCUPY: return apply_as<OccupyAction, &Action::occupy>;
+        case Action::Type::PAY: return apply_as<PayAction, &Action::pay>;
+        case Action::Type::PLAY: return apply_as<PlayAction, &Action::play>;
+        case Action::Type::PUSH: return apply_as<PushAction, &Action::push>;
+        case Action::Type::REMOVE: return apply_as<RemoveAction, &Action::remove>;
+        case Action::Type::REVEAL: return apply_as<RevealAction, &Action::reveal>;
+        case Action::Type::SCORE: return apply_as<ScoreAction, &Action::score>;
+        case Action::Type::SELECT: return apply_as<SelectAction, &Action::select>;
+        case Action::Type::SLOW: return apply_as<SlowAction, &Action::slow>;
+        case Action::Type::SPEED: return apply_as<SpeedAction, &Action::speed>;
+        case Action::Type::STOP: return apply_as<StopAction, &Action::stop>;
+        case Action::Type::SPARK: return apply_as<SparkAction, &Action::spark>;
+        case Action::Type::SPIN: return apply_as<SpinAction, &Action::spin>;
+        case Action::Type::TARGET: return apply_as<TargetAction, &Action::target>;
+        case Action::Type::THRUST: return apply_as<ThrustAction, &Action::thrust>;
+        case Action::Type::WARP: return apply_as<WarpAction, &Action::warp>;
+        case Action::Type::WIN: return apply_as<WinAction, &Action::win>;
+        case Action::Type::ZOOM: return apply_as<ZoomAction, &Action::zoom>;
+    }
 }
 
-static void execute_actions(ActionCursor cursor) {
-    while (true) {
-        while (cursor.begin != cursor.end) {
-            const Action& action = *(cursor.begin++);
-
-            auto subject = cursor.subject;
-            auto direct  = cursor.direct;
-            if (action.base.override_.subject.has_value()) {
-                subject = resolve_object_ref(*action.base.override_.subject);
-            }
-            if (action.base.override_.direct.has_value()) {
-                direct = resolve_object_ref(*action.base.override_.direct);
-            }
+// Tags that filters check, each numbered by its bit in a tag mask. There are rarely more than a
+// handful; if a level somehow uses more than 64, filters on the rest fall back to tags_match().
+static ANTARES_GLOBAL std::map<pn::string, int> filter_tags;
+
+// Tag mask of each base object that's been filtered since the last tag was numbered.
+static ANTARES_GLOBAL std::unordered_map<const BaseObject*, uint64_t> object_tags;
 
-            if (!direct.get()) {
-                direct = subject;
+// Compiled action lists, by the list they were compiled from. These and the tag numbering are
+// cleared at the start of each level, before the lists from the previous one are freed.
+static ANTARES_GLOBAL std::unordered_map<const std::vector<Action>*, unique_ptr<ActionProgram>>
+        programs;
+
+static bool resolve_tags(const Tags& tags, uint64_t* mask, uint64_t* values) {
+    for (const auto& kv : tags.tags) {
+        auto it = filter_tags.find(kv.first);
+        if (it == filter_tags.end()) {
+            if (filter_tags.size() == 64) {
+                return false;
             }
+            it = filter_tags.emplace(kv.first.copy(), filter_tags.size()).first;
+            object_tags.clear();
+        }
+        uint64_t bit = uint64_t{1} << it->second;
+        *mask |= bit;
+        if (kv.second) {
+            *values |= bit;
+        }
+    }
+    return true;
+}
 
-            auto owner_filter = action.base.filter.owner.value_or(Owner::ANY);
-            if (direct.get() && subject.get()) {
-                if (((owner_filter == Owner::DIFFERENT) && (direct->owner == subject->owner)) ||
-                    ((owner_filter == Owner::SAME) && (direct->owner != subject->owner))) {
-                    continue;
-                }
+static uint64_t tag_bits(const BaseObject& o) {
+    auto it = object_tags.find(&o);
+    if (it != object_tags.end()) {
+        return it->second;
+    }
+    uint64_t bits = 0;
+    for (const auto& kv : filter_tags) {
+        auto tag = o.tags.tags.find(kv.first);
+        if ((tag != o.tags.tags.end()) && tag->second) {
+            bits |= uint64_t{1} << kv.second;
+        }
+    }
+    object_tags[&o] = bits;
+    return bits;
+}
+
+static bool filter_applies(const ActionOp& op, Handle<SpaceObject> target) {
+    if (op.tags_resolved) {
+        if ((tag_bits(*target->base) & op.tag_mask) != op.tag_values) {
+            return false;
+        }
+    } else if (!tags_match(*target->base, op.action->base.filter.tags)) {
+        return false;
+    }
+    return !(op.attributes & ~target->attributes);
+}
+
+static void compile(const std::vector<Action>& actions, ActionProgram* program) {
+    for (const Action& a : actions) {
+        ActionOp op;
+        op.action        = &a;
+        op.reflexive     = a.base.reflexive.value_or(false);
+        op.owner         = a.base.filter.owner.value_or(Owner::ANY);
+        op.attributes    = a.base.filter.attributes.bits;
+        op.filtered      = op.attributes || !a.base.filter.tags.tags.empty();
+        op.tags_resolved = resolve_tags(a.base.filter.tags, &op.tag_mask, &op.tag_values);
+        if (a.base.override_.subject.has_value()) {
+            op.subject = &*a.base.override_.subject;
+        }
+        if (a.base.override_.direct.has_value()) {
+            op.direct = &*a.base.override_.direct;
+        }
+
+        switch (a.type()) {
+            case Action::Type::DELAY:
+                op.code = ActionOp::Code::DELAY;
+                program->ops.push_back(op);
+                break;
+
+            case Action::Type::GROUP: {
+                size_t enter = program->ops.size();
+                op.code      = ActionOp::Code::ENTER;
+                program->ops.push_back(op);
+                compile(a.group.of, program);
+                program->ops.push_back(ActionOp{});
+                program->ops[enter].skip = program->ops.size();
+                break;
             }
 
-            if ((action.base.filter.attributes.bits || !action.base.filter.tags.tags.empty()) &&
-                (!direct.get() || !action_filter_applies_to(action, direct))) {
+            default:
+                op.code  = ActionOp::Code::APPLY;
+                op.apply = apply_function(a.type());
+                program->ops.push_back(op);
+                break;
+        }
+    }
+}
+
+static const ActionProgram& program_for(const std::vector<Action>& actions) {
+    unique_ptr<ActionProgram>& program = programs[&actions];
+    if (!program) {
+        program.reset(new ActionProgram);
+        compile(actions, program.get());
+        ++action_stats.compiled;
+    }
+    return *program;
+}
+
+void compile_actions(const std::vector<Action>& actions) { program_for(actions); }
+
+static void execute_actions(ActionCursor cursor) {
+    const std::vector<ActionOp>& ops = cursor.program->ops;
+    const int32_t                end = ops.size();
+    while (cursor.pc < end) {
+        const ActionOp& op = ops[cursor.pc++];
+        if (op.code == ActionOp::Code::LEAVE) {
+            const ActionCursor::Frame frame = cursor.pop();
+            cursor.subject                  = frame.subject;
+            cursor.direct                   = frame.direct;
+            continue;
+        }
+        ++action_stats.executed;
+
+        auto subject = op.subject ? resolve_object_ref(*op.subject) : cursor.subject;
+        auto direct  = op.direct ? resolve_object_ref(*op.direct) : cursor.direct;
+
+        if (!direct.get()) {
+            direct = subject;
+        }
+
+        if (direct.get() && subject.get()) {
+            if (((op.owner == Owner::DIFFERENT) && (direct->owner == subject->owner)) ||
+                ((op.owner == Owner::SAME) && (direct->owner != subject->owner))) {
+                if (op.code == ActionOp::Code::ENTER) {
+                    cursor.pc = op.skip;
+                }
                 continue;
             }
+        }
 
-            if (action.base.reflexive.value_or(false)) {
-                std::swap(subject, direct);
+        if (op.filtered && (!direct.get() || !filter_applies(op, direct))) {
+            if (op.code == ActionOp::Code::ENTER) {
+                cursor.pc = op.skip;
             }
+            continue;
+        }
 
-            cursor = apply(action, subject, direct, cursor.offset, std::move(cursor));
+        if (op.reflexive) {
+            std::swap(subject, direct);
         }
 
-        if (cursor.continuation) {
-            cursor = std::move(*cursor.continuation);
-        } else {
-            break;
+        switch (op.code) {
+            case ActionOp::Code::APPLY:
+                op.apply(*op.action, subject, direct, cursor.offset);
+                break;
+
+            case ActionOp::Code::DELAY:
+                queue_action(cursor, op.action->delay.duration);
+                return;
+
+            case ActionOp::Code::ENTER:
+                cursor.push({cursor.subject, cursor.direct});
+                cursor.subject = subject;
+                cursor.direct  = direct;
+                break;
+
+            case ActionOp::Code::LEAVE: break;
         }
     }
 }
@@ -829,79 +1036,63 @@ static void execute_actions(ActionCursor cursor) {
 void exec(
         const std::vector<Action>& actions, Handle<SpaceObject> subject,
         Handle<SpaceObject> direct, Point offset) {
-    execute_actions(ActionCursor(actions, subject, direct, offset));
+    execute_actions(ActionCursor(program_for(actions), subject, direct, offset));
 }
 
 void reset_action_queue() {
-    g.action_queue.data.reset(new actionQueueType[kActionQueueLength]);
-
-    g.action_queue.first = NULL;
-
-    actionQueueType* action = g.action_queue.data.get();
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        action->cursor.begin = action->cursor.end = nullptr;
-        ++action;
+    g.action_queue.clock  = ticks(0);
+    g.action_queue.queued = 0;
+    g.action_queue.peak   = 0;
+    while (!g.action_queue.pending.empty()) {
+        g.action_queue.spare.push_back(std::move(g.action_queue.pending.back()));
+        g.action_queue.pending.pop_back();
     }
+    programs.clear();
+    filter_tags.clear();
+    object_tags.clear();
+    action_stats = ActionStats{};
 }
 
-static void queue_action(ActionCursor cursor, ticks delayTime) {
-    int32_t          queueNumber = 0;
-    actionQueueType* actionQueue = g.action_queue.data.get();
-    while (!actionQueue->empty() && (queueNumber < kActionQueueLength)) {
-        actionQueue++;
-        queueNumber++;
-    }
+using QueueEntry = std::unique_ptr<ActionQueue::Entry>;
 
-    if (queueNumber == kActionQueueLength) {
-        return;
-    }
-    actionQueue->cursor        = std::move(cursor);
-    actionQueue->scheduledTime = delayTime;
-
-    actionQueueType* previousQueue = NULL;
-    actionQueueType* nextQueue     = g.action_queue.first;
-    while (nextQueue && (nextQueue->scheduledTime < delayTime)) {
-        previousQueue = nextQueue;
-        nextQueue     = nextQueue->nextActionQueue;
-    }
-    if (previousQueue) {
-        actionQueue->nextActionQueue = previousQueue->nextActionQueue;
+// True if `x` runs after `y`: it's due later, or due at the same time but queued earlier.
+static bool runs_after(const QueueEntry& x, const QueueEntry& y) {
+    return (x->due > y->due) || ((x->due == y->due) && (x->id < y->id));
+}
 
-        previousQueue->nextActionQueue = actionQueue;
+static void queue_action(const ActionCursor& cursor, ticks delayTime) {
+    auto& q = g.action_queue;
+    if (q.spare.empty()) {
+        q.pending.emplace_back(new ActionQueue::Entry);
     } else {
-        actionQueue->nextActionQueue = g.action_queue.first;
-        g.action_queue.first         = actionQueue;
+        q.pending.push_back(std::move(q.spare.back()));
+        q.spare.pop_back();
     }
+    ActionQueue::Entry& entry = *q.pending.back();
+    entry.cursor              = cursor;
+    entry.due                 = q.clock + delayTime;
+    entry.id                  = q.queued++;
+    std::push_heap(q.pending.begin(), q.pending.end(), runs_after);
+    q.peak = std::max(q.peak, q.pending.size());
 }
 
-void execute_action_queue() {
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        auto actionQueue = &g.action_queue.data[i];
-        if (!actionQueue->empty()) {
-            actionQueue->scheduledTime -= kMajorTick;
-        }
-    }
+// A queued action is dropped if its subject or direct object was freed while it waited.
+static bool is_stale(Handle<SpaceObject> o) { return o.get() && o.expired(); }
 
-    while (g.action_queue.first && !g.action_queue.first->empty() &&
-           (g.action_queue.first->scheduledTime <= ticks(0))) {
-        int32_t subjectid = -1;
-        if (g.action_queue.first->cursor.subject.get() &&
-            g.action_queue.first->cursor.subject->active) {
-            subjectid = g.action_queue.first->cursor.subject->id;
-        }
-
-        int32_t directid = -1;
-        if (g.action_queue.first->cursor.direct.get() &&
-            g.action_queue.first->cursor.direct->active) {
-            directid = g.action_queue.first->cursor.direct->id;
-        }
-        if ((subjectid == g.action_queue.first->cursor.subject_id) &&
-            (directid == g.action_queue.first->cursor.direct_id)) {
-            execute_actions(std::move(g.action_queue.first->cursor));
+void execute_action_queue() {
+    PhaseTimer timer(TickPhase::ACTIONS);
+    auto& q = g.action_queue;
+    q.clock += kMajorTick;
+    while (!q.pending.empty() && (q.pending.front()->due <= q.clock)) {
+        std::pop_heap(q.pending.begin(), q.pending.end(), runs_after);
+        q.spare.push_back(std::move(q.pending.back()));
+        q.pending.pop_back();
+
+        // Moved out of the entry, since running it may queue more actions and reuse it.
+        ActionCursor cursor = std::move(q.spare.back()->cursor);
+        if (!is_stale(cursor.subject) && !is_stale(cursor.direct)) {
+            execute_actions(cursor);
         }
-
-        g.action_queue.first->cursor.begin = g.action_queue.first->cursor.end = nullptr;
-        g.action_queue.first = g.action_queue.first->nextActionQueue;
     }
 }
 
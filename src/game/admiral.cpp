@@ -22,7 +22,10 @@
 #include "data/races.hpp"
 #include "data/resource.hpp"
 #include "game/cheat.hpp"
+#include "game/condition.hpp"
 #include "game/globals.hpp"
+#include "game/profile.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/casts.hpp"
@@ -70,6 +73,7 @@ static bool could_target(const Admiral& a, const BaseObject& base, const SpaceOb
 
 void Admiral::init() {
     g.admirals.reset(new Admiral[kMaxPlayerNum]);
+    g.condition_inputs.admirals.assign(kMaxPlayerNum, 0);
     reset();
     g.destinations.reset(new Destination[kMaxDestObject]);
     ResetAllDestObjectData();
@@ -111,6 +115,49 @@ Admiral* Admiral::get(int i) {
     return nullptr;
 }
 
+int32_t Admiral::number() const { return this - g.admirals.get(); }
+
+void Admiral::snapshot(SnapshotArchive& a) {
+    a.value(_attributes);
+    a.value(_has_destination);
+    a.value(_destinationObject);
+    a.value(_flagship);
+    a.value(_considerShip);
+    a.value(_considerDestination);
+    a.value(_buildAtObject);
+    a.name(_race);
+    a.value(_cash);
+    a.value(_saveGoal);
+    a.value(_earning_power);
+    a.value(_kills);
+    a.value(_losses);
+    a.value(_shipsLeft);
+    a.value(_score);
+    a.value(_blitzkrieg);
+    a.value(_lastFreeEscortStrength);
+    a.value(_thisFreeEscortStrength);
+    a.each(_canBuildType, [](SnapshotArchive& a, admiralBuildType& t) {
+        a.value(t.base);
+        a.string(t.buildable.name);
+        a.value(t.chanceRange);
+    });
+    a.value(_totalBuildChance);
+    bool hope = _hopeToBuild.has_value();
+    a.value(hope);
+    if (!hope) {
+        _hopeToBuild.reset();
+    } else {
+        if (!_hopeToBuild.has_value()) {
+            _hopeToBuild.emplace();
+        }
+        a.string(_hopeToBuild->name);
+    }
+    a.value(_hue);
+    a.value(_active);
+    a.value(_cheats);
+    a.string(_name);
+}
+
 Handle<Admiral> Admiral::make(int index, const DemoLevel::Player& player) {
     return make(index, kAIsComputer, player.name, player.earning_power, player.race, player.hue);
 }
@@ -196,9 +243,8 @@ Handle<Destination> MakeNewDestination(
 void Admiral::remove_destination(Handle<Destination> d) {
     if (_active) {
         if (_destinationObject == d->whichObject) {
-            _destinationObject   = SpaceObject::none();
-            _destinationObjectID = -1;
-            _has_destination     = false;
+            _destinationObject = SpaceObject::none();
+            _has_destination   = false;
         }
         if (_considerDestination == d.number()) {
             _considerDestination = kNoDestinationObject;
@@ -276,17 +322,11 @@ Hue GetAdmiralColor(Handle<Admiral> a) {
 
 void Admiral::set_target(Handle<SpaceObject> obj) {
     _destinationObject = obj;
-    if (obj.get()) {
-        _destinationObjectID = obj->id;
-    } else {
-        _destinationObjectID = -1;
-    }
-    _has_destination = true;
+    _has_destination   = true;
 }
 
 Handle<SpaceObject> Admiral::target() const {
-    if (_destinationObject.get() && (_destinationObject->id == _destinationObjectID) &&
-        (_destinationObject->active == kObjectInUse)) {
+    if (!_destinationObject.expired() && (_destinationObject->active == kObjectInUse)) {
         return _destinationObject;
     }
     return SpaceObject::none();
@@ -295,19 +335,16 @@ Handle<SpaceObject> Admiral::target() const {
 void Admiral::set_control(Handle<SpaceObject> obj) {
     _considerShip = obj;
     if (obj.get()) {
-        _considerShipID = obj->id;
-        auto d          = obj->asDestination;
+        auto d = obj->asDestination;
         if (d.get() && d->can_build()) {
             _buildAtObject = d;
         }
-    } else {
-        _considerShipID = -1;
     }
 }
 
 Handle<SpaceObject> Admiral::control() const {
-    if (_considerShip.get() && (_considerShip->id == _considerShipID) &&
-        (_considerShip->active == kObjectInUse) && (_considerShip->owner.get() == this)) {
+    if (!_considerShip.expired() && (_considerShip->active == kObjectInUse) &&
+        (_considerShip->owner.get() == this)) {
         return _considerShip;
     }
     return SpaceObject::none();
@@ -377,7 +414,6 @@ void SetObjectLocationDestination(Handle<SpaceObject> o, Point* where) {
     if (o->owner.number() <= kNoOwner) {
         o->destObject            = SpaceObject::none();
         o->destObjectDest        = SpaceObject::none();
-        o->destObjectID          = -1;
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin                                   = ticks(0);
         o->idealLocationCalc.h = o->idealLocationCalc.v = Fixed::zero();
@@ -441,7 +477,6 @@ void OverrideObjectDestination(Handle<SpaceObject> o, Handle<SpaceObject> overri
     if (o->owner.number() <= kNoOwner) {
         o->destObject            = SpaceObject::none();
         o->destObjectDest        = SpaceObject::none();
-        o->destObjectID          = -1;
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin                                   = ticks(0);
         o->idealLocationCalc.h = o->idealLocationCalc.v = Fixed::zero();
@@ -469,7 +504,7 @@ void OverrideObjectDestination(Handle<SpaceObject> o, Handle<SpaceObject> overri
 
     // if the admiral is not legal, or the admiral has no destination, then forget about it
     if (!dObject.get() && ((!a->active()) || !a->has_destination() ||
-                           !a->destinationObject().get() || (a->destinationObjectID() == o->id))) {
+                           !a->destinationObject().get() || (a->destinationObject() == o))) {
         o->destObject            = SpaceObject::none();
         o->destObjectDest        = SpaceObject::none();
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
@@ -485,7 +520,8 @@ void OverrideObjectDestination(Handle<SpaceObject> o, Handle<SpaceObject> overri
         }
 
         if ((dObject->active == kObjectInUse) &&
-            ((dObject->id == a->destinationObjectID()) || overrideObject.get())) {
+            (((dObject == a->destinationObject()) && !dObject.expired()) ||
+             overrideObject.get())) {
             if (o->attributes & kCanAcceptDestination) {
                 o->timeFromOrigin = kTimeToCheckHome;
             } else {
@@ -499,10 +535,8 @@ void OverrideObjectDestination(Handle<SpaceObject> o, Handle<SpaceObject> overri
             // add this object to its destination
             if (o != dObject) {
                 o->runTimeFlags &= ~kHasArrived;
-                o->destObject       = dObject;
-                o->destObjectDest   = dObject->destObject;
-                o->destObjectDestID = dObject->destObjectID;
-                o->destObjectID     = dObject->id;
+                o->destObject     = dObject;
+                o->destObjectDest = dObject->destObject;
 
                 if (dObject->owner == o->owner) {
                     dObject->remoteFriendStrength += o->base->ai.escort.power;
@@ -550,7 +584,7 @@ void OverrideObjectDestination(Handle<SpaceObject> o, Handle<SpaceObject> overri
 void RemoveObjectFromDestination(Handle<SpaceObject> o) {
     if (o->destObject.get()) {
         auto dObject = o->destObject;
-        if (dObject->id == o->destObjectID) {
+        if (!dObject.expired()) {
             if (dObject->owner == o->owner) {
                 dObject->remoteFriendStrength -= o->base->ai.escort.power;
                 dObject->escortStrength -= o->base->ai.escort.power;
@@ -562,7 +596,6 @@ void RemoveObjectFromDestination(Handle<SpaceObject> o) {
 
     o->destObject     = SpaceObject::none();
     o->destObjectDest = SpaceObject::none();
-    o->destObjectID   = -1;
 }
 
 // assumes you can afford it & base has time
@@ -583,6 +616,7 @@ static void AdmiralBuildAtObject(
 }
 
 void AdmiralThink() {
+    PhaseTimer timer(TickPhase::ADMIRAL);
     for (auto destBalance : Destination::all()) {
         destBalance->buildTime -= kMajorTick;
         if (destBalance->buildTime <= ticks(0)) {
@@ -624,7 +658,8 @@ void Admiral::think() {
         _blitzkrieg--;
         if (_blitzkrieg <= 0) {
             // Really 48:
-            _blitzkrieg = 0 - (g.random.next(1200) + 1200);
+            auto random = random_source(RandomPurpose::BLITZKRIEG, number());
+            _blitzkrieg = 0 - (random.next(1200) + 1200);
             for (auto anObject : SpaceObject::all()) {
                 if (anObject->owner.get() == this) {
                     anObject->currentTargetValue = Fixed::zero();
@@ -635,7 +670,8 @@ void Admiral::think() {
         _blitzkrieg++;
         if (_blitzkrieg >= 0) {
             // Really 48:
-            _blitzkrieg = g.random.next(1200) + 1200;
+            auto random = random_source(RandomPurpose::BLITZKRIEG, number());
+            _blitzkrieg = random.next(1200) + 1200;
             for (auto anObject : SpaceObject::all()) {
                 if (anObject->owner.get() == this) {
                     anObject->currentTargetValue = Fixed::zero();
@@ -646,29 +682,27 @@ void Admiral::think() {
 
     // get the current object
     if (!_considerShip.get()) {
-        _considerShip = anObject = g.root;
-        _considerShipID          = anObject->id;
+        _considerShip = anObject = SpaceObject::newest();
     } else {
         anObject = _considerShip;
     }
 
     if (!_destinationObject.get()) {
-        _destinationObject = g.root;
+        _destinationObject = SpaceObject::newest();
     }
 
     if (anObject->active != kObjectInUse) {
-        _considerShip = anObject = g.root;
-        _considerShipID          = anObject->id;
+        _considerShip = anObject = SpaceObject::newest();
     }
 
     if (_destinationObject.get()) {
         destObject = _destinationObject;
         if (destObject->active != kObjectInUse) {
-            destObject = _destinationObject = g.root;
+            destObject = _destinationObject = SpaceObject::newest();
         }
         auto origDest = _destinationObject;
         do {
-            _destinationObject = destObject->nextObject;
+            _destinationObject = destObject->older();
 
             // if we've gone through all of the objects
             if (!_destinationObject.get()) {
@@ -682,7 +716,6 @@ void Admiral::think() {
                     if (_destinationObject.get()) {
                         destObject = _destinationObject;
                         if (destObject->active == kObjectInUse) {
-                            _destinationObjectID         = destObject->id;
                             anObject->currentTargetValue = anObject->bestConsideredTargetValue;
                             thisValue = anObject->randomSeed.next(Fixed::from_float(0.5)) -
                                         Fixed::from_float(0.25);
@@ -700,36 +733,32 @@ void Admiral::think() {
 
                 anObject->bestConsideredTargetValue = kFixedNone;
                 // start back with 1st ship
-                _destinationObject = g.root;
-                destObject         = g.root;
+                _destinationObject = SpaceObject::newest();
+                destObject         = SpaceObject::newest();
 
                 // >>> INCREASE CONSIDER SHIP
                 origObject = anObject = _considerShip;
                 if (anObject->active != kObjectInUse) {
-                    anObject        = g.root;
-                    _considerShip   = g.root;
-                    _considerShipID = anObject->id;
+                    anObject      = SpaceObject::newest();
+                    _considerShip = SpaceObject::newest();
                 }
                 do {
-                    _considerShip = anObject->nextObject;
+                    _considerShip = anObject->older();
                     if (!_considerShip.get()) {
-                        _considerShip           = g.root;
-                        anObject                = g.root;
-                        _considerShipID         = anObject->id;
+                        _considerShip           = SpaceObject::newest();
+                        anObject                = SpaceObject::newest();
                         _lastFreeEscortStrength = _thisFreeEscortStrength;
                         _thisFreeEscortStrength = Fixed::zero();
                     } else {
-                        anObject        = anObject->nextObject;
-                        _considerShipID = anObject->id;
+                        anObject = anObject->older();
                     }
                 } while (((anObject->owner.get() != this) ||
                           (!(anObject->attributes & kCanAcceptDestination)) ||
                           (anObject->active != kObjectInUse)) &&
                          (_considerShip != origObject));
             } else {
-                destObject = destObject->nextObject;
+                destObject = destObject->older();
             }
-            _destinationObjectID = destObject->id;
         } while (((!(destObject->attributes & (kCanBeDestination))) ||
                   (_destinationObject == _considerShip) || (destObject->active != kObjectInUse) ||
                   (!(destObject->attributes & kCanBeDestination))) &&
@@ -969,11 +998,12 @@ void Admiral::think_build() {
     }
 
     if (!_hopeToBuild.has_value()) {
-        int k = 0;
+        RandomSource random = random_source(RandomPurpose::BUILD, number());
+        int          k      = 0;
         while (!_hopeToBuild.has_value() && (k < 7)) {
             k++;
             // choose something to build
-            Fixed thisValue   = g.random.next(_totalBuildChance);
+            Fixed thisValue   = random.next(_totalBuildChance);
             Fixed friendValue = kFixedNone;  // equals the highest qualifying object
             for (int j = 0; j < _canBuildType.size(); ++j) {
                 if ((_canBuildType[j].chanceRange <= thisValue) &&
@@ -1043,6 +1073,7 @@ bool Admiral::build(int32_t buildWhichType) {
         auto buildBaseObject = get_buildable_object(dest->canBuildType[buildWhichType], _race);
         if (buildBaseObject && (buildBaseObject->price <= _cash)) {
             _cash.amount -= buildBaseObject->price.amount;
+            mark_conditions_dirty(Handle<Admiral>(number()));
             if (_cheats & kBuildFastBit) {
                 dest->buildTime      = kMinorTick;
                 dest->totalBuildTime = kMinorTick;
@@ -1069,11 +1100,13 @@ void Admiral::pay_absolute(Cash howMuch) {
     if (_cash < Cash{Fixed::zero()}) {
         _cash = Cash{Fixed::zero()};
     }
+    mark_conditions_dirty(Handle<Admiral>(number()));
 }
 
 void AlterAdmiralScore(Counter counter, int32_t amount) {
     if (counter.player.get() && (counter.which >= 0) && (counter.which < kAdmiralScoreNum)) {
         counter.player->score()[counter.which] += amount;
+        mark_conditions_dirty(counter.player);
     }
 }
 
@@ -27,11 +27,44 @@
 #include "game/level.hpp"
 #include "game/messages.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
 #include "game/space-object.hpp"
+#include "lang/defines.hpp"
 #include "math/macros.hpp"
 
 namespace antares {
 
+namespace {
+
+// Something a condition reads. ADMIRAL and OBJECT inputs have counts in g.condition_inputs, which
+// change whenever what's counted does; REF inputs change when a reference resolves to a different
+// object. The local player's view (minicomputer, message, and zoom) is compared directly.
+struct ConditionInput {
+    enum class Kind { ADMIRAL, OBJECT, REF, COMPUTER, MESSAGE, ZOOM };
+
+    ConditionInput(Kind kind, int32_t admiral = -1, const ObjectRef* ref = nullptr)
+            : kind(kind), admiral(admiral), ref(ref) {}
+
+    Kind             kind;
+    int32_t          admiral;  // For ADMIRAL.
+    const ObjectRef* ref;      // For OBJECT and REF.
+};
+
+// The inputs of a condition's whole tree, including the sub-conditions of “count” conditions.
+// A condition that reads something that changes on its own, without being marked, like the time
+// or an object's location, is `always` evaluated.
+struct ConditionGraph {
+    bool                        always = false;
+    std::vector<ConditionInput> inputs;
+};
+
+}  // namespace
+
+ANTARES_GLOBAL ConditionStats condition_stats;
+
+static ANTARES_GLOBAL std::vector<ConditionGraph> graphs;
+static ANTARES_GLOBAL std::vector<int64_t> scratch_inputs;
+
 static bool is_true(const ConditionWhen& c);
 
 const Condition* Condition::get(int number) {
@@ -178,8 +211,7 @@ static bool is_true(const TargetCondition& c) {
     auto sObject = resolve_object_ref(c.object);
     auto dObject = resolve_object_ref(c.target);
     return sObject.get() && dObject.get() &&
-           op_eq(c.op, std::make_pair(sObject->destObject, sObject->destObjectID),
-                 std::make_pair(dObject, dObject->id));
+           op_eq(c.op, sObject->destObject, dObject);
 }
 
 static bool is_true(const TimeCondition& c) {
@@ -222,10 +254,144 @@ static bool is_true(const ConditionWhen& c) {
     }
 }
 
+static bool same_input(const ConditionInput& x, const ConditionInput& y) {
+    if ((x.kind != y.kind) || (x.admiral != y.admiral)) {
+        return false;
+    } else if (!(x.ref && y.ref)) {
+        return x.ref == y.ref;
+    }
+    return (x.ref->type == y.ref->type) && (x.ref->initial == y.ref->initial) &&
+           (x.ref->admiral == y.ref->admiral);
+}
+
+static void add_input(ConditionGraph* graph, ConditionInput input) {
+    for (const auto& existing : graph->inputs) {
+        if (same_input(existing, input)) {
+            return;
+        }
+    }
+    graph->inputs.push_back(input);
+}
+
+static void add_inputs(ConditionGraph* graph, const ConditionWhen& c) {
+    using Kind = ConditionInput::Kind;
+    switch (c.type()) {
+        case ConditionWhen::Type::NONE: return;
+
+        case ConditionWhen::Type::AUTOPILOT:
+        case ConditionWhen::Type::BUILDING:
+        case ConditionWhen::Type::DISTANCE:
+        case ConditionWhen::Type::SPEED:
+        case ConditionWhen::Type::TARGET:
+        case ConditionWhen::Type::TIME: graph->always = true; return;
+
+        case ConditionWhen::Type::CASH:
+            return add_input(graph, {Kind::ADMIRAL, c.cash.player.number()});
+        case ConditionWhen::Type::SCORE:
+            return add_input(graph, {Kind::ADMIRAL, c.score.counter.player.number()});
+        case ConditionWhen::Type::SHIPS:
+            return add_input(graph, {Kind::ADMIRAL, c.ships.player.number()});
+
+        case ConditionWhen::Type::DESTROYED:
+            return add_input(graph, {Kind::REF, -1, &c.destroyed.object});
+        case ConditionWhen::Type::IDENTITY:
+            add_input(graph, {Kind::REF, -1, &c.identity.a});
+            return add_input(graph, {Kind::REF, -1, &c.identity.b});
+        case ConditionWhen::Type::HEALTH:
+            return add_input(graph, {Kind::OBJECT, -1, &c.health.object});
+        case ConditionWhen::Type::OWNER:
+            return add_input(graph, {Kind::OBJECT, -1, &c.owner.object});
+
+        case ConditionWhen::Type::COMPUTER: return add_input(graph, {Kind::COMPUTER});
+        case ConditionWhen::Type::MESSAGE: return add_input(graph, {Kind::MESSAGE});
+        case ConditionWhen::Type::ZOOM: return add_input(graph, {Kind::ZOOM});
+
+        case ConditionWhen::Type::COUNT:
+            for (const ConditionWhen& sub : c.count.of) {
+                add_inputs(graph, sub);
+            }
+            return;
+    }
+}
+
+// Conditions are part of the level, so their graphs are built once, when it's loaded. Inputs point
+// into g.level's conditions, so the graphs must be rebuilt whenever g.level is.
+void build_condition_graphs() {
+    graphs.clear();
+    graphs.resize(g.level->base.conditions.size());
+    for (auto c : Condition::all()) {
+        add_inputs(&graphs[c.number()], c->when);
+    }
+}
+
+static void read_input(const ConditionInput& input, std::vector<int64_t>* out) {
+    switch (input.kind) {
+        case ConditionInput::Kind::ADMIRAL:
+            if (input.admiral >= 0) {
+                out->push_back(g.condition_inputs.admirals[input.admiral]);
+            }
+            return;
+
+        case ConditionInput::Kind::OBJECT:
+        case ConditionInput::Kind::REF: {
+            auto o = resolve_object_ref(*input.ref);
+            out->push_back(o.number());
+            out->push_back(o.generation());
+            if ((input.kind == ConditionInput::Kind::OBJECT) && o.get()) {
+                out->push_back(g.condition_inputs.objects[o.number()]);
+            }
+            return;
+        }
+
+        case ConditionInput::Kind::COMPUTER:
+            out->push_back(static_cast<int64_t>(g.mini.currentScreen));
+            out->push_back(g.mini.selectLine);
+            return;
+
+        case ConditionInput::Kind::MESSAGE: {
+            auto current = Messages::current();
+            out->push_back(current.first.has_value());
+            out->push_back(current.first.value_or(0));
+            out->push_back(current.second);
+            return;
+        }
+
+        case ConditionInput::Kind::ZOOM: out->push_back(static_cast<int64_t>(g.zoom)); return;
+    }
+}
+
+// Same as is_true(c.when), but skips evaluating the condition if it's clean.
+static bool check(Handle<const Condition> c) {
+    const ConditionGraph& graph = graphs[c.number()];
+    if (graph.always) {
+        ++condition_stats.evaluated;
+        return is_true(c->when);
+    }
+
+    // Evaluating the condition doesn't change anything it reads, so it reads what's read here.
+    scratch_inputs.clear();
+    for (const auto& input : graph.inputs) {
+        read_input(input, &scratch_inputs);
+    }
+
+    ConditionCheck& last = g.condition_checks[c.number()];
+    if (last.valid && (last.inputs == scratch_inputs)) {
+        ++condition_stats.skipped;
+        return last.value;
+    }
+    ++condition_stats.evaluated;
+    last.valid = true;
+    last.value = is_true(c->when);
+    last.inputs = scratch_inputs;
+    return last.value;
+}
+
 void CheckLevelConditions() {
+    PhaseTimer timer(TickPhase::CONDITIONS);
+    condition_stats = ConditionStats{};
     for (auto& c : g.level->base.conditions) {
         int index = (&c - g.level->base.conditions.data());
-        if (g.condition_enabled[index] && is_true(c.when)) {
+        if (g.condition_enabled[index] && check(Handle<const Condition>(index))) {
             if (!c.persistent.value_or(false)) {
                 g.condition_enabled[index] = false;
             }
@@ -236,4 +402,12 @@ void CheckLevelConditions() {
     }
 }
 
+void mark_conditions_dirty(Handle<Admiral> admiral) {
+    ++g.condition_inputs.admirals[admiral.number()];
+}
+
+void mark_conditions_dirty(const SpaceObject& object) {
+    ++g.condition_inputs.objects[object.number()];
+}
+
 }  // namespace antares
@@ -40,6 +40,8 @@ ANTARES_GLOBAL GlobalState& g = head;
 ANTARES_GLOBAL GlobalState head;
 ANTARES_GLOBAL GlobalState tail;
 
+ANTARES_GLOBAL Arena tick_arena;
+
 aresGlobalType* globals() { return gAresGlobal; }
 
 void init_globals() {
@@ -51,6 +53,14 @@ void init_globals() {
     g.farthest = Handle<SpaceObject>(0);
 }
 
+RandomSource random_source(RandomPurpose purpose, int32_t id, int32_t serial) {
+    if (g.random_mode == RandomMode::LEGACY) {
+        return &g.random;
+    }
+    ++g.random_streams;
+    return RandomStream(g.level_seed, purpose, g.time.time_since_epoch().count(), id, serial);
+}
+
 aresGlobalType::aresGlobalType() {}
 
 aresGlobalType::~aresGlobalType() {}
@@ -75,7 +75,6 @@ void create_initial(Handle<const Initial> initial) {
                 anObject, initial->build, initial->earning.value_or(Fixed::zero()),
                 initial->override_.name);
     }
-    g.initial_ids[initial.number()] = anObject->id;
 
     if ((anObject->attributes & kIsPlayerShip) && owner.get() && !owner->flagship().get()) {
         owner->set_flagship(anObject);
@@ -180,7 +179,6 @@ void UnhideInitialObject(Handle<const Initial> initial) {
         }
     }
 
-    g.initial_ids[initial.number()] = anObject->id;
     if ((anObject->attributes & kIsPlayerShip) && owner.get() && !owner->flagship().get()) {
         owner->set_flagship(anObject);
         if (owner == g.admiral) {
@@ -196,8 +194,7 @@ Handle<SpaceObject> GetObjectFromInitialNumber(Handle<const Initial> initial) {
     if (initial.number() >= 0) {
         auto object = g.initials[initial.number()];
         if (object.get()) {
-            if ((object->id != g.initial_ids[initial.number()]) ||
-                (object->active != kObjectInUse)) {
+            if (object.expired() || (object->active != kObjectInUse)) {
                 return SpaceObject::none();
             }
             return object;
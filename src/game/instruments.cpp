@@ -30,6 +30,8 @@
 #include "game/minicomputer.hpp"
 #include "game/motion.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/render-frame.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
@@ -120,7 +122,6 @@ namespace {
 
 struct barIndicatorType {
     int16_t top;
-    int32_t thisValue;
     Hue     hue;
 };
 
@@ -148,8 +149,8 @@ T clamp(T value, T min, T max) {
 }  // namespace
 
 static void draw_bar_indicator(int16_t, int32_t, int32_t);
-static void draw_money();
-static void draw_build_time_bar();
+static void draw_money(const RenderFrame::InstrumentView& view);
+static void draw_build_time_bar(const RenderFrame::InstrumentView& view);
 
 void InstrumentInit() {
     g.radar_blips.reset(new Point[kRadarBlipNum]);
@@ -179,9 +180,6 @@ void ResetInstruments() {
         l++;
     }
 
-    for (i = 0; i < kBarIndicatorNum; i++) {
-        gBarIndicator[i].thisValue = -1;
-    }
     // the shield bar
     gBarIndicator[kShieldBar].top = 359;
     gBarIndicator[kShieldBar].hue = Hue::SKY_BLUE;
@@ -200,6 +198,7 @@ void ResetInstruments() {
 }
 
 void UpdateRadar(ticks unitsDone) {
+    PhaseTimer timer(TickPhase::RADAR);
     if (!g.ship.get()) {
         g.radar_on = false;
     } else if (g.ship->offlineTime <= 0) {
@@ -329,7 +328,7 @@ void UpdateRadar(ticks unitsDone) {
     gAbsoluteScale = absolute_scale;
 }
 
-void draw_radar() {
+static void draw_radar(const RenderFrame::InstrumentView& view) {
     Rect bounds(kRadarLeft, kRadarTop, kRadarRight, kRadarBottom);
     bounds.offset(0, instrument_top());
     bounds.inset(1, 1);
@@ -337,32 +336,29 @@ void draw_radar() {
     const RgbColor very_light = GetRGBTranslateColorShade(kRadarColor, LIGHTEST);
     const RgbColor darkest    = GetRGBTranslateColorShade(kRadarColor, DARKEST);
     const RgbColor very_dark  = GetRGBTranslateColorShade(kRadarColor, VERY_DARK);
-    if (g.radar_on) {
+    if (view.radar_on) {
         Rect radar = bounds;
         {
             Rects rects;
             rects.fill(radar, very_light);
             radar.inset(1, 1);
             rects.fill(radar, darkest);
-            if ((view_range.width() > 0) && (view_range.height() > 0)) {
-                rects.fill(view_range, very_dark);
+            if ((view.radar_range.width() > 0) && (view.radar_range.height() > 0)) {
+                rects.fill(view.radar_range, very_dark);
             }
         }
 
         RgbColor color;
-        if (g.radar_count <= ticks(0)) {
+        if (view.radar_count <= ticks(0)) {
             color = very_dark;
         } else {
             color = GetRGBTranslateColorShade(
-                    kRadarColor, ((kRadarColorSteps * g.radar_count) / kRadarSpeed) + 1);
+                    kRadarColor, ((kRadarColorSteps * view.radar_count) / kRadarSpeed) + 1);
         }
 
         Points points;
-        for (int rcount = 0; rcount < kRadarBlipNum; rcount++) {
-            Point* lp = g.radar_blips.get() + rcount;
-            if (lp->h >= 0) {
-                points.draw(*lp, color);
-            }
+        for (const Point& blip : view.radar_blips) {
+            points.draw(blip, color);
         }
     } else {
         Rects().fill(bounds, darkest);
@@ -370,10 +366,9 @@ void draw_radar() {
 }
 
 // SHOW ME THE MONEY
-static void draw_money() {
-    auto&      admiral = g.admiral;
-    const Cash cash    = clamp(admiral->cash(), Cash{Fixed::zero()}, kMaxMoneyValue);
-    gBarIndicator[kFineMoneyBar].thisValue =
+static void draw_money(const RenderFrame::InstrumentView& view) {
+    const Cash    cash = clamp(view.cash, Cash{Fixed::zero()}, kMaxMoneyValue);
+    const int32_t fine =
             mFixedToLong((cash.amount % kFineMoneyBarMod.amount) / kFineMoneyBarValue.amount);
     const int price = mFixedToLong(
             MiniComputerGetPriceOfCurrentSelection().amount / kFineMoneyBarValue.amount);
@@ -400,20 +395,20 @@ static void draw_money() {
     // Third section: money we don't have and don't need for the current selection.
     RgbColor third_color = GetRGBTranslateColorShade(kFineMoneyColor, VERY_DARK);
 
-    if (gBarIndicator[kFineMoneyBar].thisValue < price) {
+    if (fine < price) {
         first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
         first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
         second_color_major = GetRGBTranslateColorShade(kFineMoneyNeedColor, MEDIUM);
         second_color_minor = GetRGBTranslateColorShade(kFineMoneyNeedColor, DARK);
-        first_threshold    = gBarIndicator[kFineMoneyBar].thisValue;
+        first_threshold    = fine;
         second_threshold   = price;
     } else {
         first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
         first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
         second_color_major = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHTEST);
         second_color_minor = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHT);
-        first_threshold    = gBarIndicator[kFineMoneyBar].thisValue - price;
-        second_threshold   = gBarIndicator[kFineMoneyBar].thisValue;
+        first_threshold    = fine - price;
+        second_threshold   = fine;
     }
 
     Rects rects;
@@ -435,10 +430,7 @@ static void draw_money() {
         }
         box.offset(0, kFineMoneyBarHeight);
     }
-    gBarIndicator[kFineMoneyBar].thisValue = second_threshold;
-
-    barIndicatorType* gross = gBarIndicator + kGrossMoneyBar;
-    gross->thisValue        = mFixedToLong(admiral->cash().amount / kGrossMoneyBarValue.amount);
+    const int32_t gross = mFixedToLong(view.cash.amount / kGrossMoneyBarValue.amount);
 
     box = Rect(0, 0, kGrossMoneyBarWidth, kGrossMoneyBarHeight - 1);
     box.offset(
@@ -448,7 +440,7 @@ static void draw_money() {
     const RgbColor light = GetRGBTranslateColorShade(kGrossMoneyColor, LIGHTEST);
     const RgbColor dark  = GetRGBTranslateColorShade(kGrossMoneyColor, VERY_DARK);
     for (int i = 0; i < kGrossMoneyBarNum; ++i) {
-        if (i < gross->thisValue) {
+        if (i < gross) {
             rects.fill(box, light);
         } else {
             rects.fill(box, dark);
@@ -465,7 +457,50 @@ void set_up_instruments() {
     UpdateRadar(ticks(100));  // full update
 }
 
-void draw_instruments() {
+void capture_instruments(RenderFrame* frame) {
+    RenderFrame::InstrumentView& view = frame->instruments;
+
+    view.ship = g.ship.get() && g.ship->active;
+    if (view.ship) {
+        const SpaceObject::Weapon& pulse   = g.ship->pulse;
+        const SpaceObject::Weapon& beam    = g.ship->beam;
+        const SpaceObject::Weapon& special = g.ship->special;
+        view.ammo[0] = (pulse.base && (pulse.base->device->ammo > 0)) ? pulse.ammo : -1;
+        view.ammo[1] = (beam.base && (beam.base->device->ammo > 0)) ? beam.ammo : -1;
+        view.ammo[2] = (special.base && (special.base->device->ammo > 0)) ? special.ammo : -1;
+
+        view.shield      = g.ship->health();
+        view.max_shield  = g.ship->max_health();
+        view.energy      = g.ship->energy();
+        view.max_energy  = g.ship->max_energy();
+        view.battery     = g.ship->battery();
+        view.max_battery = g.ship->max_battery();
+    }
+
+    auto build_at   = GetAdmiralBuildAtObject(g.admiral);
+    view.building   = build_at.get();
+    view.build_time = 0;
+    if (view.building && (build_at->totalBuildTime > ticks(0))) {
+        ticks total     = build_at->totalBuildTime;
+        view.build_time = build_at->buildTime * kMiniBuildTimeHeight / total;
+    }
+    view.cash = g.admiral->cash();
+
+    view.radar_on    = g.radar_on;
+    view.radar_count = g.radar_count;
+    view.radar_range = view_range;
+    view.radar_blips.clear();
+    for (int i = 0; i < kRadarBlipNum; ++i) {
+        const Point& blip = g.radar_blips[i];
+        if (blip.h >= 0) {
+            view.radar_blips.push_back(blip);
+        }
+    }
+}
+
+void draw_instruments(const RenderFrame& frame) {
+    const RenderFrame::InstrumentView& view = frame.instruments;
+
     Rect left_rect(world().left, world().top, viewport().left, world().bottom);
     Rect right_rect(viewport().right, world().top, world().right, world().bottom);
 
@@ -475,23 +510,16 @@ void draw_instruments() {
     sys.left_instrument_texture.draw(left_rect.left, left_rect.top);
     sys.right_instrument_texture.draw(right_rect.left, right_rect.top);
 
-    if (g.ship.get() && g.ship->active) {
-        const SpaceObject::Weapon& pulse   = g.ship->pulse;
-        const SpaceObject::Weapon& beam    = g.ship->beam;
-        const SpaceObject::Weapon& special = g.ship->special;
-        draw_player_ammo(
-                (pulse.base && (pulse.base->device->ammo > 0)) ? pulse.ammo : -1,
-                (beam.base && (beam.base->device->ammo > 0)) ? beam.ammo : -1,
-                (special.base && (special.base->device->ammo > 0)) ? special.ammo : -1);
-
-        draw_bar_indicator(kShieldBar, g.ship->health(), g.ship->max_health());
-        draw_bar_indicator(kEnergyBar, g.ship->energy(), g.ship->max_energy());
-        draw_bar_indicator(kBatteryBar, g.ship->battery(), g.ship->max_battery());
+    if (view.ship) {
+        draw_player_ammo(view.ammo[0], view.ammo[1], view.ammo[2]);
+        draw_bar_indicator(kShieldBar, view.shield, view.max_shield);
+        draw_bar_indicator(kEnergyBar, view.energy, view.max_energy);
+        draw_bar_indicator(kBatteryBar, view.battery, view.max_battery);
     }
 
-    draw_build_time_bar();
-    draw_money();
-    draw_radar();
+    draw_build_time_bar(view);
+    draw_money(view);
+    draw_radar(view);
     draw_mini_screen();
 }
 
@@ -674,22 +702,15 @@ static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
         draw_shaded_rect(rects, bottom_bar, fill_color, light_color, dark_color);
     }
 
-    gBarIndicator[which].thisValue = value;
 }
 
-void draw_build_time_bar() {
-    auto build_at = GetAdmiralBuildAtObject(g.admiral);
-    if (!build_at.get()) {
+void draw_build_time_bar(const RenderFrame::InstrumentView& view) {
+    if (!view.building) {
         return;
     }
 
-    int32_t value = 0;
-    if (build_at->totalBuildTime > ticks(0)) {
-        value = build_at->buildTime * kMiniBuildTimeHeight / build_at->totalBuildTime;
-    }
-
-    Rects rects;
-    value = kMiniBuildTimeHeight - value;
+    Rects   rects;
+    int32_t value = kMiniBuildTimeHeight - view.build_time;
 
     const Rect clip = mini_build_time_rect();
 
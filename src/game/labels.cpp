@@ -26,6 +26,8 @@
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
+#include "game/profile.hpp"
+#include "game/render-frame.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
@@ -98,6 +100,7 @@ Handle<Label> Label::add(
     }
     label->_text   = StyledText{};
     label->lineNum = 0;
+    ++label->generation;
 
     return label;
 }
@@ -111,20 +114,34 @@ void Label::remove() {
     lineNum  = 0;
 }
 
-void Label::draw() {
+void Label::capture(RenderFrame* frame) {
+    frame->labels.clear();
     for (auto label : all()) {
+        if (!label->active || label->killMe || label->_text.empty() || !label->visible ||
+            (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
+            continue;
+        }
+        frame->labels.push_back(
+                {label.number(), label->generation, label->thisRect, label->hue});
+    }
+}
+
+void Label::draw(const RenderFrame& frame) {
+    for (const RenderFrame::LabelView& view : frame.labels) {
         // We anchor the image at the corner of the rect instead of label->where.  In some cases,
         // label->where is changed between update_all_label_contents() and draw time, but the rect
         // remains unchanged.  Since that function used to do this drawing, the rect's corner is
         // the original location we drew at.
-        Rect rect = label->thisRect;
+        Rect rect = view.rect;
 
-        if (!label->active || label->killMe || label->_text.empty() || !label->visible ||
-            (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
+        // The text is not part of the frame: it only changes on ticks, or as the player types,
+        // and drawing never overlaps either.
+        const Label* label = get(view.number);
+        if (label->_text.empty()) {
             continue;
         }
-        const RgbColor dark = GetRGBTranslateColorShade(label->hue, VERY_DARK);
-        sys.video->dither_rect(label->thisRect, dark);
+        const RgbColor dark = GetRGBTranslateColorShade(view.hue, VERY_DARK);
+        sys.video->dither_rect(view.rect, dark);
         rect.offset(kLabelInnerSpace, kLabelInnerSpace);
 
         label->_text.draw(rect);
@@ -132,6 +149,7 @@ void Label::draw() {
 }
 
 void Label::update_contents(ticks units_done) {
+    PhaseTimer timer(TickPhase::LABELS);
     Rect clip = viewport();
     for (auto label : all()) {
         if (!label->active || label->killMe || label->_text.empty() || !label->visible) {
@@ -177,6 +195,7 @@ void Label::set_position(int16_t h, int16_t v) {
 }
 
 void Label::update_positions(ticks units_done) {
+    PhaseTimer timer(TickPhase::LABELS);
     const Rect label_limits(
             viewport().left + kLabelBuffer, viewport().top + kLabelBuffer,
             viewport().right - kLabelBuffer, viewport().bottom - kLabelBuffer);
@@ -25,11 +25,13 @@
 #include "data/plugin.hpp"
 #include "data/races.hpp"
 #include "drawing/pix-table.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/action.hpp"
 #include "game/admiral.hpp"
 #include "game/condition.hpp"
 #include "game/globals.hpp"
 #include "game/initial.hpp"
+#include "game/input-source.hpp"
 #include "game/instruments.hpp"
 #include "game/labels.hpp"
 #include "game/messages.hpp"
@@ -37,10 +39,12 @@
 #include "game/motion.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -113,6 +117,7 @@ void AddBaseObjectMedia(
 }
 
 void AddBaseObjectActionMedia(const std::vector<Action>& actions, std::bitset<16> all_colors) {
+    compile_actions(actions);
     for (const auto& action : actions) {
         AddActionMedia(action, all_colors);
     }
@@ -194,16 +199,26 @@ LoadState start_construct_level(const Level& level) {
     ResetAllDestObjectData();
     ResetMotionGlobals();
     plug.races.clear();
+    plug.objects_by_name.clear();
     plug.objects.clear();
     gAbsoluteScale = kTimesTwoScale;
     g.sync         = 0;
 
     g.level = &level;
 
+    g.random_mode    = plug.info.random;
+    g.level_seed     = g.random.seed;
+    g.random_streams = 0;
+    if (g.random_mode == RandomMode::COUNTER) {
+        // Key draws made while loading to the start of the level, rather than to wherever the
+        // last level's clock stopped. LEGACY levels never looked at the clock while loading.
+        g.time = game_ticks();
+    }
+
     if (g.level->base.angle.has_value()) {
         g.angle = *g.level->base.angle;
     } else {
-        g.angle = g.random.next(ROT_POS);
+        g.angle = random_source(RandomPurpose::LEVEL, 0).next(ROT_POS);
     }
 
     g.victor       = Admiral::none();
@@ -220,10 +235,11 @@ LoadState start_construct_level(const Level& level) {
 
     g.initials.clear();
     g.initials.resize(Initial::all().size());
-    g.initial_ids.clear();
-    g.initial_ids.resize(Initial::all().size());
     g.condition_enabled.clear();
     g.condition_enabled.resize(g.level->base.conditions.size());
+    g.condition_checks.clear();
+    g.condition_checks.resize(g.level->base.conditions.size());
+    build_condition_graphs();
 
     ///// FIRST SELECT WHAT MEDIA WE NEED TO USE:
 
@@ -289,6 +305,7 @@ static void load_initial(Handle<const Initial> initial, std::bitset<16> all_colo
 }
 
 static void load_condition(Handle<const Condition> condition, std::bitset<16> all_colors) {
+    compile_actions(condition->action);
     for (const auto& action : condition->action) {
         AddActionMedia(action, all_colors);
     }
@@ -309,10 +326,51 @@ static void run_game_1s() {
         }
         CullSprites();
         Vectors::cull();
+        tick_profile.end_tick();
+        tick_arena.reset();
     } while ((g.time.time_since_epoch() % secs(1)) != ticks(0));
 }
 
+void play_tick(ticks units, InputSource* input, PlayerShip* player_ship) {
+    MoveSpaceObjects(units);
+    g.time += units;
+
+    if ((g.time.time_since_epoch() % kMajorTick) == ticks(0)) {
+        NonplayerShipThink();
+        AdmiralThink();
+        execute_action_queue();
+
+        if (!input->get(g.admiral, g.time, *player_ship)) {
+            g.game_over    = true;
+            g.game_over_at = g.time;
+        }
+        player_ship->update();
+
+        CollideSpaceObjects();
+        if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
+            CheckLevelConditions();
+        }
+    }
+
+    // Not only drawn: long messages check level conditions, and build commands read which of
+    // the minicomputer's lines are selectable.
+    UpdateMiniScreenLines();
+    Messages::clip();
+    Messages::draw_long_message(units);
+}
+
+void end_play_tick() {
+    CullSprites();
+    Vectors::cull();
+
+    if ((g.time.time_since_epoch() % kMajorTick) == ticks(0)) {
+        tick_profile.end_tick();
+        tick_arena.reset();
+    }
+}
+
 void construct_level(LoadState* state) {
+    ANTARES_TRACE("load", "construct_level");
     int32_t         step = state->step;
     std::bitset<16> all_colors;
     all_colors[0] = true;
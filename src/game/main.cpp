@@ -21,6 +21,7 @@
 #include <fcntl.h>
 #include <math.h>
 #include <algorithm>
+#include <chrono>
 #include <pn/output>
 #include <set>
 
@@ -49,6 +50,8 @@
 #include "game/motion.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/render-frame.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
@@ -98,6 +101,7 @@ class GamePlay : public Card {
 
     virtual bool next_timer(wall_time& time);
     virtual void fire_timer();
+    virtual bool tick();
 
     virtual void key_down(const KeyDownEvent& event);
     virtual void key_up(const KeyUpEvent& event);
@@ -111,6 +115,9 @@ class GamePlay : public Card {
     virtual void gamepad_stick(const GamepadStickEvent& event);
 
   private:
+    void advance();
+    void present(ticks units);
+
     enum State {
         PLAYING,
         PAUSED,
@@ -131,6 +138,7 @@ class GamePlay : public Card {
     PlayerShip            _player_ship;
     bool                  _should_draw_sector_lines;
     bool                  _should_draw_site;
+    bool                  _show_tick_profile;
 
     // The wall_time that g.time corresponds to. Under normal operation,
     // this increases in lockstep with g.time, but during fast motion or
@@ -138,6 +146,9 @@ class GamePlay : public Card {
     // clock.
     wall_time _real_time;
 
+    // Ticks that were due, but didn't fit in the budget for the last call to advance().
+    ticks _backlog;
+
     InputSource* _input_source;
 };
 
@@ -231,9 +242,14 @@ GamePlay::GamePlay(bool replay, InputSource* input, GameResult* game_result)
           _command_and_q(BothCommandAndQ()),
           _fast_motion(false),
           _player_paused(false),
+          _show_tick_profile(false),
           _real_time(now()),
+          _backlog(ticks(0)),
           _input_source(input) {}
 
+// Toggles the tick profile overlay, unless the player has bound it to something else.
+static const Key kTickProfileKey = Key::F7;
+
 static const usecs kSwitchAfter = usecs(1000000 / 3);  // TODO(sfiera): ticks(20)
 static const usecs kSleepAfter  = secs(60);
 
@@ -332,6 +348,8 @@ void GamePlay::become_front() {
             HintLine::reset();
 
             CheckLevelConditions();
+            globals()->frames.reset();
+            globals()->frames.publish(_real_time);
             break;
 
         case PAUSED:
@@ -386,20 +404,74 @@ void GamePlay::become_front() {
 
 void GamePlay::resign_front() { minicomputer_cancel(); }
 
+static int64_t whole_usecs(std::chrono::nanoseconds t) {
+    return std::chrono::duration_cast<usecs>(t).count();
+}
+
+// Shows what each phase of the game loop cost per major tick over the last 30 seconds, to find
+// the one that runs over the budget of a major tick, and what the last frame cost to draw.
+static void draw_tick_profile() {
+    const size_t    kWindow = 600;
+    const Font&     font    = sys.fonts.tactical;
+    const RgbColor& color   = GetRGBTranslateColorShade(Hue::GREEN, LIGHTEST);
+    Point           origin(viewport().left + 4, viewport().top + 4 + font.ascent);
+    font.draw(
+            origin,
+            pn::format("us per major tick (of {0}): p50 p99 max", usecs(kMajorTick).count()),
+            color);
+    for (int i = 0; i < kTickPhaseCount; ++i) {
+        TickPhase  phase = static_cast<TickPhase>(i);
+        PhaseTimes t     = tick_profile.times(phase, kWindow);
+        origin.offset(0, font.height);
+        font.draw(
+                origin,
+                pn::format(
+                        "{0}: {1} {2} {3}", phase_name(phase), whole_usecs(t.p50),
+                        whole_usecs(t.p99), whole_usecs(t.max)),
+                color);
+    }
+
+    VideoDriver::DrawStats stats = sys.video->draw_stats();
+    origin.offset(0, font.height);
+    font.draw(
+            origin,
+            pn::format(
+                    "last frame: {0} draw calls, {1} vertices, {2} instances, {3} texture "
+                    "switches",
+                    stats.draw_calls, stats.vertices, stats.instances, stats.texture_switches),
+            color);
+    origin.offset(0, font.height);
+    pn::string programs = pn::format("programs: {0} switches", stats.program_switches);
+    for (const auto& p : stats.program_times) {
+        if (p.name && (p.nsecs > 0)) {
+            programs += pn::format(", {0} {1} us", p.name, p.nsecs / 1000);
+        }
+    }
+    font.draw(origin, programs, color);
+    origin.offset(0, font.height);
+    font.draw(origin, pn::format("textures: {0} KiB", stats.texture_bytes / 1024), color);
+}
+
 void GamePlay::draw() const {
-    globals()->starfield.draw();
+    RenderFrames&      frames = globals()->frames;
+    const RenderFrame& frame  = sys.video->real_time() ? frames.blend(now()) : frames.current();
+
+    Starfield::draw(frame);
     if (_should_draw_sector_lines) {
         draw_sector_lines();
     }
-    Vectors::draw();
-    draw_sprites();
-    Label::draw();
+    Vectors::draw(frame);
+    draw_sprites(frame);
+    Label::draw(frame);
 
     Messages::draw_message();
     if (_should_draw_site) {
         draw_site(_player_ship);
     }
-    draw_instruments();
+    draw_instruments(frame);
+    if (_show_tick_profile) {
+        draw_tick_profile();
+    }
     if (stack()->top() == this) {
         _player_ship.cursor().draw();
     }
@@ -415,7 +487,42 @@ bool GamePlay::next_timer(wall_time& time) {
     return false;
 }
 
-void GamePlay::fire_timer() {
+// Leaves results to fire_timer(), which pushes and pops cards for them.
+bool GamePlay::tick() {
+    if (*_game_result != NO_GAME) {
+        return false;
+    }
+    advance();
+    return *_game_result == NO_GAME;
+}
+
+// How long one call to advance() may spend ticking on a real clock, so that fast motion, or
+// catching up after a stall, doesn't keep frames from being drawn: about half a frame at 60 Hz.
+static const usecs kTickBudget = usecs(8000);
+
+// The most ticks carried over to the next call when the budget runs out. Past that, fast motion
+// runs slower than asked rather than falling further behind.
+static const ticks kMaxBacklog = ticks(60);
+
+// Updates what only matters for drawing, after `units` of simulation.
+void GamePlay::present(ticks units) {
+    Messages::layout();
+    _should_draw_sector_lines = update_sector_lines();
+    Vectors::update();
+    Label::update_positions(units);
+    Label::update_contents(units);
+    _should_draw_site = update_site();
+
+    Label::show_all();
+    globals()->starfield.show();
+
+    Messages::draw_message_screen(units);
+    UpdateRadar(units);
+    globals()->transitions.update_boolean(units);
+}
+
+// Runs the simulation up to now(), and publishes a frame of it to draw.
+void GamePlay::advance() {
     while (_next_timer < now()) {
         _next_timer = _next_timer + kMinorTick;
     }
@@ -428,9 +535,11 @@ void GamePlay::fire_timer() {
     }
 
     if (_fast_motion && !_player_ship.entering_message()) {
-        unitsPassed *= 12;
+        unitsPassed *= sys.prefs->fast_motion();
         _real_time = now();
     }
+    unitsPassed += _backlog;
+    _backlog = ticks(0);
 
     if (unitsPassed <= ticks(0)) {
         return;
@@ -444,6 +553,12 @@ void GamePlay::fire_timer() {
         _real_time     = now();
     }
 
+    // On a real clock, ticks stop when the budget runs out, and the rest are left for next time.
+    // Drawing only shows the last tick then, so the presentation is brought up to date once,
+    // after it, rather than after each tick. Otherwise, nothing is budget-limited, and each tick
+    // is presented in turn, as it always was.
+    const auto budget_end  = std::chrono::steady_clock::now() + kTickBudget;
+    ticks      unpresented = ticks(0);
     while (unitsPassed > ticks(0)) {
         ticks unitsToDo   = unitsPassed;
         ticks minor_ticks = g.time.time_since_epoch() % kMajorTick;
@@ -454,52 +569,26 @@ void GamePlay::fire_timer() {
         // executed arbitrarily, but at least once every major tick
         globals()->starfield.prepare_to_move();
         globals()->starfield.move(unitsToDo);
-        MoveSpaceObjects(unitsToDo);
-
-        g.time += unitsToDo;
-
+        play_tick(unitsToDo, _input_source, &_player_ship);
         if ((g.time.time_since_epoch() % kMajorTick) == ticks(0)) {
-            // everything in here gets executed once every major tick
             _player_paused = false;
-
-            NonplayerShipThink();
-            AdmiralThink();
-            execute_action_queue();
-
-            if (!_input_source->get(g.admiral, g.time, _player_ship)) {
-                g.game_over    = true;
-                g.game_over_at = g.time;
-            }
-            _player_ship.update();
-
-            CollideSpaceObjects();
-            if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
-                CheckLevelConditions();
-            }
         }
 
-        UpdateMiniScreenLines();
-
-        Messages::clip();
-        Messages::draw_long_message(unitsToDo);
-
-        _should_draw_sector_lines = update_sector_lines();
-        Vectors::update();
-        Label::update_positions(unitsToDo);
-        Label::update_contents(unitsToDo);
-        _should_draw_site = update_site();
-
-        CullSprites();
-        Label::show_all();
-        Vectors::cull();
-        globals()->starfield.show();
-
-        Messages::draw_message_screen(unitsToDo);
-        UpdateRadar(unitsToDo);
-        globals()->transitions.update_boolean(unitsToDo);
-
         unitsPassed -= unitsToDo;
+        unpresented += unitsToDo;
+        if ((unitsPassed > ticks(0)) && sys.video->real_time() &&
+            (std::chrono::steady_clock::now() >= budget_end)) {
+            _backlog    = std::min(unitsPassed, kMaxBacklog);
+            unitsPassed = ticks(0);
+        }
+        if ((unitsPassed == ticks(0)) || !sys.video->real_time()) {
+            present(unpresented);
+            unpresented = ticks(0);
+        }
+
+        end_play_tick();
     }
+    globals()->frames.publish(_real_time);
 
     if (g.game_over && (g.time >= g.game_over_at)) {
         if (*_game_result == NO_GAME) {
@@ -510,6 +599,13 @@ void GamePlay::fire_timer() {
             }
         }
     }
+}
+
+void GamePlay::fire_timer() {
+    // If tick() already produced a result, act on it without ticking past the end of the game.
+    if (*_game_result == NO_GAME) {
+        advance();
+    }
 
     switch (*_game_result) {
         case QUIT_GAME:
@@ -553,6 +649,15 @@ void GamePlay::fire_timer() {
     }
 }
 
+static bool key_is_bound(Key key) {
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        if (sys.prefs->key(i) == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void GamePlay::key_down(const KeyDownEvent& event) {
     switch (event.key()) {
         case Key::CAPS_LOCK:
@@ -600,6 +705,11 @@ void GamePlay::key_down(const KeyDownEvent& event) {
             } else if (event.key() == sys.prefs->key(kFastMotionKeyNum)) {
                 _fast_motion = true;
                 return;
+            } else if ((event.key() == kTickProfileKey) && !key_is_bound(kTickProfileKey)) {
+                _show_tick_profile = !_show_tick_profile;
+                tick_profile.set_enabled(_show_tick_profile);
+                tick_profile.reset();
+                return;
             }
     }
 
@@ -649,4 +759,30 @@ void GamePlay::gamepad_stick(const GamepadStickEvent& event) {
     _input_source->gamepad_stick(event);
 }
 
+GameResult simulate_level(const Level& level, InputSource* input) {
+    RemoveAllSpaceObjects();
+    g.game_over = false;
+    LoadState s = start_construct_level(level);
+    while (!s.done) {
+        construct_level(&s);
+    }
+    return simulate_loaded_level(input);
+}
+
+GameResult simulate_loaded_level(InputSource* input) {
+    set_up_instruments();
+
+    PlayerShip player_ship;
+    input->start();
+    CheckLevelConditions();
+
+    // GamePlay's ticks, one minor tick at a time, without updating what's drawn.
+    while (!(g.game_over && (g.time >= g.game_over_at))) {
+        play_tick(kMinorTick, input, &player_ship);
+        end_play_tick();
+    }
+
+    return (g.victor == g.admiral) ? WIN_GAME : LOSE_GAME;
+}
+
 }  // namespace antares
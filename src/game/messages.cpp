@@ -18,6 +18,10 @@
 
 #include "game/messages.hpp"
 
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
 #include "config/keys.hpp"
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
@@ -30,6 +34,8 @@
 #include "game/instruments.hpp"
 #include "game/labels.hpp"
 #include "game/level.hpp"
+#include "game/profile.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
@@ -68,13 +74,6 @@ static const RgbColor& kMessagesBackColor = GetRGBTranslateColorShade(Hue::SKY_B
 
 namespace {
 
-template <typename T>
-void clear(T& t) {
-    using std::swap;
-    T u = T();
-    swap(t, u);
-}
-
 enum longMessageStageType {
     kNoStage    = 0,
     kStartStage = 1,
@@ -85,6 +84,83 @@ enum longMessageStageType {
 
 }  // namespace
 
+// Messages waiting to be shown, oldest first. Each is normally copied into a slot of its own, so
+// that adding one mid-tick doesn't allocate. A message too long for its slot is kept in the slot's
+// `spill` string instead, and those added while every slot is waiting go to `overflow` until a
+// slot frees up; neither is lost or cut short.
+struct Messages::MessageQueue {
+    static const int kSlots      = 16;
+    static const int kSlotLength = 256;
+
+    struct Slot {
+        char       data[kSlotLength];
+        int        size;
+        pn::string spill;  // Holds the message if `size` > kSlotLength.
+
+        pn::string_view text() const {
+            return (size > kSlotLength) ? pn::string_view(spill) : pn::string_view(data, size);
+        }
+
+        void assign(pn::string_view message) {
+            size = message.size();
+            if (size > kSlotLength) {
+                spill = message.copy();
+            } else {
+                memcpy(data, message.data(), size);
+            }
+        }
+    };
+
+    Slot                    slots[kSlots];
+    int                     first = 0;
+    int                     count = 0;
+    std::vector<pn::string> overflow;      // Newer than every slot, oldest first.
+    bool                    shown = false;  // Whether the message label holds the first message.
+
+    bool            empty() const { return count == 0; }
+    pn::string_view front() const { return slots[first].text(); }
+
+    void clear() {
+        first = count = 0;
+        overflow.clear();
+        shown = false;
+    }
+
+    void pop() {
+        first = (first + 1) % kSlots;
+        --count;
+        shown = false;
+        if (!overflow.empty()) {
+            push(overflow.front());
+            overflow.erase(overflow.begin());
+        }
+    }
+
+    void snapshot(SnapshotArchive& a) {
+        a.value(first);
+        a.value(count);
+        a.value(shown);
+        for (int i = 0; i < count; ++i) {
+            Slot& slot = slots[(first + i) % kSlots];
+            a.value(slot.size);
+            if (slot.size > kSlotLength) {
+                a.string(slot.spill);
+            } else {
+                a.array(slot.data, slot.size);
+            }
+        }
+        a.each(overflow, [](SnapshotArchive& a, pn::string& s) { a.string(s); });
+    }
+
+    void push(pn::string_view message) {
+        if (count == kSlots) {
+            overflow.push_back(message.copy());
+            return;
+        }
+        slots[(first + count++) % kSlots].assign(message);
+    }
+};
+
 struct Messages::longMessageType {
     longMessageStageType           stage         = kNoStage;
     int                            teletype_tick = 0;
@@ -94,6 +170,7 @@ struct Messages::longMessageType {
     int16_t                        last_page_index    = -1;
     uint8_t                        backColor          = 0;
     pn::string                     text               = "";
+    bool                           needs_layout       = false;  // Set by clip() for present().
     StyledText                     retro_text;
     Point                          retro_origin     = {0, 0};
     bool                           labelMessage     = false;
@@ -108,14 +185,19 @@ struct Messages::longMessageType {
     bool was_updated() const { return current_page_index != last_page_index; }
 };
 
-ANTARES_GLOBAL std::queue<pn::string> Messages::message_data;
+ANTARES_GLOBAL Messages::MessageQueue Messages::message_data;
 ANTARES_GLOBAL Messages::longMessageType* Messages::long_message_data;
 ANTARES_GLOBAL ticks Messages::time_count;
 
+// Status text that set_status() left for layout(). It's always a literal or one of
+// sys.messages, so a view of it stays valid.
+static ANTARES_GLOBAL sfz::optional<pn::string_view> pending_status;
+static ANTARES_GLOBAL Hue                            pending_status_hue;
+
 void MessageLabel_Set_Special(Handle<Label> id, pn::string_view text);
 
 void Messages::init() {
-    antares::clear(message_data);
+    message_data.clear();
     long_message_data = new longMessageType;
 
     g.message_label = Label::add(
@@ -137,8 +219,8 @@ void Messages::init() {
 
 void Messages::clear() {
     time_count = ticks(0);
-    std::queue<pn::string> empty;
-    swap(message_data, empty);
+    message_data.clear();
+    pending_status.reset();
     g.message_label = Label::add(
             kMessageScreenLeft, kMessageScreenTop, 0, 0, SpaceObject::none(), false,
             kMessageColor);
@@ -153,7 +235,33 @@ void Messages::clear() {
     long_message_data->labelMessageID->set_keep_on_screen_anyway(true);
 }
 
-void Messages::add(pn::string_view message) { message_data.emplace(message.copy()); }
+// The long message's teletype text is only drawn, so it's left as it is; everything that decides
+// which page is showing, and so what message conditions see, is copied.
+void Messages::snapshot(SnapshotArchive& a) {
+    a.value(time_count);
+    message_data.snapshot(a);
+
+    longMessageType* m = long_message_data;
+    a.value(m->stage);
+    a.value(m->teletype_tick);
+    bool    has_start_id = m->start_id.has_value();
+    int64_t start_id     = m->start_id.value_or(0);
+    a.value(has_start_id);
+    a.value(start_id);
+    m->start_id = has_start_id ? sfz::make_optional(start_id) : sfz::nullopt;
+    a.value(m->pages);
+    a.value(m->current_page_index);
+    a.value(m->last_page_index);
+    a.value(m->backColor);
+    a.string(m->text);
+    a.value(m->needs_layout);
+    a.value(m->retro_origin);
+    a.value(m->labelMessage);
+    a.value(m->lastLabelMessage);
+    a.value(m->labelMessageID);
+}
+
+void Messages::add(pn::string_view message) { message_data.push(message); }
 
 void Messages::start(sfz::optional<int64_t> start_id, const std::vector<pn::string>* pages) {
     longMessageType* m = long_message_data;
@@ -169,6 +277,7 @@ void Messages::start(sfz::optional<int64_t> start_id, const std::vector<pn::stri
 }
 
 void Messages::clip() {
+    PhaseTimer timer(TickPhase::MESSAGES);
     longMessageType* m = long_message_data;
     if (!m->was_updated()) {
         return;
@@ -180,14 +289,34 @@ void Messages::clip() {
         return;
     }
 
-    pn::string text = (*m->pages)[m->current_page_index].copy();
-    Replace_KeyCode_Strings_With_Actual_Key_Names(text, KEY_LONG_NAMES, 0);
-    if (*text.begin() == pn::rune{'#'}) {
-        m->labelMessage = true;
-    } else {
-        m->labelMessage = false;
+    pn::string_view page = (*m->pages)[m->current_page_index];
+    m->labelMessage      = !page.empty() && (*page.begin() == pn::rune{'#'});
+    m->needs_layout      = true;
+    m->stage             = kShowStage;
+}
+
+// Lays out the status that set_status() chose and the page that clip() chose. Only drawing needs
+// the layout, so it's left for the presentation of the tick, and runs that only simulate never
+// allocate for it.
+void Messages::layout() {
+    if (pending_status.has_value()) {
+        g.status_label->text() = StyledText::plain(
+                *pending_status, sys.fonts.tactical,
+                GetRGBTranslateColorShade(pending_status_hue, LIGHTEST));
+        pending_status.reset();
     }
 
+    longMessageType* m = long_message_data;
+    if (!m->needs_layout) {
+        return;
+    }
+    m->needs_layout = false;
+    if (!m->have_current() || (m->stage != kShowStage)) {
+        return;
+    }
+
+    pn::string text = (*m->pages)[m->current_page_index].copy();
+    Replace_KeyCode_Strings_With_Actual_Key_Names(text, KEY_LONG_NAMES, 0);
     m->retro_text = StyledText::retro(
             text,
             {sys.fonts.tactical,
@@ -201,11 +330,13 @@ void Messages::clip() {
 
     if (!m->labelMessage) {
         g.bottom_border = m->retro_text.height() + kLongMessageVPadDouble;
+    } else if (!m->retro_text.empty()) {
+        MessageLabel_Set_Special(m->labelMessageID, m->text);
     }
-    m->stage = kShowStage;
 }
 
 void Messages::draw_long_message(ticks time_pass) {
+    PhaseTimer timer(TickPhase::MESSAGES);
     longMessageType* m = long_message_data;
 
     if (m->was_updated()) {
@@ -224,14 +355,9 @@ void Messages::draw_long_message(ticks time_pass) {
             m->labelMessageID->set_age(kMinorTick);
         }
 
-        // draw in offscreen world
-        if (m->have_current() && (m->stage == kShowStage)) {
-            if (!m->retro_text.empty()) {
-                if (m->labelMessage) {
-                    m->labelMessageID->set_age(ticks(0));
-                    MessageLabel_Set_Special(m->labelMessageID, m->text);
-                }
-            }
+        // The label's text is set by layout().
+        if (m->have_current() && (m->stage == kShowStage) && m->labelMessage) {
+            m->labelMessageID->set_age(ticks(0));
         }
         if ((m->stage == kShowStage) || !m->have_current()) {
             m->last_page_index  = m->current_page_index;
@@ -288,6 +414,7 @@ void Messages::replay() {
 // WARNING: RELIES ON kMessageNullCharacter (SPACE CHARACTER #32) >> NOT WORLD-READY <<
 
 void Messages::draw_message_screen(ticks by_units) {
+    PhaseTimer timer(TickPhase::MESSAGES);
     // increase the amount of time current message has been shown
     time_count += by_units;
 
@@ -311,8 +438,12 @@ void Messages::draw_message_screen(ticks by_units) {
                     viewport().bottom - (kMessageDisplayTime - time_count).count());
         }
 
-        g.message_label->text() = StyledText::plain(
-                message, sys.fonts.tactical, GetRGBTranslateColorShade(kMessageColor, LIGHTEST));
+        if (!message_data.shown) {
+            g.message_label->text() = StyledText::plain(
+                    message, sys.fonts.tactical,
+                    GetRGBTranslateColorShade(kMessageColor, LIGHTEST));
+            message_data.shown = true;
+        }
     } else {
         g.message_label->text() = StyledText{};
         time_count              = ticks(0);
@@ -321,9 +452,9 @@ void Messages::draw_message_screen(ticks by_units) {
 
 void Messages::set_status(pn::string_view status, Hue hue) {
     g.status_label->set_hue(hue);
-    g.status_label->text() = StyledText::plain(
-            status, sys.fonts.tactical, GetRGBTranslateColorShade(hue, LIGHTEST));
     g.status_label->set_age(kStatusLabelAge);
+    pending_status.emplace(status);
+    pending_status_hue = hue;
 }
 
 void Messages::zoom(Zoom zoom) {
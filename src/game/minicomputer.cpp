@@ -35,6 +35,8 @@
 #include "game/level.hpp"
 #include "game/messages.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
@@ -582,6 +584,7 @@ static void update_status_screen_lines() {
 
 // only for updating volitile lines--doesn't draw whole screen!
 void UpdateMiniScreenLines() {
+    PhaseTimer timer(TickPhase::MINICOMPUTER);
     switch (g.mini.currentScreen) {
         case Screen::BUILD: update_build_screen_lines(); break;
         case Screen::STATUS: update_status_screen_lines(); break;
@@ -1124,10 +1127,12 @@ void MiniComputerMakeStatusString(int32_t which_line, pn::string& string) {
             break;
 
         case kIntegerValue:
-        case kIntegerMinusValue: string += pn::dump(line.value, pn::dump_short); break;
+        case kIntegerMinusValue: string += tick_arena.dump(line.value); break;
 
         case kSmallFixedValue:
-        case kSmallFixedMinusValue: string += stringify(Fixed::from_val(line.value)); break;
+        case kSmallFixedMinusValue:
+            string += stringify(Fixed::from_val(line.value), &tick_arena);
+            break;
     }
     if (line.statusType != kPlainTextStatus) {
         string += line.postString;
@@ -1293,6 +1298,56 @@ void MiniComputerHandleMouseStillDown(Point where) {
 }
 
 // for ambrosia tutorial, a horrific hack
+static void snapshot(SnapshotArchive& a, MiniLine& line) {
+    a.value(line.kind);
+    a.string(line.string);
+    a.string(line.statusFalse);
+    a.string(line.statusTrue);
+    a.string(line.statusString);
+    a.string(line.postString);
+    a.value(line.underline);
+    a.value(line.value);
+    a.value(line.statusType);
+    a.value(line.condition);
+    a.value(line.counter);
+    a.value(line.negativeValue);
+    a.value(line.sourceData);
+}
+
+static void snapshot(SnapshotArchive& a, MiniButton& button) {
+    a.value(button.kind);
+    a.string(button.string);
+    a.value(button.whichButton);
+}
+
+// A line's callback can't be copied, but it only depends on the screen and the line, so a restore
+// that changes screens rebuilds the new screen first, then copies everything else over it.
+void minicomputer_snapshot(SnapshotArchive& a) {
+    Screen screen = g.mini.currentScreen;
+    a.value(screen);
+    bool has_lines = g.mini.lines != nullptr;
+    a.value(has_lines);
+    if (has_lines && !a.saving() && (screen != g.mini.currentScreen)) {
+        switch (screen) {
+            case Screen::BUILD: show_build_screen(g.admiral, nullptr); break;
+            case Screen::SPECIAL: show_special_screen(g.admiral, nullptr); break;
+            case Screen::MESSAGE: show_message_screen(g.admiral, nullptr); break;
+            case Screen::STATUS: show_status_screen(g.admiral, nullptr); break;
+            default: show_main_screen(g.admiral); break;
+        }
+    }
+    g.mini.currentScreen = screen;
+    a.value(g.mini.selectLine);
+    a.value(g.mini.clickLine);
+    if (has_lines) {
+        for (int32_t i = 0; i < kMiniScreenCharHeight; ++i) {
+            snapshot(a, g.mini.lines[i]);
+        }
+        snapshot(a, *g.mini.accept);
+        snapshot(a, *g.mini.cancel);
+    }
+}
+
 void MiniComputer_SetScreenAndLineHack(Screen whichScreen, int32_t whichLine) {
     Point w;
 
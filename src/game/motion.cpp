@@ -18,6 +18,12 @@
 
 #include "game/motion.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "data/base-object.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
@@ -27,6 +33,7 @@
 #include "game/globals.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
 #include "game/space-object.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
@@ -67,70 +74,347 @@ const Rect    kThinkiverse{
 //     2 3 4
 //
 // The point of this is, if we iterate through a grid such as
-// {near,far}_objects, and at each cell, check the cell at each of these
+// {near,far}_index, and at each cell, check the cell at each of these
 // relative locations, we will make a pairwise comparison between all
 // adjacent cells exactly once.
-//
-// make_adjacent_cells turns the relative locations to absolute indices,
-// and keeps that information in kAdjacentCells[k].  If the relative
-// location would be outside the 16x16 grid of near_object, then
-// super_offset gets added to the object in question’s super location.
-// An object is only really in a cell if the super location matches too.
 const static Point kAdjacentUnits[] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+const int32_t      kAdjacentUnitCount = 5;
+
+static int proximity_index(int32_t x, int32_t y) { return (y << PROXIMITY_GRID_SHIFT) + x; }
+
+// The cell that `coord` falls in, on a grid of `size`-unit cells.
+//
+// Objects used to be bucketed into a 16x16 grid that wrapped around, by `(coord / size) & 0xf`,
+// plus a "super" cell of `coord / (size * 16)` to tell apart objects that landed in the same
+// bucket. This combines the two, which is the same as `coord / size` except for negative coords.
+static int32_t grid_cell(int32_t coord, int32_t size) {
+    return ((coord / (size * PROXIMITY_GRID_WIDTH)) * PROXIMITY_GRID_WIDTH) +
+           ((coord / size) & PROXIMITY_GRID_MASK);
+}
+
+// Spreads the low 32 bits of `x` out to the even bits of the result.
+static uint64_t spread_bits(uint32_t x) {
+    uint64_t r = x;
+    r          = (r | (r << 16)) & 0x0000ffff0000ffffull;
+    r          = (r | (r << 8)) & 0x00ff00ff00ff00ffull;
+    r          = (r | (r << 4)) & 0x0f0f0f0f0f0f0f0full;
+    r          = (r | (r << 2)) & 0x3333333333333333ull;
+    r          = (r | (r << 1)) & 0x5555555555555555ull;
+    return r;
+}
+
+// Finds pairs of objects in the same or adjacent grid cells.
+//
+// This is a uniform grid, stored sparsely: objects are sorted by the Morton code of their cell,
+// so the objects in any one cell are contiguous, and a cell's neighbors are found by binary
+// search. Only occupied cells take any space, and objects far apart never share a bucket, as they
+// did when the 16x16 grid wrapped around.
+//
+// Cells are all the same size and are never split, so every pair within a cell and its neighbors
+// is visited: n objects crowded into one cell make O(n²) pairs. The grid's pair order has to be
+// kept (see for_each_pair()), so a crowded cell can't simply be subdivided; SweepAndPrune, which
+// skips pairs whose bounds don't overlap, is the broadphase for crowded levels.
+class ProximityIndex {
+  public:
+    void clear() { _entries.clear(); }
+
+    void add(const Handle<SpaceObject>& o, int32_t h, int32_t v) {
+        _entries.push_back(Entry{cell_key(h, v), o->_age_index, h, v, o});
+    }
+
+    // Calls `visit(a, b, k)` for each pair of objects where b's cell is kAdjacentUnits[k] from
+    // a's, and returns the number of pairs. When k is 0, they share a cell and b is newer.
+    //
+    // Pairs are visited in the order of the old wrapping grid, because whatever `visit` does to
+    // one pair can affect the next. That grid went through its 256 buckets in order, through
+    // each bucket oldest first, and then through each adjacent bucket oldest first.
+    template <typename Visit>
+    int32_t for_each_pair(Visit visit) {
+        std::sort(_entries.begin(), _entries.end(), [](const Entry& x, const Entry& y) {
+            return (x.key < y.key) || ((x.key == y.key) && (x.age < y.age));
+        });
+        _order.resize(_entries.size());
+        for (int32_t i = 0; i < _order.size(); ++i) {
+            _order[i] = i;
+        }
+        std::sort(_order.begin(), _order.end(), [this](int32_t x, int32_t y) {
+            int32_t x_bucket = bucket(_entries[x]);
+            int32_t y_bucket = bucket(_entries[y]);
+            return (x_bucket < y_bucket) ||
+                   ((x_bucket == y_bucket) && (_entries[x].age < _entries[y].age));
+        });
+
+        int32_t pairs = 0;
+        for (int32_t i : _order) {
+            const Entry& a = _entries[i];
+            for (int32_t k = 0; k < kAdjacentUnitCount; ++k) {
+                auto range = cell(a.h + kAdjacentUnits[k].h, a.v + kAdjacentUnits[k].v);
+                if (k == 0) {
+                    range.first = _entries.begin() + i + 1;
+                }
+                for (auto b = range.first; b != range.second; ++b) {
+                    ++pairs;
+                    visit(a.object, b->object, k);
+                }
+            }
+        }
+        return pairs;
+    }
 
-struct AdjacentCells {
-    struct AdjacentCell {
-        uint8_t index_offset;  // the normal adjacent unit
-        Point   super_offset;  // the offset of the super unit (for wrap-around)
+  private:
+    struct Entry {
+        uint64_t            key;  // Morton code of the cell.
+        int32_t             age;  // SpaceObject::_age_index.
+        int32_t             h, v;
+        Handle<SpaceObject> object;
     };
 
-    static const int size  = 5;
-    using AdjacentCellList = AdjacentCell[AdjacentCells::size];
+    static uint64_t cell_key(int32_t h, int32_t v) {
+        // Cells are under 2^25 from zero, so the bias makes them positive.
+        return spread_bits(h + (1 << 25)) | (spread_bits(v + (1 << 25)) << 1);
+    }
+
+    static int32_t bucket(const Entry& e) {
+        return proximity_index(e.h & PROXIMITY_GRID_MASK, e.v & PROXIMITY_GRID_MASK);
+    }
+
+    std::pair<std::vector<Entry>::iterator, std::vector<Entry>::iterator> cell(
+            int32_t h, int32_t v) {
+        uint64_t key   = cell_key(h, v);
+        auto     first = std::lower_bound(
+                _entries.begin(), _entries.end(), key,
+                [](const Entry& e, uint64_t key) { return e.key < key; });
+        auto last = first;
+        while ((last != _entries.end()) && (last->key == key)) {
+            ++last;
+        }
+        return std::make_pair(first, last);
+    }
 
-    AdjacentCellList at[PROXIMITY_GRID_AREA];
+    std::vector<Entry>   _entries;
+    std::vector<int32_t> _order;
 };
 
-static int proximity_index(int32_t x, int32_t y) { return (y << PROXIMITY_GRID_SHIFT) + x; }
+// Finds pairs of objects whose bounds overlap, by sorting them along the horizontal axis and
+// sweeping across them.
+//
+// The sorted order is kept from one tick to the next. Objects only move a little in a tick, so
+// last tick's order is nearly right, and an insertion sort puts it back in order in close to
+// linear time. Pairs are only reported if their grid cells are adjacent, and are visited in the
+// same order that ProximityIndex visits them, so that the two can be compared.
+//
+// A collision can push its two objects into others that they didn't overlap when the sweep ran.
+// After each visit, an object that moved is tested again against every entry, and any pair it
+// now makes that's still to come in the order is added, so the same pairs are visited as with
+// ProximityIndex.
+class SweepAndPrune {
+  public:
+    void clear() { _added.clear(); }
+
+    void add(const Handle<SpaceObject>& o, int32_t h, int32_t v) {
+        _added.push_back(Added{o, h, v});
+    }
 
-static AdjacentCells make_adjacent_cells() {
-    // initialize the proximityGrid & set up the needed lookups (see Notebook 2 p.34)
-    AdjacentCells a;
-    for (int y = 0; y < PROXIMITY_GRID_WIDTH; y++) {
-        for (int x = 0; x < PROXIMITY_GRID_WIDTH; x++) {
-            int   i     = proximity_index(x, y);
-            auto* cells = a.at[i];
-            for (int i = 0; i < AdjacentCells::size; i++) {
-                auto*   cell         = &cells[i];
-                int32_t ux           = x;
-                int32_t uy           = y;
-                cell->super_offset.h = cell->super_offset.v = 0;
-
-                ux += kAdjacentUnits[i].h;
-                if (ux < 0) {
-                    ux += PROXIMITY_GRID_WIDTH;
-                    cell->super_offset.h = -1;
-                } else if (ux >= PROXIMITY_GRID_WIDTH) {
-                    ux -= PROXIMITY_GRID_WIDTH;
-                    cell->super_offset.h = +1;
+    // Like ProximityIndex::for_each_pair(), but skips pairs whose bounds don't overlap.
+    template <typename Visit>
+    int32_t for_each_pair(Visit visit) {
+        update();
+        sort();
+
+        _pairs.clear();
+        for (int32_t i = 0; i < _entries.size(); ++i) {
+            const Entry& a = _entries[i];
+            for (int32_t j = i + 1; j < _entries.size(); ++j) {
+                const Entry& b = _entries[j];
+                if (b.left > a.right) {
+                    break;
+                } else if ((b.top <= a.bottom) && (a.top <= b.bottom)) {
+                    add_pair(a, b);
                 }
+            }
+        }
+
+        std::sort(_pairs.begin(), _pairs.end(), pair_less);
+        for (int32_t i = 0; i < _entries.size(); ++i) {
+            _slots[_entries[i].object.number()] = i;
+        }
+        for (int32_t i = 0; i < _pairs.size(); ++i) {
+            const Pair p = _pairs[i];  // Copied; rechecking can grow _pairs.
+            visit(p.a, p.b, p.k);
+            recheck(p.a, i);
+            recheck(p.b, i);
+        }
+        for (const Entry& e : _entries) {
+            _slots[e.object.number()] = -1;
+        }
+        return _pairs.size();
+    }
+
+  private:
+    struct Added {
+        Handle<SpaceObject> object;
+        int32_t             h, v;  // Grid cell.
+    };
+
+    struct Entry {
+        int32_t             left, right, top, bottom;  // Inclusive.
+        int32_t             age;                       // SpaceObject::_age_index.
+        int32_t             h, v;                      // Grid cell.
+        Handle<SpaceObject> object;
+    };
 
-                uy += kAdjacentUnits[i].v;
-                if (uy < 0) {
-                    uy += PROXIMITY_GRID_WIDTH;
-                    cell->super_offset.v = -1;
-                } else if (uy >= PROXIMITY_GRID_WIDTH) {
-                    uy -= PROXIMITY_GRID_WIDTH;
-                    cell->super_offset.v = +1;
+    struct Pair {
+        int32_t             bucket, a_age, k, b_age;
+        Handle<SpaceObject> a, b;
+    };
+
+    static Entry entry(const Added& x) {
+        const SpaceObject& o = *x.object;
+        Entry              e;
+        if (o.attributes & kIsVector) {
+            // A vector hits whatever lies along its path from its last location.
+            const Point& last = o.frame.vector->lastGlobalLocation;
+            e.left            = std::min(o.location.h, last.h);
+            e.right           = std::max(o.location.h, last.h);
+            e.top             = std::min(o.location.v, last.v);
+            e.bottom          = std::max(o.location.v, last.v);
+        } else {
+            e.left   = o.absoluteBounds.left;
+            e.right  = o.absoluteBounds.right;
+            e.top    = o.absoluteBounds.top;
+            e.bottom = o.absoluteBounds.bottom;
+        }
+        e.age    = o._age_index;
+        e.h      = x.h;
+        e.v      = x.v;
+        e.object = x.object;
+        return e;
+    }
+
+    // Refreshes the entries of objects added this tick, drops the rest, and appends new ones.
+    void update() {
+        _slots.resize(g.objects.size(), -1);
+        for (int32_t i = 0; i < _added.size(); ++i) {
+            _slots[_added[i].object.number()] = i;
+        }
+
+        int32_t kept = 0;
+        for (const Entry& e : _entries) {
+            int32_t& slot = _slots[e.object.number()];
+            if (slot >= 0) {
+                _entries[kept++] = entry(_added[slot]);
+                slot             = -1;
+            }
+        }
+        _entries.resize(kept);
+
+        for (const Added& x : _added) {
+            int32_t& slot = _slots[x.object.number()];
+            if (slot >= 0) {
+                _entries.push_back(entry(x));
+                slot = -1;
+            }
+        }
+    }
+
+    void sort() {
+        for (int32_t i = 1; i < _entries.size(); ++i) {
+            Entry   e = _entries[i];
+            int32_t j = i;
+            for (; (j > 0) && (_entries[j - 1].left > e.left); --j) {
+                _entries[j] = _entries[j - 1];
+            }
+            _entries[j] = e;
+        }
+    }
+
+    static bool pair_less(const Pair& x, const Pair& y) {
+        return std::tie(x.bucket, x.a_age, x.k, x.b_age) <
+               std::tie(y.bucket, y.a_age, y.k, y.b_age);
+    }
+
+    static bool overlaps(const Entry& a, const Entry& b) {
+        return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+               (b.top <= a.bottom);
+    }
+
+    // Sets `pair` to `a` and `b` and returns true if their cells are adjacent, as the grid would
+    // have seen them: from the older object if they share a cell, or else from the one b is
+    // ahead of.
+    static bool make_pair(const Entry& a, const Entry& b, Pair* pair) {
+        const Entry* x = &a;
+        const Entry* y = &b;
+        if ((a.h == b.h) && (a.v == b.v) && (b.age < a.age)) {
+            std::swap(x, y);
+        }
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int32_t k = 0; k < kAdjacentUnitCount; ++k) {
+                if ((y->h - x->h == kAdjacentUnits[k].h) && (y->v - x->v == kAdjacentUnits[k].v)) {
+                    int32_t bucket = proximity_index(
+                            x->h & PROXIMITY_GRID_MASK, x->v & PROXIMITY_GRID_MASK);
+                    *pair = Pair{bucket, x->age, k, y->age, x->object, y->object};
+                    return true;
                 }
+            }
+            std::swap(x, y);
+        }
+        return false;
+    }
+
+    void add_pair(const Entry& a, const Entry& b) {
+        Pair p;
+        if (make_pair(a, b, &p)) {
+            _pairs.push_back(p);
+        }
+    }
 
-                cells[i].index_offset = proximity_index(ux, uy);
+    // If the visit of _pairs[i] pushed `o` (only pushes move bounds during collision), refreshes
+    // its entry, and adds the pairs it now overlaps that come after _pairs[i] and aren't there.
+    void recheck(const Handle<SpaceObject>& o, int32_t i) {
+        int32_t slot = _slots[o.number()];
+        Entry&  e    = _entries[slot];
+        Entry   now  = entry(Added{o, e.h, e.v});
+        if ((now.left == e.left) && (now.right == e.right) && (now.top == e.top) &&
+            (now.bottom == e.bottom)) {
+            return;
+        }
+        e = now;
+
+        for (int32_t j = 0; j < _entries.size(); ++j) {
+            Pair p;
+            if ((j == slot) || !overlaps(e, _entries[j]) || !make_pair(e, _entries[j], &p) ||
+                !pair_less(_pairs[i], p)) {
+                continue;
+            }
+            auto at = std::lower_bound(_pairs.begin() + i + 1, _pairs.end(), p, pair_less);
+            if ((at == _pairs.end()) || pair_less(p, *at)) {
+                _pairs.insert(at, p);
             }
         }
     }
-    return a;
-}
 
-static const AdjacentCells kAdjacentCells = make_adjacent_cells();
+    std::vector<Added>   _added;
+    std::vector<Entry>   _entries;  // Sorted by left edge.
+    std::vector<int32_t> _slots;    // By object number: index in _added, or -1.
+    std::vector<Pair>    _pairs;
+};
+
+static ProximityIndex near_index;  // SUBSECTOR cells; for collisions.
+static ProximityIndex far_index;   // SECTOR_MEDIUM cells; for locality.
+static SweepAndPrune  near_sweep;  // SUBSECTOR cells; for collisions, if Broadphase::SWEEP.
+
+ANTARES_GLOBAL CollisionStats collision_stats;
+ANTARES_GLOBAL Broadphase     broadphase = Broadphase::GRID;
+
+void broadphase_option(pn::string_view value, Broadphase* out) {
+    if (value == "grid") {
+        *out = Broadphase::GRID;
+    } else if (value == "sweep") {
+        *out = Broadphase::SWEEP;
+    } else {
+        throw std::runtime_error(pn::format("invalid broadphase: {0}", value).c_str());
+    }
+}
 
 ANTARES_GLOBAL ScaledScreen scaled_screen;
 
@@ -148,9 +432,10 @@ void ResetMotionGlobals() {
     g.farthest           = Handle<SpaceObject>(0);
 }
 
-static void move_object(SpaceObject* o) {
+// Applies turning and thrust to `o`. Returns false if `o` doesn't move at all.
+static bool steer_object(SpaceObject* o) {
     if ((o->maxVelocity == Fixed::zero()) && !(o->attributes & kCanTurn)) {
-        return;
+        return false;
     }
 
     if (o->attributes & kCanTurn) {
@@ -235,27 +520,78 @@ static void move_object(SpaceObject* o) {
         o->velocity.h += fa;
         o->velocity.v += fb;
     }
+    return true;
+}
 
-    o->motionFraction.h += o->velocity.h;
-    o->motionFraction.v += o->velocity.v;
+// Rounds a motion fraction to the nearest whole unit, rounding halves up.
+//
+// This used to be written as two cases, `more_evil_fixed_to_long(f + 0.5)` for positive `f` and
+// `more_evil_fixed_to_long(f - 0.5) + 1` for negative `f`, but since `>> 8` floors, both cases
+// reduce to the same expression; having no branch lets the integration loop vectorize.
+static int32_t round_motion(Fixed f) {
+    return more_evil_fixed_to_long(f + Fixed::from_float(0.5));
+}
 
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
+// The fields that motion integration reads and writes, copied out of every moving object into
+// parallel arrays, so that integration is a tight loop over contiguous data.
+struct MotionArrays {
+    std::vector<SpaceObject*> objects;
+    std::vector<Fixed>        velocity_h, velocity_v;
+    std::vector<Fixed>        fraction_h, fraction_v;
+    std::vector<int32_t>      location_h, location_v;
+    std::vector<Point>        tick_start;  // By object number: location before this tick.
+
+    void clear() {
+        objects.clear();
+        velocity_h.clear();
+        velocity_v.clear();
+        fraction_h.clear();
+        fraction_v.clear();
+        location_h.clear();
+        location_v.clear();
     }
-    o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
 
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
+    void add(SpaceObject* o) {
+        objects.push_back(o);
+        velocity_h.push_back(o->velocity.h);
+        velocity_v.push_back(o->velocity.v);
+        fraction_h.push_back(o->motionFraction.h);
+        fraction_v.push_back(o->motionFraction.v);
+        location_h.push_back(o->location.h);
+        location_v.push_back(o->location.v);
     }
-    o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
+
+    void integrate() {
+        const int32_t size = objects.size();
+        for (int32_t i = 0; i < size; ++i) {
+            fraction_h[i] += velocity_h[i];
+            fraction_v[i] += velocity_v[i];
+            int32_t h = round_motion(fraction_h[i]);
+            int32_t v = round_motion(fraction_v[i]);
+            location_h[i] -= h;
+            location_v[i] -= v;
+            fraction_h[i] -= Fixed::from_long(h);
+            fraction_v[i] -= Fixed::from_long(v);
+        }
+
+        for (int32_t i = 0; i < size; ++i) {
+            SpaceObject* o      = objects[i];
+            o->motionFraction.h = fraction_h[i];
+            o->motionFraction.v = fraction_v[i];
+            o->location.h       = location_h[i];
+            o->location.v       = location_v[i];
+        }
+    }
+};
+static MotionArrays motion;
+
+// Objects used to be moved one at a time, in SpaceObject::by_age() order, so an object saw
+// the objects newer than itself after they had moved this tick, and older ones before.
+static Point seen_location(const SpaceObject& o, const SpaceObject& target) {
+    if (target._age_index < o._age_index) {
+        return motion.tick_start[target.number()];
+    }
+    return target.location;
 }
 
 static void bounce_object(SpaceObject* o) {
@@ -318,8 +654,8 @@ static void move_vector(SpaceObject* o) {
     } else if (!vector.to_coord) {
         if (vector.toObject.get()) {
             auto target = vector.toObject;
-            if (target->active && (target->id == vector.toObjectID)) {
-                o->location = vector.objectLocation = target->location;
+            if (!target.expired()) {
+                o->location = vector.objectLocation = seen_location(*o, *target);
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -327,8 +663,9 @@ static void move_vector(SpaceObject* o) {
 
         if (vector.fromObject.get()) {
             auto target = vector.fromObject;
-            if (target->active && (target->id == vector.fromObjectID)) {
-                vector.lastGlobalLocation = vector.lastApparentLocation = target->location;
+            if (!target.expired()) {
+                vector.lastGlobalLocation = vector.lastApparentLocation =
+                        seen_location(*o, *target);
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -336,12 +673,11 @@ static void move_vector(SpaceObject* o) {
     } else if (vector.to_coord) {
         if (vector.fromObject.get()) {
             auto target = vector.fromObject;
-            if (target->active && (target->id == vector.fromObjectID)) {
-                vector.lastGlobalLocation = vector.lastApparentLocation = target->location;
-                o->location.h                                           = vector.objectLocation.h =
-                        target->location.h + vector.toRelativeCoord.h;
-                o->location.v = vector.objectLocation.v =
-                        target->location.v + vector.toRelativeCoord.v;
+            if (!target.expired()) {
+                Point location            = seen_location(*o, *target);
+                vector.lastGlobalLocation = vector.lastApparentLocation = location;
+                o->location.h = vector.objectLocation.h = location.h + vector.toRelativeCoord.h;
+                o->location.v = vector.objectLocation.v = location.v + vector.toRelativeCoord.v;
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -397,19 +733,33 @@ static void update_static(SpaceObject* o, ticks unitsToDo) {
 }
 
 void MoveSpaceObjects(const ticks unitsToDo) {
+    PhaseTimer timer(TickPhase::MOVE);
     if (unitsToDo == ticks(0)) {
         return;
     }
 
+    motion.tick_start.resize(g.objects.size());
     for (ticks jl = ticks(0); jl < unitsToDo; jl++) {
-        SpaceObject* o = nullptr;
-        for (Handle<SpaceObject> o_handle = g.root; (o = o_handle.get());
-             o_handle                     = o->nextObject) {
+        // Each object's motion depends only on its own state, so steering, integration, and
+        // bouncing can each run as a separate pass. Only rays look at other objects, through
+        // seen_location().
+        motion.clear();
+        for (auto o_handle : SpaceObject::by_age()) {
+            SpaceObject* o                 = o_handle.get();
+            motion.tick_start[o->number()] = o->location;
+            if ((o->active == kObjectInUse) && steer_object(o)) {
+                motion.add(o);
+            }
+        }
+
+        motion.integrate();
+
+        for (auto o_handle : SpaceObject::by_age()) {
+            SpaceObject* o = o_handle.get();
             if (o->active != kObjectInUse) {
                 continue;
             }
 
-            move_object(o);
             bounce_object(o);
             if (o->attributes & kIsSelfAnimated) {
                 animate_object(o);
@@ -436,8 +786,8 @@ void MoveSpaceObjects(const ticks unitsToDo) {
     // nothing below can effect any object actions (expire actions get executed)
     // (but they can effect objects thinking)
     // !!!!!!!!
-    SpaceObject* o = nullptr;
-    for (Handle<SpaceObject> o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+    for (auto o_handle : SpaceObject::by_age()) {
+        SpaceObject* o = o_handle.get();
         if (o->active != kObjectInUse) {
             continue;
         } else if ((o->attributes & kIsVector) || !o->sprite.get()) {
@@ -486,21 +836,21 @@ static void activate_object(const Handle<SpaceObject>& o) {
     }
 }
 
-static void calc_misc(
-        Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA],
-        Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA]) {
+static void calc_misc() {
     // set up player info so we can find closest ship (for scaling)
     uint64_t farthestDist = 0;
     uint64_t closestDist  = 0x7fffffffffffffffull;
     g.closest = g.farthest = Handle<SpaceObject>(0);
 
-    // reset the collision grid
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        near_objects[i] = far_objects[i] = SpaceObject::none();
-    }
+    // reset the collision grid. Admiral::think() still walks the old far grid's lists, through
+    // nextFarObject, to find the strength around its targets, so those are still linked.
+    near_index.clear();
+    near_sweep.clear();
+    far_index.clear();
+    Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA];
 
-    SpaceObject* o = nullptr;
-    for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+    for (auto o_handle : SpaceObject::by_age()) {
+        SpaceObject* o = o_handle.get();
         if (!o->active) {
             if (g.ship.get() && g.ship->active) {
                 o->distanceFromPlayer = 0x7fffffffffffffffull;
@@ -508,7 +858,8 @@ static void calc_misc(
         }
     }
 
-    for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+    for (auto o_handle : SpaceObject::by_age()) {
+        SpaceObject* o = o_handle.get();
         if (!o->active) {
             continue;
         }
@@ -551,15 +902,15 @@ static void calc_misc(
             o->absoluteBounds.right = o->absoluteBounds.left = 0;
 
             const auto& loc = o->location;
-            {
-                auto* near_object = &near_objects[proximity_index(
-                        (loc.h / SUBSECTOR) & PROXIMITY_GRID_MASK,
-                        (loc.v / SUBSECTOR) & PROXIMITY_GRID_MASK)];
-                o->nextNearObject = *near_object;
-                *near_object      = o_handle;
-
-                o->collisionGrid = {loc.h / SECTOR_MEDIUM, loc.v / SECTOR_MEDIUM};
+            const int32_t near_h = grid_cell(loc.h, SUBSECTOR);
+            const int32_t near_v = grid_cell(loc.v, SUBSECTOR);
+            if (broadphase == Broadphase::SWEEP) {
+                near_sweep.add(o_handle, near_h, near_v);
+            } else {
+                near_index.add(o_handle, near_h, near_v);
             }
+            far_index.add(
+                    o_handle, grid_cell(loc.h, SECTOR_MEDIUM), grid_cell(loc.v, SECTOR_MEDIUM));
 
             {
                 auto* far_object = &far_objects[proximity_index(
@@ -694,8 +1045,8 @@ static bool vector_intersects(const SpaceObject& vector, const SpaceObject& targ
 
 // Set absoluteBounds on all objects.
 static void calc_bounds() {
-    SpaceObject* o = nullptr;
-    for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+    for (auto o_handle : SpaceObject::by_age()) {
+        SpaceObject* o = o_handle.get();
         if ((o->absoluteBounds.left >= o->absoluteBounds.right) && o->sprite.get()) {
             const NatePixTable::Frame& frame = o->sprite->table->at(o->sprite->whichShape);
             o->absoluteBounds = scale_sprite_rect(frame, o->location, o->naturalScale);
@@ -707,54 +1058,35 @@ static bool can_hit(const SpaceObject& a, const SpaceObject& b) {
     return (a.attributes & kCanCollide) && (b.attributes & kCanBeHit);
 }
 
-// Call HitObject() and CorrectPhysicalSpace() for all colliding pairs of objects.
-static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA]) {
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        const auto*  cells = kAdjacentCells.at[i];
-        SpaceObject* a     = nullptr;
-        for (auto a_handle = near_objects[i]; (a = a_handle.get()); a_handle = a->nextNearObject) {
-            for (int32_t k = 0; k < AdjacentCells::size; k++) {
-                Handle<SpaceObject> b_handle = a->nextNearObject;
-                Point               super    = a->collisionGrid;
-                if (k > 0) {
-                    const auto& adj = cells[k];
-                    b_handle        = near_objects[adj.index_offset];
-                    super.offset(adj.super_offset.h, adj.super_offset.v);
-                }
-
-                SpaceObject* b = nullptr;
-                for (; (b = b_handle.get()); b_handle = b->nextNearObject) {
-                    if ((!can_hit(*a, *b) &&
-                         !can_hit(*b, *a)) ||           // neither object can hit the other
-                        (b->collisionGrid != super) ||  // not near enough
-                        (a->owner == b->owner)) {       // same owner
-                        continue;
-                    }
-
-                    if (a->attributes & b->attributes & kIsVector) {
-                        // no reason vectors can't intersect, but the
-                        // code we have now won't handle it.
-                        continue;
-                    } else if (a->attributes & kIsVector) {
-                        if (vector_intersects(*a, *b)) {
-                            HitObject(b_handle, a_handle);
-                        }
-                        continue;
-                    } else if (b->attributes & kIsVector) {
-                        if (vector_intersects(*b, *a)) {
-                            HitObject(a_handle, b_handle);
-                        }
-                        continue;
-                    }
+// Call HitObject() and CorrectPhysicalSpace() if a pair of nearby objects collide.
+static void calc_impact(Handle<SpaceObject> a_handle, Handle<SpaceObject> b_handle, int32_t k) {
+    SpaceObject* a = a_handle.get();
+    SpaceObject* b = b_handle.get();
+    if ((!can_hit(*a, *b) && !can_hit(*b, *a)) ||  // neither object can hit the other
+        (a->owner == b->owner)) {                  // same owner
+        return;
+    }
 
-                    if (inclusive_intersect(a->absoluteBounds, b->absoluteBounds)) {
-                        HitObject(a_handle, b_handle);
-                        HitObject(b_handle, a_handle);
-                        correct_physical_space(a, b);
-                    }
-                }
-            }
+    if (a->attributes & b->attributes & kIsVector) {
+        // no reason vectors can't intersect, but the
+        // code we have now won't handle it.
+        return;
+    } else if (a->attributes & kIsVector) {
+        if (vector_intersects(*a, *b)) {
+            HitObject(b_handle, a_handle);
+        }
+        return;
+    } else if (b->attributes & kIsVector) {
+        if (vector_intersects(*b, *a)) {
+            HitObject(a_handle, b_handle);
         }
+        return;
+    }
+
+    if (inclusive_intersect(a->absoluteBounds, b->absoluteBounds)) {
+        HitObject(a_handle, b_handle);
+        HitObject(b_handle, a_handle);
+        correct_physical_space(a, b);
     }
 }
 
@@ -764,83 +1096,60 @@ static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA])
 //   * localFriendStrength
 //   * localFoeStrength
 // Also sets seenByPlayerFlags and kIsHidden based on object proximity.
-static void calc_locality(Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA]) {
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        const auto*  cells = kAdjacentCells.at[i];
-        SpaceObject* a     = nullptr;
-        for (auto a_handle = far_objects[i]; (a = a_handle.get()); a_handle = a->nextFarObject) {
-            for (int32_t k = 0; k < AdjacentCells::size; k++) {
-                Handle<SpaceObject> b_handle = a->nextFarObject;
-                Point               super    = a->distanceGrid;
-                if (k > 0) {
-                    const auto& adj = cells[k];
-                    b_handle        = far_objects[adj.index_offset];
-                    super.offset(adj.super_offset.h, adj.super_offset.v);
-                }
+static void calc_locality(Handle<SpaceObject> a_handle, Handle<SpaceObject> b_handle, int32_t k) {
+    SpaceObject* a = a_handle.get();
+    SpaceObject* b = b_handle.get();
+    if ((b->owner != a->owner) &&
+        ((b->attributes & kCanThink) || (b->attributes & kRemoteOrHuman) ||
+         (b->attributes & kHated)) &&
+        ((a->attributes & kCanThink) || (a->attributes & kRemoteOrHuman) ||
+         (a->attributes & kHated))) {
+        uint32_t x_dist = ABS<int>(b->location.h - a->location.h);
+        uint32_t y_dist = ABS<int>(b->location.v - a->location.v);
+        uint32_t dist;
+        if ((x_dist > kMaximumRelevantDistance) || (y_dist > kMaximumRelevantDistance)) {
+            dist = kMaximumRelevantDistanceSquared;
+        } else {
+            dist = (y_dist * y_dist) + (x_dist * x_dist);
+        }
 
-                SpaceObject* b = nullptr;
-                for (; (b = b_handle.get()); b_handle = b->nextFarObject) {
-                    if (b->distanceGrid != super) {
-                        continue;
-                    }
-                    if ((b->owner != a->owner) &&
-                        ((b->attributes & kCanThink) || (b->attributes & kRemoteOrHuman) ||
-                         (b->attributes & kHated)) &&
-                        ((a->attributes & kCanThink) || (a->attributes & kRemoteOrHuman) ||
-                         (a->attributes & kHated))) {
-                        uint32_t x_dist = ABS<int>(b->location.h - a->location.h);
-                        uint32_t y_dist = ABS<int>(b->location.v - a->location.v);
-                        uint32_t dist;
-                        if ((x_dist > kMaximumRelevantDistance) ||
-                            (y_dist > kMaximumRelevantDistance)) {
-                            dist = kMaximumRelevantDistanceSquared;
-                        } else {
-                            dist = (y_dist * y_dist) + (x_dist * x_dist);
-                        }
-
-                        if (dist < kMaximumRelevantDistanceSquared) {
-                            a->seenByPlayerFlags |= b->myPlayerFlag;
-                            b->seenByPlayerFlags |= a->myPlayerFlag;
-
-                            if (b->attributes & kHideEffect) {
-                                a->runTimeFlags |= kIsHidden;
-                            }
-
-                            if (a->attributes & kHideEffect) {
-                                b->runTimeFlags |= kIsHidden;
-                            }
-                        }
-
-                        if (a->engages(*b)) {
-                            if ((dist < a->closestDistance) &&
-                                (b->attributes & kPotentialTarget)) {
-                                a->closestDistance = dist;
-                                a->closestObject   = b_handle;
-                            }
-                        }
-
-                        if (b->engages(*a)) {
-                            if ((dist < b->closestDistance) &&
-                                (a->attributes & kPotentialTarget)) {
-                                b->closestDistance = dist;
-                                b->closestObject   = a_handle;
-                            }
-                        }
-
-                        b->localFoeStrength += a->localFriendStrength;
-                        b->localFriendStrength += a->localFoeStrength;
-                    } else if (k == 0) {
-                        if (a->owner != b->owner) {
-                            b->localFoeStrength += a->localFriendStrength;
-                            b->localFriendStrength += a->localFoeStrength;
-                        } else {
-                            b->localFoeStrength += a->localFoeStrength;
-                            b->localFriendStrength += a->localFriendStrength;
-                        }
-                    }
-                }
+        if (dist < kMaximumRelevantDistanceSquared) {
+            a->seenByPlayerFlags |= b->myPlayerFlag;
+            b->seenByPlayerFlags |= a->myPlayerFlag;
+
+            if (b->attributes & kHideEffect) {
+                a->runTimeFlags |= kIsHidden;
+            }
+
+            if (a->attributes & kHideEffect) {
+                b->runTimeFlags |= kIsHidden;
+            }
+        }
+
+        if (a->engages(*b)) {
+            if ((dist < a->closestDistance) && (b->attributes & kPotentialTarget)) {
+                a->closestDistance = dist;
+                a->closestObject   = b_handle;
             }
         }
+
+        if (b->engages(*a)) {
+            if ((dist < b->closestDistance) && (a->attributes & kPotentialTarget)) {
+                b->closestDistance = dist;
+                b->closestObject   = a_handle;
+            }
+        }
+
+        b->localFoeStrength += a->localFriendStrength;
+        b->localFriendStrength += a->localFoeStrength;
+    } else if (k == 0) {
+        if (a->owner != b->owner) {
+            b->localFoeStrength += a->localFriendStrength;
+            b->localFriendStrength += a->localFoeStrength;
+        } else {
+            b->localFoeStrength += a->localFoeStrength;
+            b->localFriendStrength += a->localFriendStrength;
+        }
     }
 }
 
@@ -848,7 +1157,7 @@ static void calc_visibility() {
     // here, it doesn't matter in what order we step through the table
     const uint32_t seen_by_me = 1ul << g.admiral.number();
 
-    for (auto o_handle : SpaceObject::all()) {
+    for (auto o_handle : SpaceObject::by_age()) {
         SpaceObject* o = o_handle.get();
         if (o->active == kObjectToBeFreed) {
             o->free();
@@ -867,10 +1176,11 @@ static void calc_visibility() {
             }
         }
     }
+    CompactActiveObjects();
 }
 
 static void update_last_vector_locations() {
-    for (auto o : SpaceObject::all()) {
+    for (auto o : SpaceObject::by_age()) {
         if (o->active == kObjectInUse) {
             if (o->attributes & kIsVector) {
                 o->frame.vector->lastGlobalLocation = o->location;
@@ -880,13 +1190,15 @@ static void update_last_vector_locations() {
 }
 
 void CollideSpaceObjects() {
-    Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA];
-    Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA];
-
-    calc_misc(near_objects, far_objects);
+    PhaseTimer timer(TickPhase::COLLIDE);
+    calc_misc();
     calc_bounds();
-    calc_impacts(near_objects);
-    calc_locality(far_objects);
+    if (broadphase == Broadphase::SWEEP) {
+        collision_stats.near_pairs = near_sweep.for_each_pair(calc_impact);
+    } else {
+        collision_stats.near_pairs = near_index.for_each_pair(calc_impact);
+    }
+    collision_stats.far_pairs  = far_index.for_each_pair(calc_locality);
     calc_visibility();
     update_last_vector_locations();
 }
@@ -19,6 +19,7 @@
 #include "game/non-player-ship.hpp"
 
 #include <pn/output>
+#include <tuple>
 
 #include "config/keys.hpp"
 #include "data/plugin.hpp"
@@ -26,14 +27,18 @@
 #include "drawing/sprite-handling.hpp"
 #include "game/action.hpp"
 #include "game/admiral.hpp"
+#include "game/condition.hpp"
 #include "game/globals.hpp"
 #include "game/level.hpp"
 #include "game/messages.hpp"
 #include "game/motion.hpp"
 #include "game/player-ship.hpp"
+#include "game/profile.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
+#include "lang/thread-pool.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -62,21 +67,21 @@ const int32_t kWarpInEnergyFactor = 3;
 static const ticks    kCollideFlashDuration = ticks{3};
 static const RgbColor kCollideFlashColor    = rgba(255, 255, 255, 127);
 
-uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObject* baseObject);
+uint32_t ThinkObjectNormalPresence(
+        SpaceObject* anObject, Handle<SpaceObject> handle, const BaseObject* baseObject);
 uint32_t ThinkObjectWarpingPresence(Handle<SpaceObject> anObject);
 uint32_t ThinkObjectWarpInPresence(Handle<SpaceObject> anObject);
 uint32_t ThinkObjectWarpOutPresence(Handle<SpaceObject> anObject, const BaseObject* baseObject);
 uint32_t ThinkObjectLandingPresence(Handle<SpaceObject> anObject);
 void     ThinkObjectGetCoordVector(
-            Handle<SpaceObject> anObject, Point* dest, uint32_t* distance, int16_t* angle);
-void ThinkObjectGetCoordDistance(Handle<SpaceObject> anObject, Point* dest, uint32_t* distance);
+            const SpaceObject* anObject, Point* dest, uint32_t* distance, int16_t* angle);
+void ThinkObjectGetCoordDistance(const SpaceObject* anObject, Point* dest, uint32_t* distance);
 void ThinkObjectResolveDestination(
         Handle<SpaceObject> anObject, Point* dest, Handle<SpaceObject>* targetObject);
 bool ThinkObjectResolveTarget(
-        Handle<SpaceObject> anObject, Point* dest, uint32_t* distance,
-        Handle<SpaceObject>* targetObject);
+        SpaceObject* anObject, Point* dest, uint32_t* distance, Handle<SpaceObject>* targetObject);
 uint32_t ThinkObjectEngageTarget(
-        Handle<SpaceObject> anObject, Handle<SpaceObject> targetObject, uint32_t distance,
+        SpaceObject* anObject, Handle<SpaceObject> targetObject, uint32_t distance,
         int16_t* theta);
 
 void SpaceObject::recharge() {
@@ -88,6 +93,7 @@ void SpaceObject::recharge() {
     if ((_health < (max_health() / 2)) && (_energy > kHealthRatio)) {
         _health++;
         _energy -= kHealthRatio;
+        mark_conditions_dirty(*this);
     }
 
     for (auto* weapon : {&pulse, &beam, &special}) {
@@ -182,7 +188,312 @@ static uint8_t get_tiny_shade(const SpaceObject& o) {
     }
 }
 
+// Decides which keys `o` presses this tick, and where it's headed.
+//
+// `o` is the object `o_handle` refers to, or a copy of it that's being thought about ahead of
+// time (see Speculation). The decision changes nothing but `o` itself.
+static void think(SpaceObject* o, Handle<SpaceObject> o_handle) {
+    auto baseObject = o->base;
+    o->targetAngle = o->directionGoal = o->direction;
+
+    uint32_t keysDown;
+    switch (o->presenceState) {
+        case kNormalPresence: keysDown = ThinkObjectNormalPresence(o, o_handle, baseObject); break;
+
+        case kWarpingPresence: keysDown = ThinkObjectWarpingPresence(o_handle); break;
+
+        case kWarpInPresence: keysDown = ThinkObjectWarpInPresence(o_handle); break;
+
+        case kWarpOutPresence:
+            keysDown = ThinkObjectWarpOutPresence(o_handle, baseObject);
+            break;
+
+        case kLandingPresence: keysDown = ThinkObjectLandingPresence(o_handle); break;
+    }
+
+    if (!(o->attributes & kRemoteOrHuman) || (o->attributes & kOnAutoPilot)) {
+        if (o->attributes & kHasDirectionGoal) {
+            if (o->attributes & kShapeFromDirection) {
+                if ((o->attributes & kIsGuided) && o->targetObject.get()) {
+                    int32_t difference = o->targetAngle - o->direction;
+                    if ((difference < -60) || (difference > 60)) {
+                        o->targetObject  = SpaceObject::none();
+                        o->directionGoal = o->direction;
+                    }
+                }
+            }
+            Point offset;
+            offset.h           = mAngleDifference(o->directionGoal, o->direction);
+            offset.v           = mFixedToLong(o->turn_rate() << 1);
+            int32_t difference = ABS(offset.h);
+            if (difference > offset.v) {
+                if (offset.h < 0) {
+                    keysDown |= kRightKey;
+                } else if (offset.h > 0) {
+                    keysDown |= kLeftKey;
+                }
+            }
+        }
+        // and here?
+        if (!(o->keysDown & kManualOverrideFlag)) {
+            if (o->closestDistance < kEngageRange) {
+                // why do we only do this randomly when closest is within engagerange?
+                // to simulate the innaccuracy of battle
+                // (to keep things from wiggling, really)
+                if (o->randomSeed.next(baseObject->ai.combat.skill.den) <
+                    baseObject->ai.combat.skill.num) {
+                    o->keysDown &= ~kMotionKeyMask;
+                    o->keysDown |= keysDown & kMotionKeyMask;
+                }
+                if (o->randomSeed.next(3) == 1) {
+                    o->keysDown &= ~kWeaponKeyMask;
+                    o->keysDown |= keysDown & kWeaponKeyMask;
+                }
+                o->keysDown &= ~kMiscKeyMask;
+                o->keysDown |= keysDown & kMiscKeyMask;
+            } else {
+                o->keysDown = (o->keysDown & kSpecialKeyMask) | keysDown;
+            }
+        } else {
+            o->keysDown &= ~kManualOverrideFlag;
+        }
+    }
+}
+
+// A decision made ahead of time, on a copy of an object.
+//
+// With more than one thread, every ship that can be thought about safely is thought about at
+// once, before any of them act. A ship's decision reads only its own state and that of the
+// objects it's tracking, and writes only its own state, so each copy records what it read. Then,
+// in the usual order, each ship takes its copy's decision if everything recorded is still as it
+// was; if anything that acted earlier in the tick changed it, the ship thinks again for real.
+// Either way, it decides what it would have decided on one thread.
+struct Speculation {
+    // The fields of an object that think() reads, whether it's the object thinking or one that
+    // it's tracking. A decision depends on nothing else, so if these are unchanged, so is it.
+    // Fields that think() only sometimes writes, like `duty`, count as read: decide() copies them
+    // back either way.
+    struct Read {
+        uint32_t            attributes;
+        const BaseObject*   base;  // Also turn_rate() and max_energy().
+        uint32_t            keysDown;
+        int32_t             direction, directionGoal;
+        Point               location;
+        int32_t             runTimeFlags;
+        Point               destinationLocation;
+        Handle<SpaceObject> destObject, destObjectDest;
+        ticks               timeFromOrigin;
+        int32_t             randomSeed;
+        int32_t             health, energy;
+        Handle<Admiral>     owner;
+        uint32_t            closestDistance;
+        Handle<SpaceObject> closestObject, targetObject;
+        int32_t             lastTargetDistance, longestWeaponRange, shortestWeaponRange;
+        int32_t             engageRange;
+        kPresenceStateType  presenceState;
+        int32_t             cloakState;
+        const BaseObject*   pulse;
+        const BaseObject*   beam;
+        const BaseObject*   special;
+        uint32_t            myPlayerFlag, seenByPlayerFlags;
+        dutyType            duty;
+
+        Read() = default;
+        explicit Read(const SpaceObject& o)
+                : attributes{o.attributes},
+                  base{o.base},
+                  keysDown{o.keysDown},
+                  direction{o.direction},
+                  directionGoal{o.directionGoal},
+                  location(o.location),
+                  runTimeFlags{o.runTimeFlags},
+                  destinationLocation(o.destinationLocation),
+                  destObject{o.destObject},
+                  destObjectDest{o.destObjectDest},
+                  timeFromOrigin{o.timeFromOrigin},
+                  randomSeed{o.randomSeed.seed},
+                  health{o.health()},
+                  energy{o.energy()},
+                  owner{o.owner},
+                  closestDistance{o.closestDistance},
+                  closestObject{o.closestObject},
+                  targetObject{o.targetObject},
+                  lastTargetDistance{o.lastTargetDistance},
+                  longestWeaponRange{o.longestWeaponRange},
+                  shortestWeaponRange{o.shortestWeaponRange},
+                  engageRange{o.engageRange},
+                  presenceState{o.presenceState},
+                  cloakState{o.cloakState},
+                  pulse{o.pulse.base},
+                  beam{o.beam.base},
+                  special{o.special.base},
+                  myPlayerFlag{o.myPlayerFlag},
+                  seenByPlayerFlags{o.seenByPlayerFlags},
+                  duty{o.duty} {}
+
+        bool operator==(const Read& other) const {
+            return std::tie(attributes, base, keysDown, direction, directionGoal, location,
+                            runTimeFlags, destinationLocation, destObject, destObjectDest,
+                            timeFromOrigin, randomSeed, health, energy, owner, closestDistance,
+                            closestObject, targetObject, lastTargetDistance, longestWeaponRange,
+                            shortestWeaponRange, engageRange, presenceState, cloakState, pulse,
+                            beam, special, myPlayerFlag, seenByPlayerFlags, duty) ==
+                   std::tie(other.attributes, other.base, other.keysDown, other.direction,
+                            other.directionGoal, other.location, other.runTimeFlags,
+                            other.destinationLocation, other.destObject, other.destObjectDest,
+                            other.timeFromOrigin, other.randomSeed, other.health, other.energy,
+                            other.owner, other.closestDistance, other.closestObject,
+                            other.targetObject, other.lastTargetDistance,
+                            other.longestWeaponRange, other.shortestWeaponRange,
+                            other.engageRange, other.presenceState, other.cloakState, other.pulse,
+                            other.beam, other.special, other.myPlayerFlag,
+                            other.seenByPlayerFlags, other.duty);
+        }
+    };
+
+    // Everything that a decision could read: the object itself, and what it's tracking.
+    static const int kMaxInputs = 5;
+    struct Input {
+        int32_t  number;
+        uint32_t generation;
+        Read     read;
+    };
+
+    Handle<SpaceObject> handle;
+    bool                ready = false;
+    SpaceObject         copy;
+    Input               inputs[kMaxInputs];
+    int                 input_count = 0;
+
+    // Whether a copy of `o` would decide the same as `o` itself. Copies can't have side effects,
+    // and since copies aren't where the object itself is, a copy can't track itself.
+    static bool can_think_ahead(const SpaceObject& o) {
+        return o.active && (o.attributes & kCanThink) &&
+               !(o.attributes & (kRemoteOrHuman | kOnAutoPilot)) &&
+               (o.presenceState == kNormalPresence) &&
+               (o.base->arrive.action.empty() || (o.runTimeFlags & kHasArrived));
+    }
+
+    void think_ahead() {
+        input_count = 0;
+        ready       = record_inputs();
+        if (ready) {
+            copy = *handle;
+            think(&copy, handle);
+        }
+    }
+
+    bool still_valid() const {
+        for (int i = 0; i < input_count; ++i) {
+            const Input& in = inputs[i];
+            if ((SpaceObject::generation(in.number) != in.generation) ||
+                !(Read(*SpaceObject::get(in.number)) == in.read)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Makes the copy's decision `o`'s own. think() writes only these fields, so the rest of `o`
+    // stays as it is now, not as it was when the copy was made.
+    void decide(SpaceObject* o) const {
+        o->attributes          = copy.attributes;
+        o->keysDown            = copy.keysDown;
+        o->direction           = copy.direction;
+        o->directionGoal       = copy.directionGoal;
+        o->runTimeFlags        = copy.runTimeFlags;
+        o->destinationLocation = copy.destinationLocation;
+        o->destObject          = copy.destObject;
+        o->destObjectDest      = copy.destObjectDest;
+        o->timeFromOrigin      = copy.timeFromOrigin;
+        o->randomSeed          = copy.randomSeed;
+        o->targetObject        = copy.targetObject;
+        o->targetAngle         = copy.targetAngle;
+        o->lastTargetDistance  = copy.lastTargetDistance;
+        o->duty                = copy.duty;
+    }
+
+  private:
+    bool record_inputs() {
+        const SpaceObject& o = *handle;
+        return record(handle.number()) && record(o.targetObject) && record(o.closestObject) &&
+               record(o.destObject) && record(o.destObjectDest);
+    }
+
+    bool record(Handle<SpaceObject> h) {
+        if (h.number() == handle.number()) {
+            return false;
+        }
+        return record(h.number());
+    }
+
+    bool record(int32_t number) {
+        const SpaceObject* o = SpaceObject::get(number);
+        if (!o) {
+            return true;
+        }
+        for (int i = 0; i < input_count; ++i) {
+            if (inputs[i].number == number) {
+                return true;
+            }
+        }
+        inputs[input_count++] = Input{number, SpaceObject::generation(number), Read(*o)};
+        return true;
+    }
+};
+
+static ANTARES_GLOBAL std::unique_ptr<ThreadPool> think_pool;
+static ANTARES_GLOBAL std::vector<Speculation> speculations;
+static ANTARES_GLOBAL std::vector<int32_t> speculation_index;  // By object number, or -1.
+
+void SetThinkThreads(int threads) {
+    if (threads > 1) {
+        think_pool.reset(new ThreadPool(threads));
+    } else {
+        think_pool.reset();
+    }
+}
+
+static void think_ahead() {
+    speculation_index.assign(g.objects.size(), -1);
+    if (!think_pool) {
+        return;
+    }
+
+    int32_t count = 0;
+    for (auto o : SpaceObject::by_age()) {
+        if (Speculation::can_think_ahead(*o)) {
+            speculation_index[o.number()] = count++;
+        }
+    }
+    if (speculations.size() < count) {
+        speculations.resize(count);
+    }
+    for (auto o : SpaceObject::by_age()) {
+        if (speculation_index[o.number()] >= 0) {
+            speculations[speculation_index[o.number()]].handle = o;
+        }
+    }
+
+    think_pool->parallel_for(count, [](int32_t i) { speculations[i].think_ahead(); });
+}
+
+// If `o` was thought about ahead of time, and nothing its decision read has changed since, makes
+// that decision `o`'s own and returns true.
+static bool take_speculation(Handle<SpaceObject> o) {
+    if ((o.number() >= speculation_index.size()) || (speculation_index[o.number()] < 0)) {
+        return false;
+    }
+    const Speculation& s = speculations[speculation_index[o.number()]];
+    if (!s.ready || (s.handle != o) || !s.still_valid()) {
+        return false;
+    }
+    s.decide(o.get());
+    return true;
+}
+
 void NonplayerShipThink() {
+    PhaseTimer timer(TickPhase::THINK);
     uint8_t friendSick, foeSick, neutralSick;
     switch ((std::chrono::time_point_cast<ticks>(g.time).time_since_epoch().count() / 9) % 4) {
         case 0: friendSick = foeSick = neutralSick = MEDIUM; break;
@@ -194,15 +505,28 @@ void NonplayerShipThink() {
             break;
     }
 
-    g.sync = g.random.seed;
+    if (g.random_mode == RandomMode::LEGACY) {
+        g.sync = g.random.seed;
+    } else {
+        // g.random doesn't move in COUNTER mode, so start from what the streams are keyed by, and
+        // how many have been keyed: a peer that drew for something this one didn't will differ.
+        int64_t tick = g.time.time_since_epoch().count();
+        g.sync       = g.level_seed;
+        g.sync       = (g.sync * 31) + tick;
+        g.sync       = (g.sync * 31) + g.random_streams;
+    }
+    int32_t ships_left[kMaxPlayerNum];
     for (int32_t count = 0; count < kMaxPlayerNum; count++) {
+        ships_left[count]                   = Handle<Admiral>(count)->shipsLeft();
         Handle<Admiral>(count)->shipsLeft() = 0;
     }
 
+    think_ahead();
+
     // it probably doesn't matter what order we do this in, but we'll do
     // it in the "ideal" order anyway
-    SpaceObject* o = nullptr;
-    for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+    for (auto o_handle : SpaceObject::by_age()) {
+        SpaceObject* o = o_handle.get();
         if (!o->active) {
             continue;
         }
@@ -232,77 +556,14 @@ void NonplayerShipThink() {
 
         // get the object's base object
         auto baseObject = o->base;
-        o->targetAngle = o->directionGoal = o->direction;
 
         // incremenent its admiral's # of ships
         if (o->owner.get()) {
             o->owner->shipsLeft()++;
         }
 
-        uint32_t keysDown;
-        switch (o->presenceState) {
-            case kNormalPresence:
-                keysDown = ThinkObjectNormalPresence(o_handle, baseObject);
-                break;
-
-            case kWarpingPresence: keysDown = ThinkObjectWarpingPresence(o_handle); break;
-
-            case kWarpInPresence: keysDown = ThinkObjectWarpInPresence(o_handle); break;
-
-            case kWarpOutPresence:
-                keysDown = ThinkObjectWarpOutPresence(o_handle, baseObject);
-                break;
-
-            case kLandingPresence: keysDown = ThinkObjectLandingPresence(o_handle); break;
-        }
-
-        if (!(o->attributes & kRemoteOrHuman) || (o->attributes & kOnAutoPilot)) {
-            if (o->attributes & kHasDirectionGoal) {
-                if (o->attributes & kShapeFromDirection) {
-                    if ((o->attributes & kIsGuided) && o->targetObject.get()) {
-                        int32_t difference = o->targetAngle - o->direction;
-                        if ((difference < -60) || (difference > 60)) {
-                            o->targetObject   = SpaceObject::none();
-                            o->targetObjectID = kNoShip;
-                            o->directionGoal  = o->direction;
-                        }
-                    }
-                }
-                Point offset;
-                offset.h           = mAngleDifference(o->directionGoal, o->direction);
-                offset.v           = mFixedToLong(o->turn_rate() << 1);
-                int32_t difference = ABS(offset.h);
-                if (difference > offset.v) {
-                    if (offset.h < 0) {
-                        keysDown |= kRightKey;
-                    } else if (offset.h > 0) {
-                        keysDown |= kLeftKey;
-                    }
-                }
-            }
-            // and here?
-            if (!(o->keysDown & kManualOverrideFlag)) {
-                if (o->closestDistance < kEngageRange) {
-                    // why do we only do this randomly when closest is within engagerange?
-                    // to simulate the innaccuracy of battle
-                    // (to keep things from wiggling, really)
-                    if (o->randomSeed.next(baseObject->ai.combat.skill.den) <
-                        baseObject->ai.combat.skill.num) {
-                        o->keysDown &= ~kMotionKeyMask;
-                        o->keysDown |= keysDown & kMotionKeyMask;
-                    }
-                    if (o->randomSeed.next(3) == 1) {
-                        o->keysDown &= ~kWeaponKeyMask;
-                        o->keysDown |= keysDown & kWeaponKeyMask;
-                    }
-                    o->keysDown &= ~kMiscKeyMask;
-                    o->keysDown |= keysDown & kMiscKeyMask;
-                } else {
-                    o->keysDown = (o->keysDown & kSpecialKeyMask) | keysDown;
-                }
-            } else {
-                o->keysDown &= ~kManualOverrideFlag;
-            }
+        if (!take_speculation(o_handle)) {
+            think(o, o_handle);
         }
 
         // Take care of any "keys" being pressed
@@ -395,9 +656,15 @@ void NonplayerShipThink() {
             }
         }
     }
+
+    for (auto a : Admiral::all()) {
+        if (a->shipsLeft() != ships_left[a.number()]) {
+            mark_conditions_dirty(a);
+        }
+    }
 }
 
-uint32_t use_weapons_for_defense(Handle<SpaceObject> obj) {
+uint32_t use_weapons_for_defense(const SpaceObject* obj) {
     uint32_t keys = 0;
 
     if (obj->pulse.base) {
@@ -424,7 +691,11 @@ uint32_t use_weapons_for_defense(Handle<SpaceObject> obj) {
     return keys;
 }
 
-uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObject* baseObject) {
+// `anObject` is the object `handle` refers to, or a copy of it that's being thought about ahead
+// of time (see Speculation). Copies are never on autopilot or about to arrive, so they never
+// reach the exec() and TogglePlayerAutoPilot() calls below, which need the real object.
+uint32_t ThinkObjectNormalPresence(
+        SpaceObject* anObject, Handle<SpaceObject> handle, const BaseObject* baseObject) {
     uint32_t            keysDown = anObject->keysDown & kSpecialKeyMask, distance, dcalc;
     Point               dest;
     Handle<SpaceObject> targetObject;
@@ -534,7 +805,7 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                 if (distance < static_cast<uint32_t>(baseObject->arrive.distance.squared)) {
                     if (baseObject->arrive.action.size() > 0) {
                         if (!(anObject->runTimeFlags & kHasArrived)) {
-                            exec(baseObject->arrive.action, anObject, anObject->destObject,
+                            exec(baseObject->arrive.action, handle, anObject->destObject,
                                  {0, 0});
                             anObject->runTimeFlags |= kHasArrived;
                         }
@@ -601,15 +872,14 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                 (!anObject->destObject.get() &&
                  (anObject->destinationLocation.h == kNoDestinationCoord))) {
                 if (anObject->attributes & kOnAutoPilot) {
-                    TogglePlayerAutoPilot(anObject);
+                    TogglePlayerAutoPilot(handle);
                 }
                 keysDown |= kDownKey;
                 anObject->timeFromOrigin = ticks(0);
             } else {
                 if (anObject->destObject.get()) {
                     targetObject = anObject->destObject;
-                    if (targetObject.get() && targetObject->active &&
-                        (targetObject->id == anObject->destObjectID)) {
+                    if (!targetObject.expired()) {
                         if (targetObject->seenByPlayerFlags & anObject->myPlayerFlag) {
                             dest.h                          = targetObject->location.h;
                             dest.v                          = targetObject->location.v;
@@ -619,8 +889,7 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                             dest.h = anObject->destinationLocation.h;
                             dest.v = anObject->destinationLocation.v;
                         }
-                        anObject->destObjectDest   = targetObject->destObject;
-                        anObject->destObjectDestID = targetObject->destObjectID;
+                        anObject->destObjectDest = targetObject->destObject;
                     } else {
                         anObject->duty = eNoDuty;
                         anObject->attributes &= ~kStaticDestination;
@@ -631,24 +900,22 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                             dest.h                   = anObject->location.h;
                             dest.v                   = anObject->location.v;
                             if (anObject->attributes & kOnAutoPilot) {
-                                TogglePlayerAutoPilot(anObject);
+                                TogglePlayerAutoPilot(handle);
                             }
                         } else {
                             anObject->destObject = anObject->destObjectDest;
                             if (anObject->destObject.get()) {
                                 targetObject = anObject->destObject;
-                                if (targetObject->id != anObject->destObjectDestID) {
+                                if (targetObject.expired()) {
                                     targetObject = SpaceObject::none();
                                 }
                             } else {
                                 targetObject = SpaceObject::none();
                             }
                             if (targetObject.get()) {
-                                anObject->destObjectID     = targetObject->id;
-                                anObject->destObjectDest   = targetObject->destObject;
-                                anObject->destObjectDestID = targetObject->destObjectID;
-                                dest.h                     = targetObject->location.h;
-                                dest.v                     = targetObject->location.v;
+                                anObject->destObjectDest = targetObject->destObject;
+                                dest.h                   = targetObject->location.h;
+                                dest.v                   = targetObject->location.v;
                             } else {
                                 anObject->duty = eNoDuty;
                                 keysDown |= kDownKey;
@@ -657,14 +924,14 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                                 dest.h                   = anObject->location.h;
                                 dest.v                   = anObject->location.v;
                                 if (anObject->attributes & kOnAutoPilot) {
-                                    TogglePlayerAutoPilot(anObject);
+                                    TogglePlayerAutoPilot(handle);
                                 }
                             }
                         }
                     }
                 } else {  // no destination object; just coords
                     if (anObject->attributes & kOnAutoPilot) {
-                        TogglePlayerAutoPilot(anObject);
+                        TogglePlayerAutoPilot(handle);
                     }
                     targetObject = SpaceObject::none();
                     dest.h       = anObject->destinationLocation.h;
@@ -722,7 +989,7 @@ uint32_t ThinkObjectNormalPresence(Handle<SpaceObject> anObject, const BaseObjec
                     if (distance < static_cast<uint32_t>(baseObject->arrive.distance.squared)) {
                         if (baseObject->arrive.action.size() > 0) {
                             if (!(anObject->runTimeFlags & kHasArrived)) {
-                                exec(baseObject->arrive.action, anObject, anObject->destObject,
+                                exec(baseObject->arrive.action, handle, anObject->destObject,
                                      {0, 0});
                                 anObject->runTimeFlags |= kHasArrived;
                             }
@@ -881,7 +1148,7 @@ uint32_t ThinkObjectWarpingPresence(Handle<SpaceObject> anObject) {
     }
     if ((!(anObject->attributes & kRemoteOrHuman)) || (anObject->attributes & kOnAutoPilot)) {
         ThinkObjectResolveDestination(anObject, &dest, &targetObject);
-        ThinkObjectGetCoordVector(anObject, &dest, &distance, &angle);
+        ThinkObjectGetCoordVector(anObject.get(), &dest, &distance, &angle);
 
         if (anObject->attributes & kHasDirectionGoal) {
             theta = mAngleDifference(angle, anObject->directionGoal);
@@ -958,7 +1225,7 @@ uint32_t ThinkObjectLandingPresence(Handle<SpaceObject> anObject) {
         Point dest;
         if (anObject->destObject.get()) {
             target = anObject->destObject;
-            if (target.get() && target->active && (target->id == anObject->destObjectID)) {
+            if (!target.expired()) {
                 if (target->seenByPlayerFlags & anObject->myPlayerFlag) {
                     dest.h                          = target->location.h;
                     dest.v                          = target->location.v;
@@ -968,8 +1235,7 @@ uint32_t ThinkObjectLandingPresence(Handle<SpaceObject> anObject) {
                     dest.h = anObject->destinationLocation.h;
                     dest.v = anObject->destinationLocation.v;
                 }
-                anObject->destObjectDest   = target->destObject;
-                anObject->destObjectDestID = target->destObjectID;
+                anObject->destObjectDest = target->destObject;
             } else {
                 anObject->duty = eNoDuty;
                 anObject->attributes &= ~kStaticDestination;
@@ -983,18 +1249,16 @@ uint32_t ThinkObjectLandingPresence(Handle<SpaceObject> anObject) {
                     anObject->destObject = anObject->destObjectDest;
                     if (anObject->destObject.get()) {
                         target = anObject->destObject;
-                        if (target->id != anObject->destObjectDestID) {
+                        if (target.expired()) {
                             target = SpaceObject::none();
                         }
                     } else {
                         target = SpaceObject::none();
                     }
                     if (target.get()) {
-                        anObject->destObjectID     = target->id;
-                        anObject->destObjectDest   = target->destObject;
-                        anObject->destObjectDestID = target->destObjectID;
-                        dest.h                     = target->location.h;
-                        dest.v                     = target->location.v;
+                        anObject->destObjectDest = target->destObject;
+                        dest.h                   = target->location.h;
+                        dest.v                   = target->location.v;
                     } else {
                         keysDown |= kDownKey;
                         anObject->destObject     = SpaceObject::none();
@@ -1079,7 +1343,7 @@ uint32_t ThinkObjectLandingPresence(Handle<SpaceObject> anObject) {
 
 // this gets the distance & angle between an object and arbitrary coords
 void ThinkObjectGetCoordVector(
-        Handle<SpaceObject> anObject, Point* dest, uint32_t* distance, int16_t* angle) {
+        const SpaceObject* anObject, Point* dest, uint32_t* distance, int16_t* angle) {
     int32_t  difference;
     uint32_t dcalc;
     int16_t  shortx, shorty;
@@ -1124,7 +1388,7 @@ void ThinkObjectGetCoordVector(
     }
 }
 
-void ThinkObjectGetCoordDistance(Handle<SpaceObject> anObject, Point* dest, uint32_t* distance) {
+void ThinkObjectGetCoordDistance(const SpaceObject* anObject, Point* dest, uint32_t* distance) {
     int32_t  difference;
     uint32_t dcalc;
 
@@ -1163,8 +1427,7 @@ void ThinkObjectResolveDestination(
     } else {
         if (anObject->destObject.get()) {
             *targetObject = anObject->destObject;
-            if ((*targetObject).get() && ((*targetObject)->active) &&
-                ((*targetObject)->id == anObject->destObjectID)) {
+            if (!targetObject->expired()) {
                 if ((*targetObject)->seenByPlayerFlags & anObject->myPlayerFlag) {
                     dest->h                         = (*targetObject)->location.h;
                     dest->v                         = (*targetObject)->location.v;
@@ -1174,8 +1437,7 @@ void ThinkObjectResolveDestination(
                     dest->h = anObject->destinationLocation.h;
                     dest->v = anObject->destinationLocation.v;
                 }
-                anObject->destObjectDest   = (*targetObject)->destObject;
-                anObject->destObjectDestID = (*targetObject)->destObjectID;
+                anObject->destObjectDest = (*targetObject)->destObject;
             } else {
                 anObject->duty = eNoDuty;
                 anObject->attributes &= ~kStaticDestination;
@@ -1188,18 +1450,16 @@ void ThinkObjectResolveDestination(
                     anObject->destObject = anObject->destObjectDest;
                     if (anObject->destObject.get()) {
                         (*targetObject) = anObject->destObject;
-                        if ((*targetObject)->id != anObject->destObjectDestID) {
+                        if (targetObject->expired()) {
                             *targetObject = SpaceObject::none();
                         }
                     } else {
                         *targetObject = SpaceObject::none();
                     }
                     if ((*targetObject).get()) {
-                        anObject->destObjectID     = (*targetObject)->id;
-                        anObject->destObjectDest   = (*targetObject)->destObject;
-                        anObject->destObjectDestID = (*targetObject)->destObjectID;
-                        dest->h                    = (*targetObject)->location.h;
-                        dest->v                    = (*targetObject)->location.v;
+                        anObject->destObjectDest = (*targetObject)->destObject;
+                        dest->h                  = (*targetObject)->location.h;
+                        dest->v                  = (*targetObject)->location.v;
                     } else {
                         anObject->duty           = eNoDuty;
                         anObject->destObject     = SpaceObject::none();
@@ -1227,7 +1487,7 @@ void ThinkObjectResolveDestination(
 }
 
 bool ThinkObjectResolveTarget(
-        Handle<SpaceObject> anObject, Point* dest, uint32_t* distance,
+        SpaceObject* anObject, Point* dest, uint32_t* distance,
         Handle<SpaceObject>* targetObject) {
     dest->h = dest->v = 0xffffffff;
     *distance         = 0xffffffff;
@@ -1242,12 +1502,10 @@ bool ThinkObjectResolveTarget(
             if (anObject->attributes & kHasDirectionGoal) {
                 anObject->directionGoal = anObject->direction;
             }
-            anObject->targetObject   = anObject->closestObject;
-            anObject->targetObjectID = closestObject->id;
+            anObject->targetObject = anObject->closestObject;
         } else  // otherwise, no target, no closest, cancel
         {
             *targetObject = anObject->targetObject = closestObject = SpaceObject::none();
-            anObject->targetObjectID                               = kNoShip;
             dest->h                                                = anObject->location.h;
             dest->v                                                = anObject->location.v;
             *distance                                              = anObject->engageRange;
@@ -1261,7 +1519,7 @@ bool ThinkObjectResolveTarget(
         *targetObject = anObject->targetObject;
 
         // if the object is wrong or smells at all funny, then
-        if ((!((*targetObject)->active)) || ((*targetObject)->id != anObject->targetObjectID) ||
+        if (targetObject->expired() ||
             (((*targetObject)->owner == anObject->owner) &&
              ((*targetObject)->attributes & kHated)) ||
             ((!((*targetObject)->attributes & kPotentialTarget)) &&
@@ -1270,10 +1528,8 @@ bool ThinkObjectResolveTarget(
             if (anObject->closestObject.get()) {
                 // make it our target
                 *targetObject = anObject->targetObject = closestObject = anObject->closestObject;
-                anObject->targetObjectID                               = closestObject->id;
                 if (!((*targetObject)->attributes & kPotentialTarget)) {  // cancel
                     *targetObject = anObject->targetObject = SpaceObject::none();
-                    anObject->targetObjectID               = kNoShip;
                     dest->h                                = anObject->location.h;
                     dest->v                                = anObject->location.v;
                     *distance                              = anObject->engageRange;
@@ -1282,7 +1538,6 @@ bool ThinkObjectResolveTarget(
             } else  // no legal target, no closest, cancel
             {
                 *targetObject = anObject->targetObject = closestObject = SpaceObject::none();
-                anObject->targetObjectID                               = kNoShip;
                 dest->h                                                = anObject->location.h;
                 dest->v                                                = anObject->location.v;
                 *distance                                              = anObject->engageRange;
@@ -1302,7 +1557,6 @@ bool ThinkObjectResolveTarget(
                          targetObject = closestObject;
                          anObject->targetObjectNumber =
                              anObject->closestObject;
-                         anObject->targetObjectID = targetObject->id;
                      }
                  }
              }
@@ -1323,7 +1577,6 @@ bool ThinkObjectResolveTarget(
                 (!(anObject->attributes & kCanEngage)) ||
                 (anObject->attributes & kRemoteOrHuman)) {
                 *targetObject = anObject->targetObject = anObject->closestObject;
-                anObject->targetObjectID               = (*targetObject)->id;
                 dest->h                                = (*targetObject)->location.h;
                 dest->v                                = (*targetObject)->location.v;
                 *distance                              = anObject->closestDistance;
@@ -1343,7 +1596,6 @@ bool ThinkObjectResolveTarget(
     {
         // set the distance to the engage range ie nothing to engage
         *targetObject = anObject->targetObject = closestObject = SpaceObject::none();
-        anObject->targetObjectID                               = kNoShip;
         dest->h                                                = anObject->location.h;
         dest->v                                                = anObject->location.v;
         *distance                                              = anObject->engageRange;
@@ -1352,7 +1604,7 @@ bool ThinkObjectResolveTarget(
 }
 
 uint32_t ThinkObjectEngageTarget(
-        Handle<SpaceObject> anObject, Handle<SpaceObject> targetObject, uint32_t distance,
+        SpaceObject* anObject, Handle<SpaceObject> targetObject, uint32_t distance,
         int16_t* theta) {
     uint32_t keysDown = 0;
     Point    dest;
@@ -1513,8 +1765,9 @@ void HitObject(Handle<SpaceObject> anObject, Handle<SpaceObject> sObject) {
     if (anObject->health() < 0 && (anObject->owner == g.admiral) &&
         (anObject->attributes & kCanAcceptDestination)) {
         int count = CountObjectsOfBaseType(anObject->base, anObject->owner) - 1;
-        Messages::add(pn::format(
-                "\xc2\xa0{0} destroyed.  {1} remaining.\xc2\xa0", anObject->long_name(), count));
+        Messages::add(tick_arena.join(
+                {"\xc2\xa0", anObject->long_name(), " destroyed.  ", tick_arena.dump(count),
+                 " remaining.\xc2\xa0"}));
     }
 
     if (sObject->active == kObjectInUse) {
@@ -1560,12 +1813,12 @@ Handle<SpaceObject> GetManualSelectObject(
     if (whichShip.get()) {
         anObject = startShip;
         if (anObject->active != kObjectInUse) {  // if it's not in the loop
-            anObject  = g.root;
-            startShip = whichShip = g.root;
+            anObject  = SpaceObject::newest();
+            startShip = whichShip = SpaceObject::newest();
         }
     } else {
-        anObject  = g.root;
-        startShip = whichShip = g.root;
+        anObject  = SpaceObject::newest();
+        startShip = whichShip = SpaceObject::newest();
     }
 
     Handle<SpaceObject> nextShipOut, closestShip;
@@ -1623,9 +1876,9 @@ Handle<SpaceObject> GetManualSelectObject(
                 }
             }
         }
-        whichShip = anObject = anObject->nextObject;
+        whichShip = anObject = anObject->older();
         if (!anObject.get()) {
-            whichShip = anObject = g.root;
+            whichShip = anObject = SpaceObject::newest();
         }
     } while (whichShip != startShip);
 
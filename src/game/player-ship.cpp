@@ -40,6 +40,7 @@
 #include "game/messages.hpp"
 #include "game/minicomputer.hpp"
 #include "game/non-player-ship.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
@@ -92,20 +93,20 @@ static ANTARES_GLOBAL wall_time gHotKeyTime[10];
 
 static ANTARES_GLOBAL Zoom gPreviousZoomMode;
 
-pn::string name_with_hot_key_suffix(Handle<SpaceObject> space_object) {
+pn::string_view name_with_hot_key_suffix(Handle<SpaceObject> space_object) {
     int h = HotKey_GetFromObject(space_object);
     if (h < 0) {
-        return space_object->long_name().copy();
+        return space_object->long_name();
     }
 
     Key keyNum = sys.prefs->key(h + kFirstHotKeyNum);
     if (keyNum == Key::NONE) {
-        return space_object->long_name().copy();
+        return space_object->long_name();
     }
 
-    return pn::format(
-            "{0} < {1} >", space_object->long_name(),
-            sys.key_long_names.at(static_cast<int>(keyNum)));
+    return tick_arena.join(
+            {space_object->long_name(), " < ", sys.key_long_names.at(static_cast<int>(keyNum)),
+             " >"});
 };
 
 }  // namespace
@@ -129,8 +130,7 @@ void ResetPlayerShip() {
     gPreviousZoomMode      = Zoom::FOE;
 
     for (int h = 0; h < kHotKeyNum; h++) {
-        globals()->hotKey[h].object   = SpaceObject::none();
-        globals()->hotKey[h].objectID = -1;
+        globals()->hotKey[h].object = SpaceObject::none();
     }
     for (auto& k : gHotKeyState) {
         k = HOT_KEY_UP;
@@ -207,8 +207,7 @@ static void select_object(Handle<SpaceObject> ship, bool target, Handle<Admiral>
     Hue                 hue;
 
     if (adm == g.admiral) {
-        globals()->lastSelectedObject   = ship;
-        globals()->lastSelectedObjectID = ship->id;
+        globals()->lastSelectedObject = ship;
     }
     if (target) {
         adm->set_target(ship);
@@ -722,9 +721,8 @@ static void handle_hotkeys(const std::vector<PlayerEvent>& player_events) {
             case PlayerEventType::HOTKEY_SET:
                 if (globals()->lastSelectedObject.get()) {
                     auto o = globals()->lastSelectedObject;
-                    if (o->active && (o->id == globals()->lastSelectedObjectID)) {
-                        globals()->hotKey[e.data].object   = globals()->lastSelectedObject;
-                        globals()->hotKey[e.data].objectID = globals()->lastSelectedObjectID;
+                    if (!o.expired() && o->active) {
+                        globals()->hotKey[e.data].object = globals()->lastSelectedObject;
                         Update_LabelStrings_ForHotKeyChange();
                         sys.sound.select();
                     }
@@ -735,7 +733,7 @@ static void handle_hotkeys(const std::vector<PlayerEvent>& player_events) {
             case PlayerEventType::HOTKEY_TARGET:
                 if (globals()->hotKey[e.data].object.get()) {
                     auto o = globals()->hotKey[e.data].object;
-                    if (o->active && (o->id == globals()->hotKey[e.data].objectID)) {
+                    if (!o.expired() && o->active) {
                         bool target = (e.type == PlayerEventType::HOTKEY_TARGET) ||
                                       (o->owner != g.admiral);
                         select_object(o, target, g.admiral);
@@ -975,6 +973,16 @@ void PlayerShip::update() {
     _player_events.clear();
 }
 
+void PlayerShip::snapshot(SnapshotArchive& a) {
+    a.value(gTheseKeys);
+    a.value(_gamepad_keys);
+    a.vector(_player_events);
+    a.value(_keys);
+    a.value(_gamepad_state);
+    a.value(_control_active);
+    a.value(_control_direction);
+}
+
 bool PlayerShip::show_select() const {
     return _control_active && (_gamepad_state & SELECT_BUMPER);
 }
@@ -1150,13 +1158,13 @@ void PlayerShipBodyExpire(Handle<SpaceObject> flagship) {
             selectShip = SpaceObject::none();
     }
     if (!selectShip.get()) {
-        selectShip = g.root;
+        selectShip = SpaceObject::newest();
         while (selectShip.get() && ((selectShip->active != kObjectInUse) ||
                                     (selectShip->attributes & kStaticDestination) ||
                                     (!((selectShip->attributes & kCanThink) &&
                                        (selectShip->attributes & kCanAcceptDestination))) ||
                                     (selectShip->owner != flagship->owner))) {
-            selectShip = selectShip->nextObject;
+            selectShip = selectShip->older();
         }
     }
     if (selectShip.get()) {
@@ -1192,9 +1200,7 @@ int32_t HotKey_GetFromObject(Handle<SpaceObject> object) {
     }
     for (int32_t i = 0; i < kHotKeyNum; ++i) {
         if (globals()->hotKey[i].object == object) {
-            if (globals()->hotKey[i].objectID == object->id) {
-                return i;
-            }
+            return i;
         }
     }
     return -1;
@@ -0,0 +1,143 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/profile.hpp"
+
+#include <algorithm>
+#include <pn/output>
+
+#include "lang/defines.hpp"
+
+namespace antares {
+
+ANTARES_GLOBAL TickProfile tick_profile;
+
+static const char* const kPhaseNames[kTickPhaseCount] = {
+        "move",         "think",    "admiral", "actions", "collide", "conditions",
+        "minicomputer", "messages", "labels",  "vectors", "radar",
+};
+
+pn::string_view phase_name(TickPhase phase) { return kPhaseNames[static_cast<int>(phase)]; }
+
+void TickProfile::end_tick() {
+    if (!_enabled) {
+        return;
+    }
+    // Counted before storing the samples, and again after, so that growing the vectors that hold
+    // them isn't charged to any tick.
+    int64_t allocations = _allocation_counter ? (_allocation_counter() - _allocation_start) : 0;
+
+    for (int i = 0; i < kTickPhaseCount; ++i) {
+        _samples[i].push_back(_current[i].count());
+        _current[i] = std::chrono::nanoseconds{0};
+    }
+    auto now = std::chrono::steady_clock::now();
+    _tick_samples.push_back(std::chrono::nanoseconds(now - _tick_start).count());
+    _tick_start = now;
+
+    if (_allocation_counter) {
+        _tick_allocations.push_back(allocations);
+        _allocation_start = _allocation_counter();
+    }
+}
+
+void TickProfile::reset() {
+    for (int i = 0; i < kTickPhaseCount; ++i) {
+        _samples[i].clear();
+        _current[i] = std::chrono::nanoseconds{0};
+    }
+    _tick_samples.clear();
+    _tick_allocations.clear();
+    _tick_start = std::chrono::steady_clock::now();
+    if (_allocation_counter) {
+        _allocation_start = _allocation_counter();
+    }
+}
+
+// Nearest-rank percentile: the smallest sample that at least `percent`% of samples are at or
+// below. Reorders `samples`.
+static int64_t percentile(std::vector<int64_t>& samples, int percent) {
+    size_t rank = (samples.size() * percent + 99) / 100;
+    auto   it   = samples.begin() + (std::max<size_t>(rank, 1) - 1);
+    std::nth_element(samples.begin(), it, samples.end());
+    return *it;
+}
+
+static PhaseTimes summarize(const std::vector<int64_t>& all, size_t last) {
+    PhaseTimes result;
+    if (all.empty()) {
+        return result;
+    }
+    std::vector<int64_t> samples(all.end() - std::min(last, all.size()), all.end());
+    result.ticks = samples.size();
+    result.max   = std::chrono::nanoseconds{*std::max_element(samples.begin(), samples.end())};
+    result.p99   = std::chrono::nanoseconds{percentile(samples, 99)};
+    result.p50   = std::chrono::nanoseconds{percentile(samples, 50)};
+    return result;
+}
+
+PhaseTimes TickProfile::times(TickPhase phase, size_t last) const {
+    return summarize(_samples[static_cast<int>(phase)], last);
+}
+
+PhaseTimes TickProfile::tick_times(size_t last) const { return summarize(_tick_samples, last); }
+
+static double micros(std::chrono::nanoseconds ns) {
+    return std::chrono::duration<double, std::micro>(ns).count();
+}
+
+// Each phase, then the whole tick.
+static const int kReportRows = kTickPhaseCount + 1;
+
+static pn::string_view row_name(int row) {
+    return (row < kTickPhaseCount) ? phase_name(static_cast<TickPhase>(row)) : "tick";
+}
+
+static PhaseTimes row_times(const TickProfile& profile, int row) {
+    return (row < kTickPhaseCount) ? profile.times(static_cast<TickPhase>(row))
+                                   : profile.tick_times();
+}
+
+pn::string TickProfile::json() const {
+    pn::string out;
+    out += "{\n";
+    for (int i = 0; i < kReportRows; ++i) {
+        PhaseTimes t = row_times(*this, i);
+        out += pn::format("  \"{0}\": ", row_name(i));
+        out += "{";
+        out += pn::format(
+                "\"ticks\": {0}, \"p50_us\": {1}, \"p99_us\": {2}, \"max_us\": {3}", t.ticks,
+                micros(t.p50), micros(t.p99), micros(t.max));
+        out += (i + 1 < kReportRows) ? "},\n" : "}\n";
+    }
+    out += "}\n";
+    return out;
+}
+
+pn::string TickProfile::csv() const {
+    pn::string out;
+    out += "phase,ticks,p50_us,p99_us,max_us\n";
+    for (int i = 0; i < kReportRows; ++i) {
+        PhaseTimes t = row_times(*this, i);
+        out += pn::format(
+                "{0},{1},{2},{3},{4}\n", row_name(i), t.ticks, micros(t.p50), micros(t.p99),
+                micros(t.max));
+    }
+    return out;
+}
+
+}  // namespace antares
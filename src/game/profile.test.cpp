@@ -0,0 +1,96 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/profile.hpp"
+
+#include <gmock/gmock.h>
+
+using std::chrono::nanoseconds;
+using testing::ElementsAre;
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+class TickProfileTest : public testing::Test {
+  protected:
+    TickProfileTest() {
+        tick_profile.reset();
+        tick_profile.set_enabled(true);
+    }
+    ~TickProfileTest() { tick_profile.set_enabled(false); }
+};
+
+TEST_F(TickProfileTest, Empty) {
+    PhaseTimes t = tick_profile.times(TickPhase::MOVE);
+    EXPECT_THAT(t.ticks, Eq(0));
+    EXPECT_THAT(t.max.count(), Eq(0));
+}
+
+// Samples of 1 through 100 ns, in a scrambled order.
+TEST_F(TickProfileTest, Percentiles) {
+    for (int i = 0; i < 100; ++i) {
+        tick_profile.add(TickPhase::MOVE, nanoseconds{((i * 37) % 100) + 1});
+        tick_profile.end_tick();
+    }
+    PhaseTimes t = tick_profile.times(TickPhase::MOVE);
+    EXPECT_THAT(t.ticks, Eq(100));
+    EXPECT_THAT(t.p50.count(), Eq(50));
+    EXPECT_THAT(t.p99.count(), Eq(99));
+    EXPECT_THAT(t.max.count(), Eq(100));
+
+    // Phases that didn't run still get a sample of zero each tick.
+    EXPECT_THAT(tick_profile.times(TickPhase::RADAR).ticks, Eq(100));
+    EXPECT_THAT(tick_profile.times(TickPhase::RADAR).max.count(), Eq(0));
+}
+
+TEST_F(TickProfileTest, AddsUpUntilEndOfTick) {
+    tick_profile.add(TickPhase::COLLIDE, nanoseconds{10});
+    tick_profile.add(TickPhase::COLLIDE, nanoseconds{20});
+    tick_profile.end_tick();
+    tick_profile.add(TickPhase::COLLIDE, nanoseconds{5});
+    tick_profile.end_tick();
+    EXPECT_THAT(tick_profile.times(TickPhase::COLLIDE).max.count(), Eq(30));
+    EXPECT_THAT(tick_profile.times(TickPhase::COLLIDE, 1).max.count(), Eq(5));
+}
+
+int64_t fake_allocations = 0;
+int64_t fake_allocation_count() { return fake_allocations; }
+
+TEST_F(TickProfileTest, CountsAllocations) {
+    tick_profile.set_allocation_counter(fake_allocation_count);
+    tick_profile.reset();
+    fake_allocations += 3;
+    tick_profile.end_tick();
+    tick_profile.end_tick();
+    fake_allocations += 1;
+    tick_profile.end_tick();
+    tick_profile.set_allocation_counter(nullptr);
+    EXPECT_THAT(tick_profile.tick_allocations(), ElementsAre(3, 0, 1));
+}
+
+TEST_F(TickProfileTest, Disabled) {
+    tick_profile.set_enabled(false);
+    {
+        PhaseTimer timer(TickPhase::THINK);
+    }
+    tick_profile.end_tick();
+    EXPECT_THAT(tick_profile.times(TickPhase::THINK).ticks, Eq(0));
+}
+
+}  // namespace
+}  // namespace antares
@@ -0,0 +1,129 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/render-frame.hpp"
+
+#include <stdlib.h>
+#include <chrono>
+
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/starfield.hpp"
+#include "game/vector.hpp"
+
+namespace antares {
+
+// Farther than anything moves in one tick on screen; a sprite or star that jumps farther was
+// warped, wrapped around, or replaced, and is drawn where it is now.
+static const int32_t kMaxInterpolatedDistance = 128;
+
+void RenderFrame::capture(wall_time at) {
+    this->at = at;
+    scale    = gAbsoluteScale;
+    capture_sprites(this);
+    Vectors::capture(this);
+    globals()->starfield.capture(this);
+    Label::capture(this);
+    capture_instruments(this);
+}
+
+void RenderFrames::reset() {
+    for (RenderFrame& frame : _frames) {
+        frame.at = wall_time();
+        frame.sprites.clear();
+        frame.vectors.clear();
+        frame.stars.clear();
+        frame.sparks.clear();
+        frame.labels.clear();
+        frame.instruments.ship     = false;
+        frame.instruments.building = false;
+        frame.instruments.radar_on = false;
+        frame.instruments.radar_blips.clear();
+    }
+}
+
+void RenderFrames::publish(wall_time at) {
+    _current = 1 - _current;
+    _frames[_current].capture(at);
+}
+
+Point interpolate(Point from, Point to, double fraction) {
+    if ((abs(to.h - from.h) > kMaxInterpolatedDistance) ||
+        (abs(to.v - from.v) > kMaxInterpolatedDistance)) {
+        return to;
+    }
+    return Point(
+            from.h + int32_t((to.h - from.h) * fraction),
+            from.v + int32_t((to.v - from.v) * fraction));
+}
+
+namespace {
+
+// Moves each of `to` which has a counterpart in `from` (both are sorted by number). Something
+// that took over a freed number is not a counterpart: it would slide from where the old one was.
+template <typename T, typename F>
+void move_matching(const std::vector<T>& from, std::vector<T>& to, F move) {
+    auto it = from.begin();
+    for (T& x : to) {
+        while ((it != from.end()) && (it->number < x.number)) {
+            ++it;
+        }
+        if ((it != from.end()) && (it->number == x.number) &&
+            (it->generation == x.generation)) {
+            move(*it, x);
+        }
+    }
+}
+
+}  // namespace
+
+const RenderFrame& RenderFrames::blend(wall_time now) {
+    const RenderFrame& from = previous();
+    const RenderFrame& to   = current();
+    if ((from.at == wall_time()) || (to.at <= from.at) || (now >= to.at + (to.at - from.at))) {
+        return to;
+    }
+    double fraction = 0.0;
+    if (now > to.at) {
+        fraction = std::chrono::duration<double>(now - to.at) /
+                   std::chrono::duration<double>(to.at - from.at);
+    }
+
+    _blended = to;
+    move_matching(
+            from.sprites, _blended.sprites,
+            [fraction](const RenderFrame::SpriteView& a, RenderFrame::SpriteView& b) {
+                b.where = interpolate(a.where, b.where, fraction);
+            });
+    move_matching(
+            from.stars, _blended.stars,
+            [fraction](const RenderFrame::StarView& a, RenderFrame::StarView& b) {
+                b.location = interpolate(a.location, b.location, fraction);
+            });
+    move_matching(
+            from.labels, _blended.labels,
+            [fraction](const RenderFrame::LabelView& a, RenderFrame::LabelView& b) {
+                Point p = interpolate(
+                        Point(a.rect.left, a.rect.top), Point(b.rect.left, b.rect.top), fraction);
+                b.rect.offset(p.h - b.rect.left, p.v - b.rect.top);
+            });
+    return _blended;
+}
+
+}  // namespace antares
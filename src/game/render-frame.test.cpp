@@ -0,0 +1,44 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/render-frame.hpp"
+
+#include <gmock/gmock.h>
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using RenderFrameTest = testing::Test;
+
+TEST_F(RenderFrameTest, Interpolate) {
+    EXPECT_THAT(interpolate({0, 0}, {10, -20}, 0.0), Eq(Point{0, 0}));
+    EXPECT_THAT(interpolate({0, 0}, {10, -20}, 0.5), Eq(Point{5, -10}));
+    EXPECT_THAT(interpolate({0, 0}, {10, -20}, 1.0), Eq(Point{10, -20}));
+    EXPECT_THAT(interpolate({100, 100}, {90, 110}, 0.25), Eq(Point{98, 102}));
+}
+
+TEST_F(RenderFrameTest, Jump) {
+    // Too far to have moved in one tick: drawn where it is now, not sliding across the screen.
+    EXPECT_THAT(interpolate({0, 0}, {500, 0}, 0.5), Eq(Point{500, 0}));
+    EXPECT_THAT(interpolate({0, 0}, {0, -500}, 0.5), Eq(Point{0, -500}));
+}
+
+}  // namespace
+}  // namespace antares
@@ -0,0 +1,181 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/rollback.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "config/keys.hpp"
+#include "config/preferences.hpp"
+#include "data/base-object.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/level.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+
+namespace antares {
+
+// The flagship key that a logged key presses, or 0 for keys that aren't logged.
+static uint32_t flagship_key(uint8_t key) {
+    switch (key) {
+        case kUpKeyNum: return kUpKey;
+        case kDownKeyNum: return kDownKey;
+        case kLeftKeyNum: return kLeftKey;
+        case kRightKeyNum: return kRightKey;
+        case kOneKeyNum: return kPulseKey;
+        case kTwoKeyNum: return kBeamKey;
+        case kEnterKeyNum: return kSpecialKey;
+        case kWarpKeyNum: return kWarpKey;
+        default: return 0;
+    }
+}
+
+static void apply(Handle<Admiral> player, const ReplayData::Action& action) {
+    auto flagship = player->flagship();
+    if (!flagship.get() || !flagship->active || !(flagship->attributes & kIsPlayerShip)) {
+        return;
+    }
+    for (uint8_t key : action.keys_down) {
+        flagship->keysDown |= flagship_key(key) & ~g.key_mask;
+    }
+    for (uint8_t key : action.keys_up) {
+        flagship->keysDown &= ~(flagship_key(key) & ~g.key_mask);
+    }
+}
+
+static bool before(const ReplayData::Action& action, uint64_t at) { return action.at < at; }
+
+Rollback::Rollback(std::vector<Handle<Admiral>> players) {
+    for (auto player : players) {
+        _logs.emplace_back();
+        _logs.back().player = player;
+    }
+}
+
+void Rollback::start() {
+    for (Log& log : _logs) {
+        log.through = 0;
+        log.actions.clear();
+    }
+    _tail         = 0;
+    _head         = 0;
+    _tail_sync    = g.sync;
+    _mispredicted = false;
+    _stats        = RollbackStats{};
+    _snapshot.save(&_player_ship);
+}
+
+void Rollback::receive(
+        Handle<Admiral> player, uint64_t through, const std::vector<ReplayData::Action>& actions) {
+    for (Log& log : _logs) {
+        if (log.player != player) {
+            continue;
+        }
+        for (const auto& action : actions) {
+            if ((action.at <= log.through) || (action.at > through)) {
+                continue;  // Already logged, or sent ahead of what `through` vouches for.
+            }
+            if (action.at <= _head) {
+                _mispredicted = true;
+            }
+            log.actions.push_back(action);
+        }
+        log.through = std::max(log.through, through);
+        return;
+    }
+    throw std::runtime_error(pn::format("no input log for admiral {0}", player.number()).c_str());
+}
+
+uint64_t Rollback::advance(uint64_t at) {
+    auto    start     = std::chrono::steady_clock::now();
+    int64_t simulated = 0;
+
+    uint64_t through = std::min<uint64_t>(at, _tail + kMaxPrediction);
+    for (const Log& log : _logs) {
+        through = std::min(through, log.through);
+    }
+
+    if (_mispredicted || (through > _tail)) {
+        if (_head != _tail) {
+            _snapshot.restore(&_player_ship);
+            _head = _tail;
+            ++_stats.rollbacks;
+        }
+        for (; _head < through; ++simulated) {
+            simulate();
+        }
+        if (_tail != _head) {
+            _tail      = _head;
+            _tail_sync = g.sync;
+            _snapshot.save(&_player_ship);
+            for (Log& log : _logs) {
+                log.actions.erase(
+                        log.actions.begin(),
+                        std::lower_bound(
+                                log.actions.begin(), log.actions.end(), _tail + 1, before));
+            }
+        }
+        _mispredicted = false;
+    }
+
+    at = std::min<uint64_t>(at, _tail + kMaxPrediction);
+    for (; (_head < at) && (simulated < kMaxPrediction); ++simulated) {
+        simulate();
+    }
+
+    auto   elapsed = std::chrono::steady_clock::now() - start;
+    double micros  = std::chrono::duration<double, std::micro>(elapsed).count();
+    _stats.most        = std::max(_stats.most, simulated);
+    _stats.most_micros = std::max(_stats.most_micros, micros);
+    _stats.simulated += simulated;
+    return _head;
+}
+
+// The local player's keys are sent to the PlayerShip as events, as ReplayInputSource sends them;
+// anyone else's are applied to their flagship directly.
+bool Rollback::LogInput::get(Handle<Admiral> admiral, game_ticks at, EventReceiver& receiver) {
+    const uint64_t tick = _rollback._head;
+    for (const Log& log : _rollback._logs) {
+        auto it = std::lower_bound(log.actions.begin(), log.actions.end(), tick, before);
+        for (; (it != log.actions.end()) && (it->at == tick); ++it) {
+            if (log.player != admiral) {
+                apply(log.player, *it);
+                continue;
+            }
+            for (uint8_t key : it->keys_down) {
+                receiver.key_down(KeyDownEvent(wall_time(), sys.prefs->key(key)));
+            }
+            for (uint8_t key : it->keys_up) {
+                receiver.key_up(KeyUpEvent(wall_time(), sys.prefs->key(key)));
+            }
+        }
+    }
+    return true;
+}
+
+void Rollback::simulate() {
+    ++_head;
+    for (ticks t = ticks(0); t < kMajorTick; t += kMinorTick) {
+        play_tick(kMinorTick, &_input, &_player_ship);
+        end_play_tick();
+    }
+}
+
+}  // namespace antares
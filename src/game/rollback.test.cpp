@@ -0,0 +1,256 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/rollback.hpp"
+
+#include <gmock/gmock.h>
+#include <map>
+#include <random>
+
+#include "config/keys.hpp"
+#include "data/level.hpp"
+#include "game/condition.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/instruments.hpp"
+#include "game/main.hpp"
+#include "game/player-ship.hpp"
+#include "game/space-object.hpp"
+#include "game/test-level.hpp"
+
+namespace antares {
+namespace {
+
+const uint64_t kDuration   = 1200;  // Major ticks; one minute.
+const uint64_t kCheckEvery = 300;   // Major ticks between checks against a replay.
+
+// Random presses and releases of the flagship keys, about one every eight major ticks. None fall
+// on a check, since a replay that ends on a major tick doesn't take input for it.
+std::vector<ReplayData::Action> random_input(uint32_t seed) {
+    std::mt19937                    engine{seed};
+    std::vector<ReplayData::Action> actions;
+    uint32_t                        held = 0;
+    for (uint64_t at = 1; at <= kDuration; ++at) {
+        if ((engine() % 8) || ((at % kCheckEvery) == 0)) {
+            continue;
+        }
+        ReplayData::Action action;
+        action.at   = at;
+        uint8_t key = engine() % (kWarpKeyNum + 1);
+        if (held & (1 << key)) {
+            action.keys_up.push_back(key);
+        } else {
+            action.keys_down.push_back(key);
+        }
+        held ^= (1 << key);
+        actions.push_back(action);
+    }
+    return actions;
+}
+
+// Sends a player's input log over a pretend connection. Every major tick, the sender sends the
+// input it has logged since shortly before the receiver's last known position, and each message
+// takes `latency` major ticks to arrive, plus up to `jitter` more, so they arrive out of order.
+class Loopback {
+  public:
+    Loopback(const std::vector<ReplayData::Action>& input, int latency, int jitter)
+            : _input(input), _latency(latency), _jitter(jitter), _engine(0x5eed) {}
+
+    void send(uint64_t at) {
+        Message m;
+        m.through = at;
+        for (const auto& action : _input) {
+            if ((action.at + _jitter + 2 > at) && (action.at <= at)) {
+                m.actions.push_back(action);
+            }
+        }
+        uint64_t arrival = at + _latency + (_engine() % (_jitter + 1));
+        _messages.emplace(arrival, std::move(m));
+    }
+
+    void deliver(uint64_t at, Handle<Admiral> player, Rollback* rollback) {
+        while (!_messages.empty() && (_messages.begin()->first <= at)) {
+            const Message& m = _messages.begin()->second;
+            rollback->receive(player, m.through, m.actions);
+            _messages.erase(_messages.begin());
+        }
+    }
+
+  private:
+    struct Message {
+        uint64_t                        through;
+        std::vector<ReplayData::Action> actions;
+    };
+
+    const std::vector<ReplayData::Action>& _input;
+    const int                              _latency;
+    const int                              _jitter;
+    std::mt19937                           _engine;
+    std::multimap<uint64_t, Message>       _messages;
+};
+
+class RollbackTest : public testing::TestWithParam<int32_t> {
+  protected:
+    // Plays `input` as a replay that ends at major tick `through`, and returns the major tick
+    // that the level actually ended at, which is earlier if it was won or lost first, and g.sync
+    // as of then.
+    std::pair<uint64_t, uint32_t> replay(
+            const std::vector<ReplayData::Action>& input, uint64_t through) {
+        ReplayData data;
+        data.duration = through;
+        data.actions  = input;
+        ReplayInputSource replay_input(&data);
+        g.random.seed = 0;
+        simulate_level(*Level::get(GetParam()), &replay_input);
+        return {g.time.time_since_epoch() / kMajorTick, g.sync};
+    }
+
+    // Loads the level and begins play, as simulate_loaded_level() does.
+    void play() {
+        _level.load(GetParam());
+        set_up_instruments();
+        CheckLevelConditions();
+    }
+
+    // Puts a player at the helm of `admiral`'s flagship, or if it has none, of one of its ships, as
+    // a net game would for a player on another machine. Its keys then come from the player's
+    // input log, and it stops thinking for itself.
+    void take_helm(Handle<Admiral> admiral) {
+        auto ship = admiral->flagship();
+        if (!ship.get()) {
+            for (auto o : SpaceObject::by_age()) {
+                if (o->active && (o->owner == admiral) && (o->attributes & kCanAcceptDestination)) {
+                    ship = o;
+                    break;
+                }
+            }
+        }
+        ASSERT_TRUE(ship.get()) << "admiral " << admiral.number() << " has no ships";
+        ship->attributes |= kIsPlayerShip;
+        admiral->set_flagship(ship);
+    }
+
+    const Handle<Admiral> _first{0};   // Flies the player's flagship, through a PlayerShip.
+    const Handle<Admiral> _second{1};  // Applies its input to its flagship directly.
+
+    TestLevel _level;
+};
+
+// Checks tail against replays of the same input, which run through simulate_level() and not
+// Rollback. The second player sends no input. To make tail stop on each major tick that's
+// checked, it confirms its empty log only up to the next one until tail gets there.
+TEST_P(RollbackTest, ConvergesToReplay) {
+    const auto                   input = random_input(GetParam());
+    std::map<uint64_t, uint32_t> expected;
+    for (uint64_t through = kCheckEvery; through <= kDuration; through += kCheckEvery) {
+        expected.insert(replay(input, through));
+    }
+    const uint64_t end = expected.rbegin()->first;
+
+    play();
+    Rollback rollback({_first, _second});
+    rollback.start();
+    Loopback first(input, 6, 4);
+    auto     check   = expected.begin();
+    int      checked = 0;
+    for (uint64_t at = 1; (at <= 2 * kDuration) && (rollback.tail() < end); ++at) {
+        uint64_t now = std::min(at, kDuration);
+        if (at <= kDuration) {
+            first.send(at);
+        }
+        first.deliver(at, _first, &rollback);
+        rollback.receive(_second, std::min(now, check->first), {});
+        rollback.advance(now);
+
+        ASSERT_THAT(rollback.tail(), testing::Le(check->first));
+        if (rollback.tail() == check->first) {
+            EXPECT_THAT(rollback.tail_sync(), testing::Eq(check->second))
+                    << "tail " << rollback.tail();
+            ++checked;
+            if (std::next(check) != expected.end()) {
+                ++check;
+            }
+        }
+    }
+
+    EXPECT_THAT(checked, testing::Eq(expected.size()));
+    EXPECT_THAT(rollback.tail(), testing::Eq(end));
+    EXPECT_THAT(rollback.stats().rollbacks, testing::Gt(0));
+    EXPECT_THAT(rollback.stats().most, testing::Le(kMaxPrediction));
+}
+
+// Both players send input over pretend connections, and the second flies admiral 1's flagship, so
+// their keys are applied to it directly rather than through a PlayerShip. A replay can't hold the
+// second player's input, so tail is checked instead against a rollback that had everyone's input
+// from the start, and so never predicted, at every major tick that tail stops on.
+TEST_P(RollbackTest, SecondPlayerConverges) {
+    const auto first_input  = random_input(GetParam());
+    const auto second_input = random_input(GetParam() + 1000);
+
+    std::vector<uint32_t> expected{0};
+    {
+        play();
+        take_helm(_second);
+        Rollback rollback({_first, _second});
+        rollback.start();
+        expected[0] = rollback.tail_sync();
+        rollback.receive(_first, kDuration, first_input);
+        rollback.receive(_second, kDuration, second_input);
+        for (uint64_t at = 1; at <= kDuration; ++at) {
+            rollback.advance(at);
+            ASSERT_THAT(rollback.tail(), testing::Eq(at));
+            expected.push_back(rollback.tail_sync());
+        }
+        EXPECT_THAT(rollback.stats().rollbacks, testing::Eq(0));
+    }
+
+    play();
+    take_helm(_second);
+    Rollback rollback({_first, _second});
+    rollback.start();
+    Loopback first(first_input, 6, 4);
+    Loopback second(second_input, 3, 8);
+    int      checked = 0;
+    for (uint64_t at = 1; (at <= 2 * kDuration) && (rollback.tail() < kDuration); ++at) {
+        uint64_t now = std::min(at, kDuration);
+        if (at <= kDuration) {
+            first.send(at);
+            second.send(at);
+        }
+        first.deliver(at, _first, &rollback);
+        second.deliver(at, _second, &rollback);
+        uint64_t tail = rollback.tail();
+        rollback.advance(now);
+
+        if (rollback.tail() != tail) {
+            EXPECT_THAT(rollback.tail_sync(), testing::Eq(expected[rollback.tail()]))
+                    << "tail " << rollback.tail();
+            ++checked;
+        }
+    }
+
+    EXPECT_THAT(checked, testing::Gt(0));
+    EXPECT_THAT(rollback.tail(), testing::Eq(kDuration));
+    EXPECT_THAT(rollback.stats().rollbacks, testing::Gt(0));
+    EXPECT_THAT(rollback.stats().most, testing::Le(kMaxPrediction));
+}
+
+INSTANTIATE_TEST_CASE_P(Chapters, RollbackTest, testing::Values(1, 4, 9, 15));
+
+}  // namespace
+}  // namespace antares
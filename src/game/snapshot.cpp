@@ -0,0 +1,186 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/snapshot.hpp"
+
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/messages.hpp"
+#include "game/minicomputer.hpp"
+#include "game/player-ship.hpp"
+#include "game/space-object.hpp"
+#include "game/vector.hpp"
+
+namespace antares {
+
+static void snapshot(SnapshotArchive& a, Destination& d) {
+    a.value(d.whichObject);
+    a.each(d.canBuildType, [](SnapshotArchive& a, BuildableObject& b) { a.string(b.name); });
+    a.value(d.occupied);
+    a.value(d.earn);
+    a.value(d.buildTime);
+    a.value(d.totalBuildTime);
+    a.value(d.buildObjectBaseNum);
+    a.string(d.name);
+}
+
+static void snapshot(SnapshotArchive& a, ConditionCheck& c) {
+    a.value(c.valid);
+    a.value(c.value);
+    a.vector(c.inputs);
+}
+
+// Space objects, vectors, and sprites are copied byte-for-byte, so they must not gain members
+// that own memory (strings, vectors, and the like).
+static void snapshot(SnapshotArchive& a, GlobalState& state) {
+    a.value(state.sync);
+    a.value(state.time);
+    a.value(state.random);
+    a.value(state.level);
+    a.value(state.angle);
+    a.value(state.random_mode);
+    a.value(state.level_seed);
+    a.value(state.random_streams);
+
+    for (size_t i = 0; i < kMaxPlayerNum; ++i) {
+        state.admirals[i].snapshot(a);
+    }
+    a.value(state.admiral);
+
+    a.pool(state.objects);
+    a.vector(state.generations);
+    a.vector(state.free_objects);
+    a.vector(state.active_objects);
+    a.value(state.ship);
+
+    a.pool(state.vectors);
+    for (int i = 0; i < kMaxDestObject; ++i) {
+        snapshot(a, state.destinations[i]);
+    }
+    a.pool(state.sprites);
+
+    a.vector(state.initials);
+
+    a.bits(state.condition_enabled);
+    a.each(state.condition_checks, [](SnapshotArchive& a, ConditionCheck& c) { snapshot(a, c); });
+    a.vector(state.condition_inputs.admirals);
+    a.vector(state.condition_inputs.objects);
+
+    state.action_queue.snapshot(a);
+
+    a.value(state.game_over);
+    a.value(state.game_over_at);
+    a.value(state.victor);
+    a.value(state.next_level);
+    a.string(state.victory_text);
+
+    a.value(state.radar_count);
+    a.value(state.radar_on);
+    a.value(state.key_mask);
+
+    minicomputer_snapshot(a);
+    Messages::snapshot(a);
+
+    a.value(state.zoom);
+    a.value(state.closest);
+    a.value(state.farthest);
+}
+
+Snapshot::Snapshot()  = default;
+Snapshot::~Snapshot() = default;
+
+static void snapshot(SnapshotArchive& a, GlobalState& state, PlayerShip* player_ship) {
+    snapshot(a, state);
+    if (player_ship) {
+        player_ship->snapshot(a);
+    }
+}
+
+void Snapshot::save(PlayerShip* player_ship) {
+    SnapshotArchive a(true, _arena.get(), _capacity);
+    snapshot(a, g, player_ship);
+    if (a.size() > _capacity) {
+        // Didn't fit; make room for this state and then some, and try again.
+        _capacity = a.size() + (a.size() / 4);
+        _arena.reset(new uint8_t[_capacity]);
+        SnapshotArchive retry(true, _arena.get(), _capacity);
+        snapshot(retry, g, player_ship);
+    }
+    _size = a.size();
+}
+
+void Snapshot::restore(PlayerShip* player_ship) {
+    if (empty()) {
+        throw std::runtime_error("no snapshot to restore");
+    }
+    SnapshotArchive a(false, _arena.get(), _size);
+    snapshot(a, g, player_ship);
+}
+
+void SnapshotArchive::bits(std::vector<bool>& v) {
+    size_t count = v.size();
+    value(count);
+    if (!_saving) {
+        v.resize(count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        bool bit = v[i];
+        value(bit);
+        v[i] = bit;
+    }
+}
+
+void SnapshotArchive::string(pn::string& s) {
+    if (_saving) {
+        save_string(s);
+    } else {
+        pn::string_view saved = load_string();
+        if (saved != s) {
+            s = saved.copy();
+        }
+    }
+}
+
+void SnapshotArchive::string(sfz::optional<pn::string>& s) {
+    bool has_value = s.has_value();
+    value(has_value);
+    if (!has_value) {
+        s.reset();
+        return;
+    } else if (!s.has_value()) {
+        s.emplace();
+    }
+    string(*s);
+}
+
+void SnapshotArchive::save_string(pn::string_view s) {
+    int size = s.size();
+    value(size);
+    bytes(const_cast<char*>(s.data()), size);
+}
+
+pn::string_view SnapshotArchive::load_string() {
+    int size = 0;
+    value(size);
+    pn::string_view s(reinterpret_cast<const char*>(_arena + _size), size);
+    _size += size;
+    return s;
+}
+
+}  // namespace antares
@@ -0,0 +1,143 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "game/snapshot.hpp"
+
+#include <gmock/gmock.h>
+#include <memory>
+
+#include "config/keys.hpp"
+#include "data/replay.hpp"
+#include "game/condition.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/instruments.hpp"
+#include "game/level.hpp"
+#include "game/player-ship.hpp"
+#include "game/space-object.hpp"
+#include "game/test-level.hpp"
+
+using testing::ElementsAreArray;
+
+namespace antares {
+namespace {
+
+// Presses and releases each of the flagship keys in turn, one change every six major ticks, for
+// long enough to outlast any test here. ReplayInputSource looks input up by time, so after a
+// restore, the same input comes again.
+ReplayData scripted_input() {
+    ReplayData data;
+    data.duration = 100000;
+    for (uint64_t at = 6; at < 4000; at += 6) {
+        ReplayData::Action action;
+        action.at   = at;
+        uint8_t key = (at / 12) % (kWarpKeyNum + 1);
+        if ((at / 6) % 2) {
+            action.keys_down.push_back(key);
+        } else {
+            action.keys_up.push_back(key);
+        }
+        data.actions.push_back(action);
+    }
+    return data;
+}
+
+class SnapshotTest : public testing::TestWithParam<int32_t> {
+  protected:
+    // Loads the level and begins play, as simulate_loaded_level() does.
+    void play() {
+        _level.load(GetParam());
+        ReplayData data = scripted_input();
+        _input.reset(new ReplayInputSource(&data));
+        set_up_instruments();
+        CheckLevelConditions();
+    }
+
+    // Runs the simulation for `count` major ticks, through play_tick() as a game or replay does,
+    // and returns g.sync after each one.
+    std::vector<uint32_t> run(int count) {
+        std::vector<uint32_t> sync;
+        for (int i = 0; i < count; ++i) {
+            for (ticks t = ticks(0); t < kMajorTick; t += kMinorTick) {
+                play_tick(kMinorTick, _input.get(), &_player_ship);
+                end_play_tick();
+            }
+            sync.push_back(g.sync);
+        }
+        return sync;
+    }
+
+    // Adds copies of the level's initial objects, enough to make the object pool grow.
+    void crowd() {
+        for (int i = 0; i < kMaxSpaceObject; ++i) {
+            auto source = g.initials[i % g.initials.size()];
+            if (!source.get() || !source->active) {
+                continue;
+            }
+            fixedPointType velocity = {Fixed::zero(), Fixed::zero()};
+            Point          location = source->location;
+            location.h += i;
+            CreateAnySpaceObject(
+                    *source->base, &velocity, &location, 0, source->owner, 0, sfz::nullopt);
+        }
+    }
+
+    TestLevel                          _level;
+    std::unique_ptr<ReplayInputSource> _input;
+    PlayerShip                         _player_ship;
+};
+
+TEST_P(SnapshotTest, RoundTrip) {
+    play();
+    run(200);
+
+    Snapshot snapshot;
+    snapshot.save(&_player_ship);
+    auto expected = run(600);
+
+    snapshot.restore(&_player_ship);
+    EXPECT_THAT(run(600), ElementsAreArray(expected));
+
+    // Restoring doesn't use up the snapshot.
+    snapshot.restore(&_player_ship);
+    EXPECT_THAT(run(600), ElementsAreArray(expected));
+}
+
+TEST_P(SnapshotTest, RestoreShrinksPools) {
+    play();
+    run(200);
+
+    Snapshot snapshot;
+    snapshot.save(&_player_ship);
+    int32_t capacity = g.objects.size();
+    auto    expected = run(200);
+
+    snapshot.restore(&_player_ship);
+    crowd();
+    EXPECT_THAT(g.objects.size(), testing::Gt(capacity));
+    run(100);
+
+    snapshot.restore(&_player_ship);
+    EXPECT_THAT(g.objects.size(), testing::Eq(capacity));
+    EXPECT_THAT(run(200), ElementsAreArray(expected));
+}
+
+INSTANTIATE_TEST_CASE_P(Chapters, SnapshotTest, testing::Values(1, 4, 9, 15));
+
+}  // namespace
+}  // namespace antares
@@ -18,6 +18,8 @@
 
 #include "game/space-object.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <pn/output>
 #include <set>
 
@@ -29,6 +31,7 @@
 #include "drawing/sprite-handling.hpp"
 #include "game/action.hpp"
 #include "game/admiral.hpp"
+#include "game/condition.hpp"
 #include "game/globals.hpp"
 #include "game/labels.hpp"
 #include "game/level.hpp"
@@ -63,26 +66,58 @@ const Hue kFriendlyColor               = Hue::GREEN;
 const Hue kHostileColor[kMaxPlayerNum] = {Hue::PINK, Hue::RED, Hue::YELLOW, Hue::ORANGE};
 const Hue kNeutralColor                = Hue::SKY_BLUE;
 
+static void reset_free_space_objects() {
+    g.free_objects.clear();
+    for (auto obj : SpaceObject::slots()) {
+        if (!obj->active) {
+            g.free_objects.push_back(obj.number());
+        }
+    }
+    std::make_heap(g.free_objects.begin(), g.free_objects.end(), std::greater<int32_t>());
+}
+
+static void grow_space_objects() {
+    int32_t old_size = g.objects.size();
+    g.objects.grow(old_size + 1);
+    g.generations.resize(g.objects.size(), 0);
+    g.condition_inputs.objects.resize(g.objects.size(), 0);
+    for (int32_t i = old_size; i < g.objects.size(); ++i) {
+        g.objects.get(i)->_number = i;
+        g.free_objects.push_back(i);
+        std::push_heap(g.free_objects.begin(), g.free_objects.end(), std::greater<int32_t>());
+    }
+}
+
 void SpaceObjectHandlingInit() {
-    g.objects.reset(new SpaceObject[kMaxSpaceObject]);
+    g.objects.reset(kMaxSpaceObject);
+    g.generations.assign(g.objects.size(), 0);
+    g.condition_inputs.objects.assign(g.objects.size(), 0);
+    for (auto obj : SpaceObject::slots()) {
+        obj->_number = obj.number();
+    }
     ResetAllSpaceObjects();
     reset_action_queue();
 }
 
 void ResetAllSpaceObjects() {
-    g.root = SpaceObject::none();
-    for (auto anObject : SpaceObject::all()) {
-        anObject->active = kObjectAvailable;
-        anObject->sprite = Sprite::none();
+    g.active_objects.clear();
+    for (auto anObject : SpaceObject::slots()) {
+        if (anObject->active) {
+            ++g.generations[anObject.number()];
+        }
+        anObject->active     = kObjectAvailable;
+        anObject->sprite     = Sprite::none();
+        anObject->_age_index = -1;
     }
+    reset_free_space_objects();
 }
 
 BaseObject* BaseObject::get(int number) { return get(pn::dump(number, pn::dump_short)); }
 
 BaseObject* BaseObject::get(pn::string_view name) {
-    auto it = plug.objects.find(name.copy());
-    if (it != plug.objects.end()) {
-        return &it->second;
+    auto it = plug.objects_by_name.find(name);
+    if (it != plug.objects_by_name.end()) {
+        return it->second;
     }
     return nullptr;
 }
@@ -98,20 +133,39 @@ NamedHandle<const BaseObject> get_buildable_object_handle(
 
 const BaseObject* get_buildable_object(
         const BuildableObject& o, const NamedHandle<const Race>& race) {
-    pn::string race_object = pn::format("{0}/{1}", race.name(), o.name);
+    pn::string_view race_object = tick_arena.join({race.name(), "/", o.name});
     if (auto base = BaseObject::get(race_object)) {
         return base;
     }
     return BaseObject::get(o.name);
 }
 
+// Always picks the lowest available number, as a linear scan of the slots would; replays
+// depend on the order in which objects are visited.
 static Handle<SpaceObject> next_free_space_object() {
-    for (auto obj : SpaceObject::all()) {
-        if (!obj->active) {
-            return obj;
-        }
+    if (g.free_objects.empty()) {
+        grow_space_objects();
     }
-    return SpaceObject::none();
+    std::pop_heap(g.free_objects.begin(), g.free_objects.end(), std::greater<int32_t>());
+    int32_t number = g.free_objects.back();
+    g.free_objects.pop_back();
+    return Handle<SpaceObject>(number);
+}
+
+// Where a new object's seed comes from. Streams are keyed by the number and generation that
+// next_free_space_object() is about to hand out.
+static RandomSource new_space_object_random() {
+    int32_t number     = g.free_objects.empty() ? g.objects.size() : g.free_objects.front();
+    int32_t generation = (number < g.generations.size()) ? g.generations[number] : 0;
+    return random_source(RandomPurpose::OBJECT, number, generation);
+}
+
+static void release_space_object(SpaceObject* obj) {
+    obj->active = kObjectAvailable;
+    ++g.generations[obj->number()];
+    mark_conditions_dirty(*obj);
+    g.free_objects.push_back(obj->number());
+    std::push_heap(g.free_objects.begin(), g.free_objects.end(), std::greater<int32_t>());
 }
 
 static uint8_t get_tiny_shade(const SpaceObject& o) {
@@ -151,7 +205,9 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
         }
     }
 
-    *obj = *sourceObject;
+    *obj         = *sourceObject;
+    obj->_number = obj.number();
+    mark_conditions_dirty(*obj);
 
     if (obj->sprite.get()) {
         RemoveSprite(obj->sprite);
@@ -178,7 +234,7 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
         if (!obj->sprite.get()) {
             g.game_over    = true;
             g.game_over_at = g.time;
-            obj->active    = kObjectAvailable;
+            release_space_object(obj.get());
             return SpaceObject::none();
         }
     }
@@ -191,30 +247,63 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
         }
     }
 
-    obj->nextObject     = g.root;
-    obj->previousObject = SpaceObject::none();
-    if (g.root.get()) {
-        g.root->previousObject = obj;
-    }
-    g.root = obj;
+    obj->_age_index = g.active_objects.size();
+    g.active_objects.push_back(obj.number());
 
     return obj;
 }
 
 void RemoveAllSpaceObjects() {
-    for (auto obj : SpaceObject::all()) {
+    for (auto obj : SpaceObject::slots()) {
         if (obj->sprite.get()) {
             RemoveSprite(obj->sprite);
             obj->sprite = Sprite::none();
         }
-        obj->active         = kObjectAvailable;
-        obj->nextNearObject = obj->nextFarObject = SpaceObject::none();
-        obj->attributes                          = 0;
+        if (obj->active) {
+            ++g.generations[obj.number()];
+        }
+        obj->active        = kObjectAvailable;
+        obj->nextFarObject = SpaceObject::none();
+        obj->attributes    = 0;
+        obj->_age_index    = -1;
+    }
+    g.active_objects.clear();
+    reset_free_space_objects();
+}
+
+Handle<SpaceObject> SpaceObject::newest() {
+    for (int32_t i = g.active_objects.size() - 1; i >= 0; --i) {
+        if (g.active_objects[i] >= 0) {
+            return Handle<SpaceObject>(g.active_objects[i]);
+        }
+    }
+    return SpaceObject::none();
+}
+
+Handle<SpaceObject> SpaceObject::older() const {
+    for (int32_t i = _age_index - 1; i >= 0; --i) {
+        if (g.active_objects[i] >= 0) {
+            return Handle<SpaceObject>(g.active_objects[i]);
+        }
     }
+    return SpaceObject::none();
+}
+
+// Removes the entries that free() left behind in g.active_objects, preserving the order of the
+// rest. Must not be called while iterating over SpaceObject::by_age().
+void CompactActiveObjects() {
+    int32_t size = 0;
+    for (int32_t number : g.active_objects) {
+        if (number >= 0) {
+            SpaceObject::get(number)->_age_index = size;
+            g.active_objects[size++]             = number;
+        }
+    }
+    g.active_objects.resize(size);
 }
 
 SpaceObject::SpaceObject(
-        const BaseObject& type, Random seed, int32_t object_id, const Point& initial_location,
+        const BaseObject& type, Random seed, const Point& initial_location,
         int32_t relative_direction, fixedPointType* relative_velocity, Handle<Admiral> new_owner,
         sfz::optional<pn::string_view> spriteIDOverride) {
     base       = &type;
@@ -222,7 +311,6 @@ SpaceObject::SpaceObject(
     randomSeed = seed;
     owner      = new_owner;
     location   = initial_location;
-    id         = object_id;
     sprite     = Sprite::none();
 
     attributes   = base->attributes;
@@ -383,6 +471,7 @@ void SpaceObject::change_base_type(
     obj->layer       = sprite_layer(base);
     obj->directionGoal = 0;
     obj->turnFraction = obj->turnVelocity = Fixed::zero();
+    mark_conditions_dirty(*obj);  // Its max health changes with its base.
 
     if (obj->attributes & kIsSelfAnimated) {
         obj->frame.animation.thisShape = base.animation->first.begin;
@@ -516,10 +605,13 @@ Handle<SpaceObject> CreateAnySpaceObject(
         const BaseObject& whichBase, fixedPointType* velocity, Point* location, int32_t direction,
         Handle<Admiral> owner, uint32_t specialAttributes,
         sfz::optional<pn::string_view> spriteIDOverride) {
-    Random      random{g.random.next(32766)};
-    int32_t     id = g.random.next(16384);
+    RandomSource source = new_space_object_random();
+    Random       random{source.next(32766)};
+    // Objects used to get a random id here, to detect stale references. Handles now carry a
+    // generation instead, but we still draw the value to maintain replay-compatibility.
+    source.next(16384);
     SpaceObject newObject(
-            whichBase, random, id, *location, direction, velocity, owner, spriteIDOverride);
+            whichBase, random, *location, direction, velocity, owner, spriteIDOverride);
 
     auto obj = AddSpaceObject(&newObject);
     if (!obj.get()) {
@@ -550,6 +642,7 @@ void SpaceObject::alter_health(int32_t amount) {
     } else {
         _health += amount;
     }
+    mark_conditions_dirty(*this);
     if (_health < 0) {
         destroy();
     }
@@ -605,6 +698,7 @@ void SpaceObject::set_owner(Handle<Admiral> new_owner, bool message) {
 
     Handle<Admiral> old_owner = object->owner;
     object->owner             = new_owner;
+    mark_conditions_dirty(*object);
 
     if (new_owner.get() && (object->attributes & kIsDestination)) {
         if (!new_owner->control().get()) {
@@ -666,10 +760,11 @@ void SpaceObject::set_owner(Handle<Admiral> new_owner, bool message) {
     }
     if (message) {
         if (new_owner.get()) {
-            Messages::add(
-                    pn::format("{0} captured by {1}.", object->long_name(), new_owner->name()));
+            Messages::add(tick_arena.join(
+                    {object->long_name(), " captured by ", new_owner->name(), "."}));
         } else if (old_owner.get()) {  // must be since can't both be -1
-            Messages::add(pn::format("{0} lost by {1}.", object->long_name(), old_owner->name()));
+            Messages::add(
+                    tick_arena.join({object->long_name(), " lost by ", old_owner->name(), "."}));
         }
     }
 }
@@ -702,6 +797,7 @@ void SpaceObject::destroy() {
         return;
     } else if (object->attributes & kNeutralDeath) {
         object->_health = object->max_health();
+        mark_conditions_dirty(*object);
         // if anyone is targeting it, they should stop
         for (auto fixObject : SpaceObject::all()) {
             if ((fixObject->attributes & kCanAcceptDestination) &&
@@ -763,22 +859,13 @@ void SpaceObject::free() {
             sprite->killMe = true;
         }
     }
-    active         = kObjectAvailable;
-    attributes     = 0;
-    nextNearObject = nextFarObject = SpaceObject::none();
-    if (previousObject.get()) {
-        auto bObject        = previousObject;
-        bObject->nextObject = nextObject;
-    }
-    if (nextObject.get()) {
-        auto bObject            = nextObject;
-        bObject->previousObject = previousObject;
+    release_space_object(this);
+    attributes    = 0;
+    nextFarObject = SpaceObject::none();
+    if (_age_index >= 0) {
+        g.active_objects[_age_index] = -1;
+        _age_index                   = -1;
     }
-    if (g.root.get() == this) {
-        g.root = nextObject;
-    }
-    nextObject     = SpaceObject::none();
-    previousObject = SpaceObject::none();
 
     // Unlink admirals' flagships, so we don't need to track the id of
     // each admiral's flagship.
@@ -834,8 +921,6 @@ bool SpaceObject::engages(const SpaceObject& b) const {
 
 Fixed SpaceObject::turn_rate() const { return base->turn_rate; }
 
-int32_t SpaceObject::number() const { return this - g.objects.get(); }
-
 bool tags_match(const BaseObject& o, const Tags& query) {
     for (const auto& kv : query.tags) {
         auto it      = o.tags.tags.find(kv.first);
@@ -25,6 +25,7 @@
 #include "drawing/sprite-handling.hpp"
 #include "game/globals.hpp"
 #include "game/motion.hpp"
+#include "game/render-frame.hpp"
 #include "game/space-object.hpp"
 #include "math/random.hpp"
 #include "video/driver.hpp"
@@ -63,6 +64,7 @@ void Starfield::reset() {
 
         star->speed = RandomStarSpeed();
         star->age   = 0;
+        ++star->generation;
     }
     for (scrollStarType* star : range(_stars + kSparkStarOffset, _stars + kAllStarNum)) {
         star->age = 0;
@@ -86,6 +88,7 @@ void Starfield::make_sparks(
             spark->age                                        = kMaxSparkAge;
             spark->speed                                      = sparkSpeed;
             spark->hue                                        = hue;
+            ++spark->generation;
 
             if (--sparkNum == 0) {
                 return;
@@ -170,6 +173,7 @@ void Starfield::move(ticks by_units) {
             star->motionFraction.h = star->motionFraction.v = Fixed::zero();
             star->speed                                     = RandomStarSpeed();
             star->age                                       = 0;
+            ++star->generation;
         } else if (
                 (star->location.h >= viewport.right) && (star->oldLocation.h >= viewport.right)) {
             star->location.h -= play_screen.width();
@@ -177,12 +181,14 @@ void Starfield::move(ticks by_units) {
             star->motionFraction.h = star->motionFraction.v = Fixed::zero();
             star->speed                                     = RandomStarSpeed();
             star->age                                       = 0;
+            ++star->generation;
         } else if ((star->location.v < viewport.top) && (star->oldLocation.v < viewport.top)) {
             star->location.h = Randomize(play_screen.width()) + viewport.left;
             star->location.v += play_screen.height() - 1;
             star->motionFraction.h = star->motionFraction.v = Fixed::zero();
             star->speed                                     = RandomStarSpeed();
             star->age                                       = 0;
+            ++star->generation;
         } else if (
                 (star->location.v >= play_screen.bottom) &&
                 (star->oldLocation.v >= play_screen.bottom)) {
@@ -191,6 +197,7 @@ void Starfield::move(ticks by_units) {
             star->motionFraction.h = star->motionFraction.v = Fixed::zero();
             star->speed                                     = RandomStarSpeed();
             star->age                                       = 0;
+            ++star->generation;
         }
 
         if (_warp_stars && (star->age == 0)) {
@@ -234,60 +241,62 @@ void Starfield::move(ticks by_units) {
     }
 }
 
-void Starfield::draw() const {
+void Starfield::capture(RenderFrame* frame) const {
     const RgbColor slowColor   = GetRGBTranslateColorShade(kStarColor, MEDIUM);
     const RgbColor mediumColor = GetRGBTranslateColorShade(kStarColor, LIGHT);
     const RgbColor fastColor   = GetRGBTranslateColorShade(kStarColor, LIGHTER);
 
     switch (g.ship.get() ? g.ship->presenceState : kNormalPresence) {
-        default:
-            if (!_warp_stars) {
-                Points points;
-                // we're not warping in any way
-                for (const scrollStarType* star : range(_stars, _stars + kScrollStarNum)) {
-                    if (star->speed != kNoStar) {
-                        const RgbColor* color = &slowColor;
-                        if (star->speed == kMediumStarSpeed) {
-                            color = &mediumColor;
-                        } else if (star->speed == kFastStarSpeed) {
-                            color = &fastColor;
-                        }
-
-                        points.draw(star->location, *color);
-                    }
-                }
-                break;
-            }
+        default: frame->star_streaks = _warp_stars; break;
 
         case kWarpInPresence:
         case kWarpOutPresence:
-        case kWarpingPresence: {
-            Lines lines;
-            for (const scrollStarType* star : range(_stars, _stars + kScrollStarNum)) {
-                if (star->speed != kNoStar) {
-                    const RgbColor* color = &slowColor;
-                    if (star->speed == kMediumStarSpeed) {
-                        color = &mediumColor;
-                    } else if (star->speed == kFastStarSpeed) {
-                        color = &fastColor;
-                    }
+        case kWarpingPresence: frame->star_streaks = true; break;
+    }
 
-                    if (star->age > 1) {
-                        lines.draw(star->location, star->oldLocation, *color);
-                    }
-                }
-            }
-            break;
+    frame->stars.clear();
+    for (int32_t i = 0; i < kScrollStarNum; ++i) {
+        const scrollStarType& star = _stars[i];
+        if ((star.speed == kNoStar) || (frame->star_streaks && (star.age <= 1))) {
+            continue;
+        }
+        const RgbColor* color = &slowColor;
+        if (star.speed == kMediumStarSpeed) {
+            color = &mediumColor;
+        } else if (star.speed == kFastStarSpeed) {
+            color = &fastColor;
         }
+        frame->stars.push_back({i, star.generation, star.location, star.oldLocation, *color});
     }
 
-    Points points;
-    for (const scrollStarType* star : range(_stars + kSparkStarOffset, _stars + kAllStarNum)) {
-        if ((star->speed != kNoStar) && (star->age > 0) && (viewport().contains(star->location))) {
+    frame->sparks.clear();
+    for (int32_t i = kSparkStarOffset; i < kAllStarNum; ++i) {
+        const scrollStarType& star = _stars[i];
+        if ((star.speed != kNoStar) && (star.age > 0) && (viewport().contains(star.location))) {
             const RgbColor color =
-                    GetRGBTranslateColorShade(star->hue, (star->age >> kSparkAgeToShadeShift) + 1);
-            points.draw(star->location, color);
+                    GetRGBTranslateColorShade(star.hue, (star.age >> kSparkAgeToShadeShift) + 1);
+            frame->sparks.push_back(
+                    {i, star.generation, star.location, star.oldLocation, color});
+        }
+    }
+}
+
+void Starfield::draw(const RenderFrame& frame) {
+    if (frame.star_streaks) {
+        Lines lines;
+        for (const RenderFrame::StarView& star : frame.stars) {
+            lines.draw(star.location, star.old_location, star.color);
         }
+    } else {
+        Points points;
+        for (const RenderFrame::StarView& star : frame.stars) {
+            points.draw(star.location, star.color);
+        }
+    }
+
+    Points points;
+    for (const RenderFrame::StarView& star : frame.sparks) {
+        points.draw(star.location, star.color);
     }
 }
 
@@ -0,0 +1,64 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/test-level.hpp"
+
+#include <pn/output>
+
+#include "data/plugin.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/level.hpp"
+#include "game/messages.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+
+namespace antares {
+
+TestLevel::TestLevel()
+        : _prefs(Preferences().copy()), _video({640, 480}, sfz::optional<pn::string>()) {
+    init_globals();
+    sys_init();
+    Label::init();
+    Messages::init();
+    InstrumentInit();
+    SpriteHandlingInit();
+    PluginInit();
+    SpaceObjectHandlingInit();  // MUST be after PluginInit()
+    Admiral::init();
+    Vectors::init();
+}
+
+void TestLevel::load(int32_t chapter) {
+    const Level* level = Level::get(chapter);
+    if (!level) {
+        throw std::runtime_error(pn::format("no chapter {0}", chapter).c_str());
+    }
+    g.random.seed = 0;
+    RemoveAllSpaceObjects();
+    g.game_over = false;
+    LoadState s = start_construct_level(*level);
+    while (!s.done) {
+        construct_level(&s);
+    }
+}
+
+}  // namespace antares
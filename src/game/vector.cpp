@@ -27,6 +27,8 @@
 #include "drawing/sprite-handling.hpp"
 #include "game/globals.hpp"
 #include "game/motion.hpp"
+#include "game/profile.hpp"
+#include "game/render-frame.hpp"
 #include "game/space-object.hpp"
 #include "lang/casts.hpp"
 #include "math/random.hpp"
@@ -64,16 +66,13 @@ void clear(T& t) {
 
 }  // namespace
 
-Vector* Vector::get(int number) {
-    if ((0 <= number) && (number <= size)) {
-        return &g.vectors[number];
-    }
-    return nullptr;
-}
+Vector* Vector::get(int number) { return g.vectors.get(number); }
+
+HandleList<Vector> Vector::all() { return HandleList<Vector>(0, g.vectors.size()); }
 
 Vector::Vector() : killMe(false), active(false) {}
 
-void Vectors::init() { g.vectors.reset(new Vector[Vector::size]); }
+void Vectors::init() { g.vectors.reset(Vector::size); }
 
 void Vectors::reset() {
     for (auto vector : Vector::all()) {
@@ -81,81 +80,79 @@ void Vectors::reset() {
     }
 }
 
-Handle<Vector> Vectors::add(Point* location, const BaseObject::Ray& r) {
+static Handle<Vector> next_free_vector() {
     for (auto vector : Vector::all()) {
         if (!vector->active) {
-            vector->lastGlobalLocation   = *location;
-            vector->objectLocation       = *location;
-            vector->lastApparentLocation = *location;
-            vector->killMe               = false;
-            vector->active               = true;
-            vector->visible              = r.hue.has_value();
-            vector->color                = RgbColor::clear();
-            vector->hue                  = r.hue;
-
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
-
-            vector->is_ray          = true;
-            vector->to_coord        = (r.to == BaseObject::Ray::To::COORD);
-            vector->lightning       = r.lightning;
-            vector->accuracy        = r.accuracy;
-            vector->range           = r.range;
-            vector->fromObjectID    = -1;
-            vector->fromObject      = SpaceObject::none();
-            vector->toObjectID      = -1;
-            vector->toObject        = SpaceObject::none();
-            vector->toRelativeCoord = Point(0, 0);
-            vector->boltState       = 0;
-
             return vector;
         }
     }
+    Handle<Vector> vector(g.vectors.size());
+    g.vectors.grow(g.vectors.size() + 1);
+    return vector;
+}
 
-    return Vector::none();
+Handle<Vector> Vectors::add(Point* location, const BaseObject::Ray& r) {
+    auto vector = next_free_vector();
+
+    vector->lastGlobalLocation   = *location;
+    vector->objectLocation       = *location;
+    vector->lastApparentLocation = *location;
+    vector->killMe               = false;
+    vector->active               = true;
+    vector->visible              = r.hue.has_value();
+    vector->color                = RgbColor::clear();
+    vector->hue                  = r.hue;
+
+    vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
+            scale_to_viewport(*location);
+
+    vector->is_ray          = true;
+    vector->to_coord        = (r.to == BaseObject::Ray::To::COORD);
+    vector->lightning       = r.lightning;
+    vector->accuracy        = r.accuracy;
+    vector->range           = r.range;
+    vector->fromObject      = SpaceObject::none();
+    vector->toObject        = SpaceObject::none();
+    vector->toRelativeCoord = Point(0, 0);
+    vector->boltState       = 0;
+
+    return vector;
 }
 
 Handle<Vector> Vectors::add(Point* location, const BaseObject::Bolt& b) {
-    for (auto vector : Vector::all()) {
-        if (!vector->active) {
-            vector->lastGlobalLocation   = *location;
-            vector->objectLocation       = *location;
-            vector->lastApparentLocation = *location;
-            vector->killMe               = false;
-            vector->active               = true;
-            vector->visible              = (b.color != RgbColor::clear());
-            vector->hue                  = sfz::nullopt;
-            vector->color                = b.color;
-
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
-
-            vector->is_ray          = false;
-            vector->to_coord        = false;
-            vector->lightning       = false;
-            vector->fromObjectID    = -1;
-            vector->fromObject      = SpaceObject::none();
-            vector->toObjectID      = -1;
-            vector->toObject        = SpaceObject::none();
-            vector->toRelativeCoord = Point(0, 0);
-            vector->boltState       = 0;
-
-            return vector;
-        }
-    }
-
-    return Vector::none();
+    auto vector = next_free_vector();
+
+    vector->lastGlobalLocation   = *location;
+    vector->objectLocation       = *location;
+    vector->lastApparentLocation = *location;
+    vector->killMe               = false;
+    vector->active               = true;
+    vector->visible              = (b.color != RgbColor::clear());
+    vector->hue                  = sfz::nullopt;
+    vector->color                = b.color;
+
+    vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
+            scale_to_viewport(*location);
+
+    vector->is_ray          = false;
+    vector->to_coord        = false;
+    vector->lightning       = false;
+    vector->fromObject      = SpaceObject::none();
+    vector->toObject        = SpaceObject::none();
+    vector->toRelativeCoord = Point(0, 0);
+    vector->boltState       = 0;
+
+    return vector;
 }
 
 void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObject> sourceObject) {
-    Vector& vector      = *vectorObject->frame.vector;
-    vector.fromObjectID = sourceObject->id;
-    vector.fromObject   = sourceObject;
+    Vector& vector    = *vectorObject->frame.vector;
+    vector.fromObject = sourceObject;
 
     if (sourceObject->targetObject.get()) {
         auto target = sourceObject->targetObject;
 
-        if ((target->active) && (target->id == sourceObject->targetObjectID)) {
+        if (!target.expired()) {
             const int32_t h = abs(target->location.h - vectorObject->location.h);
             const int32_t v = abs(target->location.v - vectorObject->location.v);
 
@@ -174,8 +171,7 @@ void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObjec
                                                vector.accuracy +
                                                vectorObject->randomSeed.next(vector.accuracy << 1);
                 } else {
-                    vector.toObjectID = target->id;
-                    vector.toObject   = target;
+                    vector.toObject = target;
                 }
             }
         } else {  // target not valid
@@ -193,6 +189,7 @@ void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObjec
 }
 
 void Vectors::update() {
+    PhaseTimer timer(TickPhase::VECTORS);
     for (auto vector : Vector::all()) {
         if (vector->active) {
             if (vector->lastApparentLocation != vector->objectLocation) {
@@ -236,24 +233,31 @@ void Vectors::update() {
     }
 }
 
-void Vectors::draw() {
-    Lines lines;
+void Vectors::capture(RenderFrame* frame) {
+    frame->vectors.clear();
     for (auto vector : Vector::all()) {
         if (vector->active && !vector->killMe) {
             if (vector->visible) {
                 const auto& p = vector->thisBoltPoint;
                 if (vector->lightning) {
                     for (int j : range(0, kBoltPointNum - 1)) {
-                        lines.draw(p[j], p[j + 1], vector->color);
+                        frame->vectors.push_back({p[j], p[j + 1], vector->color});
                     }
                 } else {
-                    lines.draw(p[0], p[kBoltPointNum - 1], vector->color);
+                    frame->vectors.push_back({p[0], p[kBoltPointNum - 1], vector->color});
                 }
             }
         }
     }
 }
 
+void Vectors::draw(const RenderFrame& frame) {
+    Lines lines;
+    for (const RenderFrame::LineView& line : frame.vectors) {
+        lines.draw(line.from, line.to, line.color);
+    }
+}
+
 void Vectors::cull() {
     for (auto vector : Vector::all()) {
         vector->active = vector->active && !vector->killMe;
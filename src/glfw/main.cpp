@@ -30,6 +30,7 @@
 #include "game/sys.hpp"
 #include "glfw/video-driver.hpp"
 #include "lang/exception.hpp"
+#include "lang/trace.hpp"
 #include "sound/openal-driver.hpp"
 #include "ui/flows/master.hpp"
 
@@ -54,6 +55,7 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "                        (default: {1})\n"
             "    -f, --factory       set path to factory scenario\n"
             "                        (default: {2})\n"
+            "        --trace=FILE    record a Chrome trace, and write it here on exit\n"
             "    -h, --help          display this help screen\n",
             progname, default_application_path(), default_factory_scenario_path());
     exit(retcode);
@@ -84,12 +86,17 @@ void main(int argc, char* const* argv) {
         }
     };
 
+    sfz::optional<pn::string> trace_path;
     callbacks.long_option =
-            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+            [&callbacks, &trace_path](
+                    pn::string_view opt, const args::callbacks::get_value_f& get_value) {
                 if (opt == "app-data") {
                     return callbacks.short_option(pn::rune{'a'}, get_value);
                 } else if (opt == "factory-scenario") {
                     return callbacks.short_option(pn::rune{'f'}, get_value);
+                } else if (opt == "trace") {
+                    trace_path.emplace(get_value().copy());
+                    return true;
                 } else if (opt == "help") {
                     return callbacks.short_option(pn::rune{'h'}, get_value);
                 } else {
@@ -134,10 +141,18 @@ void main(int argc, char* const* argv) {
         }
     }
 
+    if (trace_path.has_value()) {
+        start_tracing();
+    }
+
     DirectoryLedger   ledger;
     OpenAlSoundDriver sound;
     GLFWVideoDriver   video;
     video.loop(new Master(time(NULL)));
+
+    if (trace_path.has_value()) {
+        write_trace(*trace_path);
+    }
 }
 
 }  // namespace
@@ -20,11 +20,12 @@
 
 #include <GLFW/glfw3.h>
 #include <sys/time.h>
-#include <unistd.h>
 #include <pn/output>
 #include <sfz/sfz.hpp>
+#include <thread>
 
 #include "config/preferences.hpp"
+#include "lang/trace.hpp"
 
 using sfz::range;
 
@@ -32,6 +33,9 @@ namespace antares {
 
 static const ticks kDoubleClickInterval = ticks(30);
 
+// How long the simulation thread waits before checking the top card's timer again.
+static const usecs kSimulationSleep = usecs(1000);
+
 static Key kGLFWKeyToUSB[GLFW_KEY_LAST + 1] = {
         [GLFW_KEY_SPACE]      = Key::SPACE,
         [GLFW_KEY_APOSTROPHE] = Key::QUOTE,
@@ -179,6 +183,7 @@ void GLFWVideoDriver::stop_editing(TextReceiver* text) {
 wall_time GLFWVideoDriver::now() const { return wall_time(usecs(int64_t(glfwGetTime() * 1e6))); }
 
 void GLFWVideoDriver::key(int key, int scancode, int action, int mods) {
+    std::unique_lock<std::mutex> lock(_cards);
     if (_text) {
         edit(key, action, mods);
         return;
@@ -201,6 +206,7 @@ void GLFWVideoDriver::key(int key, int scancode, int action, int mods) {
 }
 
 void GLFWVideoDriver::char_(unsigned int code_point) {
+    std::unique_lock<std::mutex> lock(_cards);
     if (!_text) {
         return;
     }
@@ -328,6 +334,7 @@ void GLFWVideoDriver::edit(int key, int action, int mods) {
 }
 
 void GLFWVideoDriver::mouse_button(int button, int action, int mods) {
+    std::unique_lock<std::mutex> lock(_cards);
     if (action == GLFW_PRESS) {
         if (now() <= (_last_click_usecs + kDoubleClickInterval)) {
             _last_click_count += 1;
@@ -344,10 +351,12 @@ void GLFWVideoDriver::mouse_button(int button, int action, int mods) {
 }
 
 void GLFWVideoDriver::mouse_move(double x, double y) {
+    std::unique_lock<std::mutex> lock(_cards);
     MouseMoveEvent(now(), Point(x, y)).send(_loop->top());
 }
 
 void GLFWVideoDriver::window_size(int width, int height) {
+    std::unique_lock<std::mutex> lock(_cards);
     _screen_size = {width, height};
     glfwGetFramebufferSize(_window, &_viewport_size.width, &_viewport_size.height);
 }
@@ -400,23 +409,82 @@ void GLFWVideoDriver::loop(Card* initial) {
 
     /* Make the _window's context current */
     glfwMakeContextCurrent(_window);
+    glfwSwapInterval(1);
 
     MainLoop main_loop(*this, initial);
     _loop = &main_loop;
     main_loop.draw();
 
-    while (!main_loop.done() && !glfwWindowShouldClose(_window)) {
-        glfwPollEvents();
-        _loop->draw();
-        glfwSwapBuffers(_window);
-        wall_time at;
-        if (main_loop.top()->next_timer(at) && (now() > at)) {
-            main_loop.top()->fire_timer();
-            main_loop.draw();
+    // The simulation runs on a thread of its own, while this one handles events, draws, and waits
+    // for the display. The card stack is locked only while something reads or changes the cards:
+    // sending each event, firing a timer, and recording a frame into the batch. Polling, sending
+    // the batch to the GPU, and waiting for the display all happen unlocked, so the simulation
+    // waits for none of them.
+    std::thread        sim([this] { simulate(); });
+    std::exception_ptr error;
+    try {
+        while (!glfwWindowShouldClose(_window)) {
+            glfwPollEvents();
+            {
+                std::unique_lock<std::mutex> lock(_cards);
+                if (_stopped || main_loop.done()) {
+                    break;
+                }
+                Card*     top = main_loop.top();
+                wall_time at;
+                if ((top != _ticking) && top->next_timer(at) && (now() > at)) {
+                    ANTARES_TRACE("ui", "fire_timer");
+                    top->fire_timer();
+                }
+                main_loop.record();
+            }
+            main_loop.submit();
             glfwSwapBuffers(_window);
-        } else {
-            usleep(10);
         }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_cards);
+        _stopped = true;
+    }
+    sim.join();
+    if (!error) {
+        error = _sim_error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Ticks the top card whenever its timer is due, if it can be ticked off the main thread. If it
+// can't, then the main thread fires its timer instead.
+void GLFWVideoDriver::simulate() {
+    try {
+        while (true) {
+            bool ticked = false;
+            {
+                std::unique_lock<std::mutex> lock(_cards);
+                if (_stopped || _loop->done()) {
+                    return;
+                }
+                Card*     top = _loop->top();
+                wall_time at;
+                if (top->next_timer(at) && (now() > at)) {
+                    ANTARES_TRACE("ui", "tick");
+                    ticked   = top->tick();
+                    _ticking = ticked ? top : nullptr;
+                }
+            }
+            if (!ticked) {
+                std::this_thread::sleep_for(kSimulationSleep);
+            }
+        }
+    } catch (...) {
+        std::unique_lock<std::mutex> lock(_cards);
+        _sim_error = std::current_exception();
+        _stopped   = true;
     }
 }
 
@@ -0,0 +1,78 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/alloc-count.hpp"
+
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+#include "lang/defines.hpp"
+
+namespace antares {
+
+static ANTARES_GLOBAL std::atomic<int64_t> allocations{0};
+
+int64_t allocation_count() { return allocations.load(std::memory_order_relaxed); }
+
+}  // namespace antares
+
+#ifdef __GLIBC__
+
+// glibc exports its allocator under these names too, so the C allocation functions can be
+// replaced with ones that count and then forward. Other C libraries' allocations aren't counted.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void  __libc_free(void* p);
+
+void* malloc(size_t size) {
+    antares::allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    antares::allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, size_t size) {
+    antares::allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+
+void free(void* p) { __libc_free(p); }
+}  // extern "C"
+
+#endif  // __GLIBC__
+
+// Array and nothrow forms of new and delete go through these. With glibc, malloc() does the
+// counting.
+
+void* operator new(size_t size) {
+#ifndef __GLIBC__
+    antares::allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
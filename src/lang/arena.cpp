@@ -0,0 +1,90 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/arena.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+namespace antares {
+
+Arena::Arena(size_t block_size) : _block_size(block_size) {}
+Arena::~Arena() {}
+
+void* Arena::allocate(size_t size, size_t align) {
+    // Blocks come from new[], so they're aligned for anything; offsets within them only need to
+    // be rounded up.
+    for (; _block < _blocks.size(); ++_block, _used = 0) {
+        Block& b     = _blocks[_block];
+        size_t start = (_used + align - 1) & ~(align - 1);
+        if (start + size <= b.size) {
+            _used = start + size;
+            return b.data.get() + start;
+        }
+    }
+
+    size_t block_size = std::max(size, _block_size);
+    _blocks.push_back(Block{std::unique_ptr<uint8_t[]>(new uint8_t[block_size]), block_size});
+    _used = size;
+    return _blocks.back().data.get();
+}
+
+pn::string_view Arena::copy(pn::string_view s) { return join({s}); }
+
+pn::string_view Arena::join(std::initializer_list<pn::string_view> parts) {
+    int size = 0;
+    for (pn::string_view part : parts) {
+        size += part.size();
+    }
+    char* data = static_cast<char*>(allocate(size, 1));
+    char* out  = data;
+    for (pn::string_view part : parts) {
+        memcpy(out, part.data(), part.size());
+        out += part.size();
+    }
+    return pn::string_view(data, size);
+}
+
+pn::string_view Arena::dump(int64_t value) {
+    char buffer[24];
+    int  size = snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+    return copy(pn::string_view(buffer, size));
+}
+
+void Arena::reset() {
+    _block = 0;
+    _used  = 0;
+}
+
+size_t Arena::used() const {
+    size_t used = _used;
+    for (size_t i = 0; (i < _block) && (i < _blocks.size()); ++i) {
+        used += _blocks[i].size;
+    }
+    return used;
+}
+
+size_t Arena::capacity() const {
+    size_t capacity = 0;
+    for (const Block& b : _blocks) {
+        capacity += b.size;
+    }
+    return capacity;
+}
+
+}  // namespace antares
@@ -0,0 +1,62 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/arena.hpp"
+
+#include <gmock/gmock.h>
+
+using testing::Eq;
+using testing::Ge;
+
+namespace antares {
+namespace {
+
+TEST(ArenaTest, Strings) {
+    Arena           arena;
+    pn::string      owned = "captured";
+    pn::string_view copy  = arena.copy(owned);
+    owned                 = "lost";
+    EXPECT_THAT(copy, Eq("captured"));
+    EXPECT_THAT(
+            arena.join({"Cruiser", " ", copy, " by ", arena.dump(-42)}),
+            Eq("Cruiser captured by -42"));
+    EXPECT_THAT(arena.join({}), Eq(""));
+}
+
+TEST(ArenaTest, Aligned) {
+    Arena arena;
+    arena.allocate(1, 1);
+    void* p = arena.allocate(sizeof(double), alignof(double));
+    EXPECT_THAT(reinterpret_cast<uintptr_t>(p) % alignof(double), Eq(0u));
+}
+
+// Once the arena has grown to fit what's allocated between resets, it reuses its blocks.
+TEST(ArenaTest, ReusesBlocks) {
+    Arena arena(64);
+    for (int i = 0; i < 10; ++i) {
+        arena.allocate(40);
+        arena.allocate(40);
+        arena.allocate(100);
+        EXPECT_THAT(arena.used(), Ge(180u));
+        arena.reset();
+        EXPECT_THAT(arena.used(), Eq(0u));
+    }
+    EXPECT_THAT(arena.capacity(), Eq(64u + 64u + 100u));
+}
+
+}  // namespace
+}  // namespace antares
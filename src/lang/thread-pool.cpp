@@ -0,0 +1,133 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/thread-pool.hpp"
+
+#include <algorithm>
+
+namespace antares {
+
+// Loops are cut into this many ranges per thread, so that there's something left to steal when
+// one thread's share turns out to be slower than another's.
+static const int32_t kRangesPerThread = 8;
+
+ThreadPool::ThreadPool(int threads) {
+    threads = std::max(threads, 1);
+    for (int i = 0; i < threads; ++i) {
+        _queues.emplace_back(new Queue);
+    }
+    for (int i = 1; i < threads; ++i) {
+        _threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _start.notify_all();
+    for (auto& t : _threads) {
+        t.join();
+    }
+}
+
+void ThreadPool::parallel_for(int32_t count, const std::function<void(int32_t)>& fn) {
+    if (count <= 0) {
+        return;
+    } else if (_threads.empty()) {
+        for (int32_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Give each thread a contiguous share, already cut into ranges.
+    const int32_t ranges = std::min<int32_t>(count, threads() * kRangesPerThread);
+    for (int32_t r = 0; r < ranges; ++r) {
+        Range range{(count * r) / ranges, (count * (r + 1)) / ranges};
+        _queues[(r * threads()) / ranges]->ranges.push_back(range);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _fn   = &fn;
+        _busy = _threads.size();
+        ++_job;
+    }
+    _start.notify_all();
+
+    run(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _busy == 0; });
+    _fn = nullptr;
+}
+
+void ThreadPool::work(int thread) {
+    uint64_t job = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _start.wait(lock, [this, job] { return _stopped || (_job != job); });
+            if (_stopped) {
+                return;
+            }
+            job = _job;
+        }
+
+        run(thread);
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            --_busy;
+        }
+        _done.notify_one();
+    }
+}
+
+// Takes the next range from the front of the thread's own queue, or failing that, from the back
+// of another thread's.
+bool ThreadPool::take(int thread, Range* range) {
+    for (int i = 0; i < threads(); ++i) {
+        Queue&                       q = *_queues[(thread + i) % threads()];
+        std::unique_lock<std::mutex> lock(q.mutex);
+        if (q.ranges.empty()) {
+            continue;
+        } else if (i == 0) {
+            *range = q.ranges.front();
+            q.ranges.pop_front();
+        } else {
+            *range = q.ranges.back();
+            q.ranges.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(int thread) {
+    const std::function<void(int32_t)>& fn = *_fn;
+    Range                               range;
+    while (take(thread, &range)) {
+        for (int32_t i = range.first; i < range.second; ++i) {
+            fn(i);
+        }
+    }
+}
+
+}  // namespace antares
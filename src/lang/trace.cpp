@@ -0,0 +1,167 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <pn/output>
+#include <vector>
+
+#include "lang/defines.hpp"
+
+namespace antares {
+
+namespace {
+
+// Per thread. At 80 bytes each, a little over a megabyte.
+const size_t kTraceEvents = 1 << 14;
+const size_t kDetailSize  = 48;
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    char        detail[kDetailSize];
+    int64_t     start;
+    int64_t     duration;
+};
+
+struct TraceBuffer {
+    explicit TraceBuffer(int tid) : tid(tid), events(kTraceEvents) {}
+
+    const int               tid;
+    std::mutex              mutex;  // Only contended while writing the trace.
+    std::vector<TraceEvent> events;
+    uint64_t                count = 0;
+};
+
+}  // namespace
+
+static ANTARES_GLOBAL std::atomic<bool> trace_on{false};
+
+static ANTARES_GLOBAL const std::chrono::steady_clock::time_point trace_epoch =
+        std::chrono::steady_clock::now();
+
+// Buffers outlive their threads, so that what they recorded can still be written out.
+static ANTARES_GLOBAL std::mutex buffers_mutex;
+static ANTARES_GLOBAL std::vector<std::unique_ptr<TraceBuffer>> buffers;
+static thread_local TraceBuffer* thread_buffer = nullptr;
+
+static int64_t trace_clock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - trace_epoch)
+            .count();
+}
+
+static TraceBuffer& buffer() {
+    if (!thread_buffer) {
+        std::unique_lock<std::mutex> lock(buffers_mutex);
+        buffers.emplace_back(new TraceBuffer(buffers.size()));
+        thread_buffer = buffers.back().get();
+    }
+    return *thread_buffer;
+}
+
+void start_tracing() { trace_on = true; }
+void stop_tracing() { trace_on = false; }
+bool tracing() { return trace_on; }
+
+TraceSpan::TraceSpan(const char* category, const char* name, pn::string_view detail)
+        : _category(category),
+          _name(name),
+          _detail(detail),
+          _start(trace_on ? trace_clock() : -1) {}
+
+TraceSpan::~TraceSpan() {
+    if (_start < 0) {
+        return;
+    }
+    int64_t                      end = trace_clock();
+    TraceBuffer&                 b   = buffer();
+    std::unique_lock<std::mutex> lock(b.mutex);
+    TraceEvent&                  e = b.events[b.count++ % kTraceEvents];
+    e.category                     = _category;
+    e.name                         = _name;
+    e.start                        = _start;
+    e.duration                     = end - _start;
+
+    size_t size = std::min<size_t>(_detail.size(), kDetailSize - 1);
+    while ((size < _detail.size()) && ((_detail.data()[size] & 0xc0) == 0x80)) {
+        --size;  // Don't split a rune.
+    }
+    std::copy(_detail.data(), _detail.data() + size, e.detail);
+    e.detail[size] = '\0';
+}
+
+static pn::string quote(pn::string_view s) {
+    pn::string out;
+    out += "\"";
+    for (pn::rune r : s) {
+        if ((r == pn::rune{'"'}) || (r == pn::rune{'\\'})) {
+            out += "\\";
+            out += r;
+        } else if (r.value() < 0x20) {
+            out += " ";
+        } else {
+            out += r;
+        }
+    }
+    out += "\"";
+    return out;
+}
+
+static double micros(int64_t nanos) { return nanos / 1000.0; }
+
+pn::string trace_json() {
+    pn::string out;
+    out += "{\"traceEvents\": [";
+    bool                         first = true;
+    std::unique_lock<std::mutex> lock(buffers_mutex);
+    for (const auto& b : buffers) {
+        std::unique_lock<std::mutex> buffer_lock(b->mutex);
+        uint64_t begin = (b->count > kTraceEvents) ? (b->count - kTraceEvents) : 0;
+        for (uint64_t i = begin; i < b->count; ++i) {
+            const TraceEvent& e = b->events[i % kTraceEvents];
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "{";
+            out += pn::format(
+                    "\"ph\": \"X\", \"pid\": 1, \"tid\": {0}, \"cat\": {1}, \"name\": {2}, "
+                    "\"ts\": {3}, \"dur\": {4}",
+                    b->tid, quote(e.category), quote(e.name), micros(e.start),
+                    micros(e.duration));
+            if (e.detail[0]) {
+                out += ", \"args\": {\"detail\": ";
+                out += quote(e.detail);
+                out += "}";
+            }
+            out += "}";
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+void write_trace(pn::string_view path) {
+    pn::output out{path, pn::text};
+    out.write(trace_json());
+}
+
+}  // namespace antares
@@ -0,0 +1,82 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "lang/trace.hpp"
+
+#include <gmock/gmock.h>
+#include <thread>
+
+using testing::HasSubstr;
+using testing::Not;
+
+namespace antares {
+namespace {
+
+class TraceTest : public testing::Test {
+  protected:
+    TraceTest() { start_tracing(); }
+    ~TraceTest() { stop_tracing(); }
+};
+
+TEST_F(TraceTest, RecordsSpans) {
+    {
+        TraceSpan span("test", "outer", "some/file.pn");
+    }
+    pn::string json = trace_json();
+    EXPECT_THAT(json.c_str(), HasSubstr("\"cat\": \"test\", \"name\": \"outer\""));
+    EXPECT_THAT(json.c_str(), HasSubstr("\"detail\": \"some/file.pn\""));
+}
+
+TEST_F(TraceTest, NothingWhileStopped) {
+    stop_tracing();
+    {
+        TraceSpan span("test", "stopped");
+    }
+    EXPECT_THAT(trace_json().c_str(), Not(HasSubstr("\"stopped\"")));
+}
+
+TEST_F(TraceTest, EscapesDetail) {
+    {
+        TraceSpan span("test", "escaped", "a\"b\\c");
+    }
+    EXPECT_THAT(trace_json().c_str(), HasSubstr("\"detail\": \"a\\\"b\\\\c\""));
+}
+
+TEST_F(TraceTest, TruncatesDetailOnRuneBoundary) {
+    // 24 two-byte runes; only 47 bytes fit, so the last rune is dropped whole.
+    pn::string detail;
+    for (int i = 0; i < 24; ++i) {
+        detail += "\u00e9";
+    }
+    {
+        TraceSpan span("test", "truncated", detail);
+    }
+    pn::string expected = "\"detail\": \"";
+    expected += detail.substr(0, 46);
+    expected += "\"";
+    EXPECT_THAT(trace_json().c_str(), HasSubstr(expected.c_str()));
+}
+
+TEST_F(TraceTest, OtherThreads) {
+    std::thread t([] { TraceSpan span("test", "other thread"); });
+    t.join();
+    // Kept after the thread exits.
+    EXPECT_THAT(trace_json().c_str(), HasSubstr("\"other thread\""));
+}
+
+}  // namespace
+}  // namespace antares
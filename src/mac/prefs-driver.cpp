@@ -39,6 +39,7 @@ static const char kIdleMusicPreference[]   = "PlayIdleMusic";
 static const char kGameMusicPreference[]   = "PlayGameMusic";
 static const char kSpeechOnPreference[]    = "SpeechOn";
 static const char kVolumePreference[]      = "Volume";
+static const char kFastMotionPreference[]  = "FastMotion";
 static const char kScenarioPreference[]    = "Scenario";
 
 template <typename T>
@@ -109,6 +110,9 @@ CoreFoundationPrefsDriver::CoreFoundationPrefsDriver() {
         if (cf::get_preference(kVolumePreference, cfnum) && cf::unwrap(cfnum, val)) {
             _current.volume = clamp<int>(8 * val, 0, 8);
         }
+        if (cf::get_preference(kFastMotionPreference, cfnum) && cf::unwrap(cfnum, val)) {
+            _current.fast_motion = clamp<int>(val, kMinFastMotion, kMaxFastMotion);
+        }
     }
 
     cf::String cfstr;
@@ -131,6 +135,7 @@ void CoreFoundationPrefsDriver::set(const Preferences& preferences) {
     cf::set_preference(kGameMusicPreference, cf::wrap(preferences.play_music_in_game));
     cf::set_preference(kSpeechOnPreference, cf::wrap(preferences.speech_on));
     cf::set_preference(kVolumePreference, cf::wrap(0.125 * preferences.volume));
+    cf::set_preference(kFastMotionPreference, cf::wrap(preferences.fast_motion));
     cf::set_preference(kScenarioPreference, cf::wrap(preferences.scenario_identifier));
     CFPreferencesAppSynchronize(kCFPreferencesCurrentApplication);
 }
@@ -29,6 +29,7 @@
 #include <pn/output>
 
 #include "game/time.hpp"
+#include "lang/trace.hpp"
 #include "mac/c/CocoaVideoDriver.h"
 #include "mac/core-foundation.hpp"
 #include "mac/core-opengl.hpp"
@@ -644,6 +645,7 @@ void CocoaVideoDriver::loop(Card* initial) {
             if (antares_window_next_event(_window, at.time_since_epoch().count())) {
                 bridge.send_all();
             } else {
+                ANTARES_TRACE("ui", "fire_timer");
                 main_loop.top()->fire_timer();
                 main_loop.draw();
                 CGLFlushDrawable(context.c_obj());
@@ -0,0 +1,106 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "math/fixed-batch.hpp"
+
+#include <chrono>
+#include <pn/output>
+#include <random>
+#include <vector>
+
+#include "lang/exception.hpp"
+
+namespace antares {
+namespace {
+
+// About as many objects as a large battle has, so the arrays stay in cache like they would
+// during a tick.
+const size_t kSize       = 4096;
+const int    kIterations = 20000;
+
+// Returns nanoseconds per element of running `fn` over arrays of kSize.
+template <typename F>
+double time_per_element(F fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations / kSize;
+}
+
+void report(pn::string_view name, double scalar, double batch) {
+    pn::out.format(
+            "{0}: {1} ns scalar, {2} ns batch ({3}x)\n", name, scalar, batch, scalar / batch);
+}
+
+void main(int argc, char* const* argv) {
+    std::mt19937                           engine{0x5eed};
+    std::uniform_int_distribution<int32_t> dist(-46340, 46340);
+    std::vector<Fixed>                     a(kSize), b(kSize), out(kSize);
+    std::vector<int32_t>                   longs(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        a[i] = Fixed::from_val(dist(engine));
+        b[i] = Fixed::from_val(dist(engine));
+    }
+
+    pn::out.format("FixedBatch ({0}), {1} elements\n", FixedBatch::isa(), kSize);
+
+    // Each scalar loop stores through a volatile pointer so the compiler can't vectorize it;
+    // that's what per-object code does today.
+    volatile int32_t* sink      = reinterpret_cast<volatile int32_t*>(out.data());
+    volatile int32_t* long_sink = longs.data();
+
+    report("add", time_per_element([&] {
+               for (size_t i = 0; i < kSize; ++i) {
+                   sink[i] = (a[i] + b[i]).val();
+               }
+           }),
+           time_per_element([&] { FixedBatch::add(a.data(), b.data(), out.data(), kSize); }));
+
+    report("mul", time_per_element([&] {
+               for (size_t i = 0; i < kSize; ++i) {
+                   sink[i] = (a[i] * b[i]).val();
+               }
+           }),
+           time_per_element([&] { FixedBatch::mul(a.data(), b.data(), out.data(), kSize); }));
+
+    report("cap", time_per_element([&] {
+               for (size_t i = 0; i < kSize; ++i) {
+                   Fixed x = a[i];
+                   if (b[i] < Fixed::zero()) {
+                       x = (x < b[i]) ? b[i] : x;
+                   } else {
+                       x = (x > b[i]) ? b[i] : x;
+                   }
+                   sink[i] = x.val();
+               }
+           }),
+           time_per_element([&] { FixedBatch::cap(a.data(), b.data(), out.data(), kSize); }));
+
+    report("to_long", time_per_element([&] {
+               for (size_t i = 0; i < kSize; ++i) {
+                   long_sink[i] = evil_fixed_to_long(a[i]);
+               }
+           }),
+           time_per_element([&] { FixedBatch::to_long(a.data(), longs.data(), kSize); }));
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
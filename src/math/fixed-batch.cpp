@@ -0,0 +1,175 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "math/fixed-batch.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ANTARES_FIXED_BATCH_SIMD 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define ANTARES_FIXED_BATCH_SIMD 1
+#endif
+
+namespace antares {
+
+static_assert(sizeof(Fixed) == sizeof(int32_t), "Fixed must be a bare int32_t");
+
+namespace {
+
+// Each Simd struct operates on `width` int32_t lanes at once, with the same semantics as the
+// scalar operators: wrapping addition and multiplication, and arithmetic right shifts.
+
+#if defined(__AVX2__)
+
+struct Simd {
+    using type                = __m256i;
+    static const size_t width = 8;
+
+    static type load(const void* p) { return _mm256_loadu_si256(static_cast<const type*>(p)); }
+    static void store(void* p, type x) { _mm256_storeu_si256(static_cast<type*>(p), x); }
+    static type splat(int32_t x) { return _mm256_set1_epi32(x); }
+
+    static type add(type a, type b) { return _mm256_add_epi32(a, b); }
+    static type mul(type a, type b) { return _mm256_srai_epi32(_mm256_mullo_epi32(a, b), 8); }
+    static type to_long(type a) {
+        return _mm256_sub_epi32(_mm256_srai_epi32(a, 8), _mm256_srai_epi32(a, 31));
+    }
+
+    static type lt(type a, type b) { return _mm256_cmpgt_epi32(b, a); }
+    static type gt(type a, type b) { return _mm256_cmpgt_epi32(a, b); }
+    static type select(type mask, type a, type b) { return _mm256_blendv_epi8(b, a, mask); }
+};
+
+#elif defined(__SSE2__)
+
+struct Simd {
+    using type                = __m128i;
+    static const size_t width = 4;
+
+    static type load(const void* p) { return _mm_loadu_si128(static_cast<const type*>(p)); }
+    static void store(void* p, type x) { _mm_storeu_si128(static_cast<type*>(p), x); }
+    static type splat(int32_t x) { return _mm_set1_epi32(x); }
+
+    static type add(type a, type b) { return _mm_add_epi32(a, b); }
+
+    // SSE2 has no 32-bit low multiply, so multiply even and odd lanes into 64-bit products and
+    // interleave their low halves back together.
+    static type mul(type a, type b) {
+        type even = _mm_mul_epu32(a, b);
+        type odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        type low  = _mm_unpacklo_epi32(
+                _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        return _mm_srai_epi32(low, 8);
+    }
+    static type to_long(type a) {
+        return _mm_sub_epi32(_mm_srai_epi32(a, 8), _mm_srai_epi32(a, 31));
+    }
+
+    static type lt(type a, type b) { return _mm_cmplt_epi32(a, b); }
+    static type gt(type a, type b) { return _mm_cmpgt_epi32(a, b); }
+    static type select(type mask, type a, type b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+};
+
+#endif
+
+}  // namespace
+
+const char* FixedBatch::isa() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void FixedBatch::add(const Fixed* a, const Fixed* b, Fixed* out, size_t size) {
+    size_t i = 0;
+#ifdef ANTARES_FIXED_BATCH_SIMD
+    for (; i + Simd::width <= size; i += Simd::width) {
+        Simd::store(out + i, Simd::add(Simd::load(a + i), Simd::load(b + i)));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+void FixedBatch::mul(const Fixed* a, const Fixed* b, Fixed* out, size_t size) {
+    size_t i = 0;
+#ifdef ANTARES_FIXED_BATCH_SIMD
+    for (; i + Simd::width <= size; i += Simd::width) {
+        Simd::store(out + i, Simd::mul(Simd::load(a + i), Simd::load(b + i)));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = a[i] * b[i];
+    }
+}
+
+void FixedBatch::mul(const Fixed* a, Fixed b, Fixed* out, size_t size) {
+    size_t i = 0;
+#ifdef ANTARES_FIXED_BATCH_SIMD
+    const Simd::type vb = Simd::splat(b.val());
+    for (; i + Simd::width <= size; i += Simd::width) {
+        Simd::store(out + i, Simd::mul(Simd::load(a + i), vb));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = a[i] * b;
+    }
+}
+
+void FixedBatch::cap(const Fixed* a, const Fixed* limit, Fixed* out, size_t size) {
+    size_t i = 0;
+#ifdef ANTARES_FIXED_BATCH_SIMD
+    const Simd::type zero = Simd::splat(0);
+    for (; i + Simd::width <= size; i += Simd::width) {
+        Simd::type va   = Simd::load(a + i);
+        Simd::type vlim = Simd::load(limit + i);
+        Simd::type over =
+                Simd::select(Simd::lt(vlim, zero), Simd::lt(va, vlim), Simd::gt(va, vlim));
+        Simd::store(out + i, Simd::select(over, vlim, va));
+    }
+#endif
+    for (; i < size; ++i) {
+        if (limit[i] < Fixed::zero()) {
+            out[i] = (a[i] < limit[i]) ? limit[i] : a[i];
+        } else {
+            out[i] = (a[i] > limit[i]) ? limit[i] : a[i];
+        }
+    }
+}
+
+void FixedBatch::to_long(const Fixed* a, int32_t* out, size_t size) {
+    size_t i = 0;
+#ifdef ANTARES_FIXED_BATCH_SIMD
+    for (; i + Simd::width <= size; i += Simd::width) {
+        Simd::store(out + i, Simd::to_long(Simd::load(a + i)));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = evil_fixed_to_long(a[i]);
+    }
+}
+
+}  // namespace antares
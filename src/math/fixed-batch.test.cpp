@@ -0,0 +1,141 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "math/fixed-batch.hpp"
+
+#include <gmock/gmock.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using testing::ElementsAreArray;
+
+namespace antares {
+namespace {
+
+// Odd, so that every operation runs both its vector loop and its scalar tail.
+const size_t kSize = 1001;
+
+class FixedBatchTest : public testing::Test {
+  protected:
+    // Uniformly distributed in [-max, max], plus the edges of the range and zero.
+    std::vector<Fixed> random(int32_t max) {
+        std::uniform_int_distribution<int32_t> dist(-max, max);
+        std::vector<Fixed>                     result;
+        result.push_back(Fixed::from_val(-max));
+        result.push_back(Fixed::from_val(max));
+        result.push_back(Fixed::zero());
+        while (result.size() < kSize) {
+            result.push_back(Fixed::from_val(dist(_engine)));
+        }
+        return result;
+    }
+
+    std::mt19937 _engine{0x5eed};
+};
+
+// Safe ranges for the scalar operators, which must not overflow.
+const int32_t kMaxAddend     = 0x3fffffff;
+const int32_t kMaxMultiplier = 46340;  // floor(sqrt(2^31 - 1))
+
+TEST_F(FixedBatchTest, Add) {
+    for (int trial = 0; trial < 100; ++trial) {
+        auto               a = random(kMaxAddend);
+        auto               b = random(kMaxAddend);
+        std::vector<Fixed> expected, actual(kSize);
+        for (size_t i = 0; i < kSize; ++i) {
+            expected.push_back(a[i] + b[i]);
+        }
+        FixedBatch::add(a.data(), b.data(), actual.data(), kSize);
+        EXPECT_THAT(actual, ElementsAreArray(expected));
+    }
+}
+
+TEST_F(FixedBatchTest, Mul) {
+    for (int trial = 0; trial < 100; ++trial) {
+        auto               a = random(kMaxMultiplier);
+        auto               b = random(kMaxMultiplier);
+        std::vector<Fixed> expected, actual(kSize);
+        for (size_t i = 0; i < kSize; ++i) {
+            expected.push_back(a[i] * b[i]);
+        }
+        FixedBatch::mul(a.data(), b.data(), actual.data(), kSize);
+        EXPECT_THAT(actual, ElementsAreArray(expected));
+    }
+}
+
+TEST_F(FixedBatchTest, MulScalar) {
+    for (int trial = 0; trial < 100; ++trial) {
+        auto               a = random(kMaxMultiplier);
+        Fixed              b = random(kMaxMultiplier)[trial];
+        std::vector<Fixed> expected, actual(kSize);
+        for (size_t i = 0; i < kSize; ++i) {
+            expected.push_back(a[i] * b);
+        }
+        FixedBatch::mul(a.data(), b, actual.data(), kSize);
+        EXPECT_THAT(actual, ElementsAreArray(expected));
+    }
+}
+
+TEST_F(FixedBatchTest, Cap) {
+    for (int trial = 0; trial < 100; ++trial) {
+        auto               a     = random(std::numeric_limits<int32_t>::max());
+        auto               limit = random(std::numeric_limits<int32_t>::max());
+        std::vector<Fixed> expected, actual(kSize);
+        for (size_t i = 0; i < kSize; ++i) {
+            Fixed x = a[i];
+            if (limit[i] < Fixed::zero()) {
+                if (x < limit[i]) {
+                    x = limit[i];
+                }
+            } else {
+                if (x > limit[i]) {
+                    x = limit[i];
+                }
+            }
+            expected.push_back(x);
+        }
+        FixedBatch::cap(a.data(), limit.data(), actual.data(), kSize);
+        EXPECT_THAT(actual, ElementsAreArray(expected));
+    }
+}
+
+TEST_F(FixedBatchTest, ToLong) {
+    for (int trial = 0; trial < 100; ++trial) {
+        auto                 a = random(std::numeric_limits<int32_t>::max());
+        std::vector<int32_t> expected, actual(kSize);
+        for (size_t i = 0; i < kSize; ++i) {
+            expected.push_back(evil_fixed_to_long(a[i]));
+        }
+        FixedBatch::to_long(a.data(), actual.data(), kSize);
+        EXPECT_THAT(actual, ElementsAreArray(expected));
+    }
+}
+
+TEST_F(FixedBatchTest, InPlace) {
+    auto               a = random(kMaxMultiplier);
+    auto               b = random(kMaxMultiplier);
+    std::vector<Fixed> expected;
+    for (size_t i = 0; i < kSize; ++i) {
+        expected.push_back(a[i] * b[i]);
+    }
+    FixedBatch::mul(a.data(), b.data(), a.data(), kSize);
+    EXPECT_THAT(a, ElementsAreArray(expected));
+}
+
+}  // namespace
+}  // namespace antares
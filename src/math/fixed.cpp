@@ -63,4 +63,15 @@ pn::string stringify(Fixed fixed) {
     return pn::format("{}{}{}", prefix, integral, kFractions[value]);
 }
 
+pn::string_view stringify(Fixed fixed, Arena* arena) {
+    const char* prefix = "";
+    if (fixed < Fixed::zero()) {
+        prefix = "-";
+    }
+    int64_t       value    = llabs(fixed.val());
+    const int32_t integral = (value & 0xffffff00) >> 8;
+    value &= 0xff;
+    return arena->join({prefix, arena->dump(integral), kFractions[value]});
+}
+
 }  // namespace antares
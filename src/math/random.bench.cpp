@@ -0,0 +1,84 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "math/random.hpp"
+
+#include <chrono>
+#include <pn/output>
+
+#include "lang/exception.hpp"
+
+namespace antares {
+namespace {
+
+// About as many objects as a large battle has, each drawing a few numbers per tick.
+const int32_t kObjects    = 4096;
+const int     kDraws      = 4;
+const int     kIterations = 2000;
+
+// Returns nanoseconds per draw of running `fn`, which makes kObjects * kDraws draws.
+template <typename F>
+double time_per_draw(F fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations / kObjects /
+           kDraws;
+}
+
+void main(int argc, char* const* argv) {
+    volatile int16_t sink;
+
+    pn::out.format("{0} objects, {1} draws each\n", kObjects, kDraws);
+
+    Random random{0};
+    pn::out.format("legacy: {0} ns\n", time_per_draw([&](int tick) {
+                       for (int32_t id = 0; id < kObjects; ++id) {
+                           for (int j = 0; j < kDraws; ++j) {
+                               sink = random.next(int16_t(1200));
+                           }
+                       }
+                   }));
+
+    // A new stream per object per tick, the way the game keys them.
+    pn::out.format("counter: {0} ns\n", time_per_draw([&](int tick) {
+                       for (int32_t id = 0; id < kObjects; ++id) {
+                           RandomStream stream(0, RandomPurpose::OBJECT, tick, id, 0);
+                           for (int j = 0; j < kDraws; ++j) {
+                               sink = stream.next(int16_t(1200));
+                           }
+                       }
+                   }));
+
+    // One long stream, for the cost of the generator alone.
+    RandomStream stream(0, RandomPurpose::OBJECT, 0, 0, 0);
+    pn::out.format("counter, one stream: {0} ns\n", time_per_draw([&](int tick) {
+                       for (int32_t id = 0; id < kObjects; ++id) {
+                           for (int j = 0; j < kDraws; ++j) {
+                               sink = stream.next(int16_t(1200));
+                           }
+                       }
+                   }));
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
@@ -47,6 +47,42 @@ int16_t Random::next(int16_t range) {
     return (l * range) >> 15;
 }
 
+static inline void mulhilo(uint32_t a, uint32_t b, uint32_t* hi, uint32_t* lo) {
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    *hi              = product >> 32;
+    *lo              = product;
+}
+
+std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> c, std::array<uint32_t, 2> k) {
+    for (int round = 0; round < 10; ++round) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(0xD2511F53, c[0], &hi0, &lo0);
+        mulhilo(0xCD9E8D57, c[2], &hi1, &lo1);
+        c = {{hi1 ^ c[1] ^ k[0], lo1, hi0 ^ c[3] ^ k[1], lo0}};
+        k[0] += 0x9E3779B9;
+        k[1] += 0xBB67AE85;
+    }
+    return c;
+}
+
+// The tick is truncated to 32 bits, which repeats only after two years of game time. The last
+// counter word numbers the blocks of four draws.
+RandomStream::RandomStream(
+        int32_t seed, RandomPurpose purpose, int64_t tick, int32_t id, int32_t serial)
+        : _key{{static_cast<uint32_t>(seed), static_cast<uint32_t>(purpose)}},
+          _counter{{static_cast<uint32_t>(id), static_cast<uint32_t>(serial),
+                    static_cast<uint32_t>(tick), 0}} {}
+
+int16_t RandomStream::next(int16_t range) {
+    if (_used == 4) {
+        _block = philox4x32(_counter, _key);
+        ++_counter[3];
+        _used = 0;
+    }
+    int32_t l = _block[_used++] >> 17;
+    return (l * range) >> 15;
+}
+
 //
 // From develop 21 p105:
 //
@@ -0,0 +1,101 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "math/random.hpp"
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+using testing::Ne;
+
+namespace antares {
+namespace {
+
+using RandomTest = testing::Test;
+
+// Known-answer tests from the Random123 distribution.
+TEST_F(RandomTest, Philox) {
+    EXPECT_THAT(
+            philox4x32({{0, 0, 0, 0}}, {{0, 0}}),
+            ElementsAre(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8));
+    EXPECT_THAT(
+            philox4x32({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                       {{0xffffffff, 0xffffffff}}),
+            ElementsAre(0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd));
+    EXPECT_THAT(
+            philox4x32({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                       {{0xa4093822, 0x299f31d0}}),
+            ElementsAre(0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1));
+}
+
+std::vector<int16_t> draw(RandomStream stream, int n) {
+    std::vector<int16_t> result;
+    for (int i = 0; i < n; ++i) {
+        result.push_back(stream.next(int16_t(32767)));
+    }
+    return result;
+}
+
+// A stream's draws depend only on its key, not on what else has been drawn.
+TEST_F(RandomTest, Keyed) {
+    RandomStream a(1, RandomPurpose::OBJECT, 100, 7, 0);
+    RandomStream b(1, RandomPurpose::OBJECT, 100, 8, 0);
+    auto         expected = draw(a, 10);
+    draw(b, 10);
+    EXPECT_THAT(draw(a, 10), Eq(expected));
+    EXPECT_THAT(draw(RandomStream(1, RandomPurpose::OBJECT, 100, 7, 0), 10), Eq(expected));
+}
+
+// Changing any part of the key gives a different stream.
+TEST_F(RandomTest, Independent) {
+    auto expected = draw(RandomStream(1, RandomPurpose::OBJECT, 100, 7, 0), 10);
+    EXPECT_THAT(draw(RandomStream(2, RandomPurpose::OBJECT, 100, 7, 0), 10), Ne(expected));
+    EXPECT_THAT(draw(RandomStream(1, RandomPurpose::BUILD, 100, 7, 0), 10), Ne(expected));
+    EXPECT_THAT(draw(RandomStream(1, RandomPurpose::OBJECT, 101, 7, 0), 10), Ne(expected));
+    EXPECT_THAT(draw(RandomStream(1, RandomPurpose::OBJECT, 100, 8, 0), 10), Ne(expected));
+    EXPECT_THAT(draw(RandomStream(1, RandomPurpose::OBJECT, 100, 7, 1), 10), Ne(expected));
+}
+
+// Draws fall in [0, range), like Random's, across several blocks.
+TEST_F(RandomTest, Range) {
+    RandomStream stream(0, RandomPurpose::LEVEL, 0, 0, 0);
+    int16_t      min = 1200, max = 0;
+    for (int i = 0; i < 10000; ++i) {
+        int16_t x = stream.next(int16_t(1200));
+        min       = std::min(min, x);
+        max       = std::max(max, x);
+    }
+    EXPECT_THAT(min, Eq(0));
+    EXPECT_THAT(max, Eq(1199));
+}
+
+// RandomSource passes draws through to a shared Random in order.
+TEST_F(RandomTest, Shared) {
+    Random       random{0}, expected{0};
+    RandomSource source(&random);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_THAT(source.next(int16_t(1200)), Eq(expected.next(int16_t(1200))));
+    }
+    EXPECT_THAT(random.seed, Eq(expected.seed));
+}
+
+}  // namespace
+}  // namespace antares
@@ -27,6 +27,7 @@
 #include "game/space-object.hpp"
 #include "game/time.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
 #include "math/macros.hpp"
 #include "math/special.hpp"
 #include "math/units.hpp"
@@ -85,7 +86,7 @@ enum {
 };
 
 struct SoundFX::smartSoundChannel {
-    pn::string                    whichSound;
+    int                           whichSound;  // Index in `sounds`, or -1.
     wall_time                     reserved_until;
     int16_t                       soundVolume;
     uint8_t                       soundPriority;
@@ -102,7 +103,8 @@ bool SoundFX::same_sound_channel(
         int& channel, pn::string_view id, uint8_t amplitude, uint8_t priority) {
     if (priority > kVeryLowPrioritySound) {
         for (int i = 0; i < kMaxChannelNum; ++i) {
-            if ((channels[i].whichSound == id) && (channels[i].soundVolume <= amplitude)) {
+            if ((channels[i].whichSound >= 0) && (sounds[channels[i].whichSound].id == id) &&
+                (channels[i].soundVolume <= amplitude)) {
                 channel = i;
                 return true;
             }
@@ -157,6 +159,7 @@ bool SoundFX::best_channel(
 }
 
 void SoundFX::play(pn::string_view id, uint8_t amplitude, usecs persistence, uint8_t priority) {
+    ANTARES_TRACE("sound", "SoundFX::play", id);
     int32_t whichChannel = -1;
     // TODO(sfiera): don't play sound at all if the game is muted.
     if (amplitude > 0) {
@@ -174,7 +177,7 @@ void SoundFX::play(pn::string_view id, uint8_t amplitude, usecs persistence, uin
             return;
         }
 
-        channels[whichChannel].whichSound     = id.copy();
+        channels[whichChannel].whichSound     = whichSound;
         channels[whichChannel].reserved_until = now() + persistence;
         channels[whichChannel].soundPriority  = priority;
         channels[whichChannel].soundVolume    = amplitude;
@@ -194,13 +197,20 @@ void SoundFX::init() {
         channels[i].soundPriority  = kNoSound;
         channels[i].soundVolume    = 0;
         channels[i].channelPtr     = sys.audio->open_channel();
-        channels[i].whichSound.clear();
+        channels[i].whichSound     = -1;
     }
 
     reset();
 }
 
 void SoundFX::reset() {
+    // Channels still playing a volatile sound keep playing it, but forget which it was, since
+    // its slot is about to be reused.
+    for (auto& channel : channels) {
+        if (channel.whichSound >= kMinVolatileSound) {
+            channel.whichSound = -1;
+        }
+    }
     sounds.resize(kMinVolatileSound);
     for (int i = 0; i < kMinVolatileSound; ++i) {
         if (!sounds[i].soundHandle.get()) {
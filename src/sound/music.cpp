@@ -23,6 +23,7 @@
 #include "config/preferences.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
+#include "lang/trace.hpp"
 #include "sound/driver.hpp"
 
 using std::unique_ptr;
@@ -43,6 +44,7 @@ void Music::init() {
 }
 
 void Music::play(Type type, pn::string_view song) {
+    ANTARES_TRACE("sound", "Music::play", song);
     bool   play   = false;
     double volume = 1.0;
     if (type == IDLE) {
@@ -45,6 +45,8 @@ bool Card::next_timer(wall_time& time) {
 
 void Card::fire_timer() {}
 
+bool Card::tick() { return false; }
+
 CardStack* Card::stack() const { return _stack; }
 
 Card* Card::next() const { return _next.get(); }
@@ -23,6 +23,7 @@
 #include "config/preferences.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/time.hpp"
+#include "lang/trace.hpp"
 #include "math/geometry.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
@@ -83,6 +84,7 @@ void EventScheduler::loop(EventScheduler::MainLoop& loop) {
             pop_heap(_event_heap.begin(), _event_heap.end(), is_later);
             _event_heap.pop_back();
             advance_tick_count(loop, std::chrono::time_point_cast<ticks>(event->at()));
+            ANTARES_TRACE("ui", "event");
             MouseReader mr(&_mouse);
             event->send(&mr);
             event->send(loop.top());
@@ -91,6 +93,7 @@ void EventScheduler::loop(EventScheduler::MainLoop& loop) {
                 throw std::runtime_error("Event heap empty and timer not set to fire.");
             }
             advance_tick_count(loop, max(_ticks + kMinorTick, at_ticks));
+            ANTARES_TRACE("ui", "fire_timer");
             loop.top()->fire_timer();
         }
     }
@@ -0,0 +1,137 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/atlas.hpp"
+
+#include <algorithm>
+
+namespace antares {
+
+SkylinePacker::SkylinePacker(Size size) : _size(size) { clear(); }
+
+void SkylinePacker::clear() {
+    _skyline.clear();
+    _skyline.push_back(Segment{0, 0, _size.width});
+    _free.clear();
+}
+
+void SkylinePacker::remove(const Rect& rect) { _free.push_back(rect); }
+
+bool SkylinePacker::reuse(Size size, Point* at) {
+    size_t  best      = _free.size();
+    int64_t best_area = 0;
+    for (size_t i = 0; i < _free.size(); ++i) {
+        const Rect& r    = _free[i];
+        int64_t     area = int64_t{r.width()} * r.height();
+        if ((r.width() >= size.width) && (r.height() >= size.height) &&
+            ((best == _free.size()) || (area < best_area))) {
+            best      = i;
+            best_area = area;
+        }
+    }
+    if (best == _free.size()) {
+        return false;
+    }
+
+    // Split what's left into a strip to the right of the new rect and one below it, giving the
+    // longer edge to the bigger leftover.
+    const Rect r = _free[best];
+    _free.erase(_free.begin() + best);
+    Rect right, below;
+    if ((r.width() - size.width) > (r.height() - size.height)) {
+        right = Rect(r.left + size.width, r.top, r.right, r.bottom);
+        below = Rect(r.left, r.top + size.height, r.left + size.width, r.bottom);
+    } else {
+        right = Rect(r.left + size.width, r.top, r.right, r.top + size.height);
+        below = Rect(r.left, r.top + size.height, r.right, r.bottom);
+    }
+    for (const Rect& leftover : {right, below}) {
+        if ((leftover.width() > 0) && (leftover.height() > 0)) {
+            _free.push_back(leftover);
+        }
+    }
+
+    *at = Point(r.left, r.top);
+    return true;
+}
+
+int32_t SkylinePacker::fit(size_t index, int32_t width) const {
+    if (_skyline[index].x + width > _size.width) {
+        return -1;
+    }
+    int32_t y         = 0;
+    int32_t remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, _skyline[i].y);
+        remaining -= _skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::add(Size size, Point* at) {
+    if ((size.width <= 0) || (size.height <= 0)) {
+        return false;
+    } else if (reuse(size, at)) {
+        return true;
+    }
+
+    size_t  best   = _skyline.size();
+    int32_t best_y = _size.height;
+    for (size_t i = 0; i < _skyline.size(); ++i) {
+        int32_t y = fit(i, size.width);
+        if ((y >= 0) && (y + size.height <= _size.height) &&
+            ((best == _skyline.size()) || (y < best_y))) {
+            best   = i;
+            best_y = y;
+        }
+    }
+    if (best == _skyline.size()) {
+        return false;
+    }
+
+    // Raise the skyline under the new rect, trimming or dropping the segments it covers.
+    const int32_t x     = _skyline[best].x;
+    const int32_t right = x + size.width;
+    auto          it    = _skyline.insert(
+            _skyline.begin() + best, Segment{x, best_y + size.height, size.width});
+    ++it;
+    while ((it != _skyline.end()) && (it->x < right)) {
+        int32_t end = it->x + it->width;
+        if (end <= right) {
+            it = _skyline.erase(it);
+        } else {
+            it->width = end - right;
+            it->x     = right;
+            break;
+        }
+    }
+
+    // Merge neighbors at the same height, so the skyline doesn't fragment.
+    for (size_t i = 1; i < _skyline.size();) {
+        if (_skyline[i - 1].y == _skyline[i].y) {
+            _skyline[i - 1].width += _skyline[i].width;
+            _skyline.erase(_skyline.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+
+    *at = Point(x, best_y);
+    return true;
+}
+
+}  // namespace antares
@@ -0,0 +1,139 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/atlas.hpp"
+
+#include <gmock/gmock.h>
+#include <random>
+#include <vector>
+
+using testing::Eq;
+using testing::Gt;
+
+namespace antares {
+namespace {
+
+using SkylinePackerTest = testing::Test;
+
+TEST_F(SkylinePackerTest, Fill) {
+    SkylinePacker packer({64, 64});
+    Point         at;
+    ASSERT_TRUE(packer.add({32, 16}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 0}));
+    ASSERT_TRUE(packer.add({32, 8}, &at));
+    EXPECT_THAT(at, Eq(Point{32, 0}));
+    ASSERT_TRUE(packer.add({32, 8}, &at));
+    EXPECT_THAT(at, Eq(Point{32, 8}));
+
+    // Wider than either column: sits on the taller one.
+    ASSERT_TRUE(packer.add({64, 48}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 16}));
+    EXPECT_FALSE(packer.add({1, 1}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 16}));
+
+    packer.clear();
+    ASSERT_TRUE(packer.add({64, 64}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 0}));
+}
+
+TEST_F(SkylinePackerTest, Reuse) {
+    SkylinePacker packer({64, 64});
+    Point         at;
+    ASSERT_TRUE(packer.add({64, 32}, &at));
+    ASSERT_TRUE(packer.add({64, 32}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 32}));
+    EXPECT_FALSE(packer.add({1, 1}, &at));
+
+    // The freed rect takes smaller ones, and what they leave over.
+    packer.remove(Rect(0, 0, 64, 32));
+    ASSERT_TRUE(packer.add({16, 32}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 0}));
+    ASSERT_TRUE(packer.add({48, 16}, &at));
+    EXPECT_THAT(at, Eq(Point{16, 0}));
+    ASSERT_TRUE(packer.add({48, 16}, &at));
+    EXPECT_THAT(at, Eq(Point{16, 16}));
+    EXPECT_FALSE(packer.add({1, 1}, &at));
+
+    // Clearing forgets freed rects along with everything else.
+    packer.remove(Rect(0, 0, 16, 32));
+    packer.clear();
+    ASSERT_TRUE(packer.add({64, 64}, &at));
+    EXPECT_THAT(at, Eq(Point{0, 0}));
+    EXPECT_FALSE(packer.add({1, 1}, &at));
+}
+
+TEST_F(SkylinePackerTest, TooBig) {
+    SkylinePacker packer({64, 64});
+    Point         at;
+    EXPECT_FALSE(packer.add({65, 1}, &at));
+    EXPECT_FALSE(packer.add({1, 65}, &at));
+    EXPECT_FALSE(packer.add({0, 0}, &at));
+}
+
+TEST_F(SkylinePackerTest, NoOverlap) {
+    SkylinePacker                          packer({256, 256});
+    std::mt19937                           engine{0x5eed};
+    std::uniform_int_distribution<int32_t> dist(1, 40);
+    std::vector<Rect>                      placed;
+    for (int i = 0; i < 1000; ++i) {
+        Size  size(dist(engine), dist(engine));
+        Point at;
+        if (!packer.add(size, &at)) {
+            continue;
+        }
+        Rect r(at, size);
+        EXPECT_TRUE(Rect(0, 0, 256, 256).encloses(r));
+        for (const Rect& other : placed) {
+            ASSERT_FALSE(r.intersects(other));
+        }
+        placed.push_back(r);
+    }
+    EXPECT_THAT(placed.size(), Gt(40u));
+}
+
+TEST_F(SkylinePackerTest, NoOverlapWithRemoval) {
+    SkylinePacker                          packer({256, 256});
+    std::mt19937                           engine{0x5eed};
+    std::uniform_int_distribution<int32_t> dist(1, 40);
+    std::vector<Rect>                      placed;
+    int                                    added = 0;
+    for (int i = 0; i < 5000; ++i) {
+        if (!placed.empty() && (engine() % 2)) {
+            size_t index = engine() % placed.size();
+            packer.remove(placed[index]);
+            placed.erase(placed.begin() + index);
+            continue;
+        }
+        Size  size(dist(engine), dist(engine));
+        Point at;
+        if (!packer.add(size, &at)) {
+            continue;
+        }
+        ++added;
+        Rect r(at, size);
+        EXPECT_TRUE(Rect(0, 0, 256, 256).encloses(r));
+        for (const Rect& other : placed) {
+            ASSERT_FALSE(r.intersects(other));
+        }
+        placed.push_back(r);
+    }
+    // Far more than fit on the page at once.
+    EXPECT_THAT(added, Gt(400));
+}
+
+}  // namespace
+}  // namespace antares
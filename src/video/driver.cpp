@@ -32,6 +32,15 @@ VideoDriver::VideoDriver() {
 
 VideoDriver::~VideoDriver() { sys.video = NULL; }
 
+Texture VideoDriver::sprite_texture(pn::string_view name, const PixMap& content) {
+    return texture(name, content, 1);
+}
+
+Texture VideoDriver::sprite_texture(
+        pn::string_view name, const PixMap& content, const PixMap& overlay) {
+    return nullptr;
+}
+
 Texture::Impl::~Impl() {}
 
 TextReceiver::~TextReceiver() { sys.video->stop_editing(this); }
@@ -18,40 +18,117 @@
 
 #version 330 core
 
+// Each program is built from this source for a single color mode, by defining MODE as one of the
+// modes below, so that it only does that mode's work. ANY_SPRITE_MODE is for instances of
+// sprites drawn in more than one mode, each of which says its own.
+
+#define FILL_MODE 0
+#define DITHER_MODE 1
+#define DRAW_SPRITE_MODE 2
+#define TINT_SPRITE_MODE 3
+#define STATIC_SPRITE_MODE 4
+#define OUTLINE_SPRITE_MODE 5
+#define ANY_SPRITE_MODE 6
+
 in vec2 uv;
 in vec4 color;
 in vec2 screen_position;
+flat in int   page;
+flat in ivec2 tint;  // The hue, and how far right of the image its overlay is.
+#if MODE == ANY_SPRITE_MODE
+flat in int mode;
+#else
+const int mode = MODE;
+#endif
+#if (MODE == STATIC_SPRITE_MODE) || (MODE == ANY_SPRITE_MODE)
+flat in float static_fraction;
+#endif
 
 out vec4 frag_color;
 
 uniform int scale;
-uniform int color_mode;
 uniform sampler2DRect sprite;
+uniform sampler2DArray atlas;
+uniform int use_atlas;
 uniform sampler2D static_image;
-uniform float     static_fraction;
+uniform sampler2D tints;
 uniform vec2 unit;
+uniform vec4 bounds;
 uniform vec4 outline_color;
 uniform int  seed;
 
-const int FILL_MODE           = 0;
-const int DITHER_MODE         = 1;
-const int DRAW_SPRITE_MODE    = 2;
-const int TINT_SPRITE_MODE    = 3;
-const int STATIC_SPRITE_MODE  = 4;
-const int OUTLINE_SPRITE_MODE = 5;
+// Sprites packed into the atlas are addressed in texels, like the rectangle textures.
+vec4 texel_at(vec2 at) {
+    if (use_atlas != 0) {
+        return texture(atlas, vec3(at / vec2(textureSize(atlas, 0).xy), page));
+    }
+    return texture(sprite, at);
+}
+
+// The overlay's red channel picks a shade of the hue, and its alpha is how much of that covers
+// the image. Works in bytes, to come out exactly as compositing on the CPU does.
+vec4 tinted(vec4 under_color, vec4 over_color) {
+    ivec4 over_bytes = ivec4(round(over_color * 255.0));
+    ivec3 over  = ivec3(round(texelFetch(tints, ivec2(over_bytes.r, tint.x), 0).rgb * 255.0));
+    ivec3 under = ivec3(round(under_color.rgb * 255.0));
+    int   frac  = over_bytes.a;
+    ivec3 composite = ((over * frac) + (under * (255 - frac))) / 255;
+    return vec4(vec3(composite) / 255.0, under_color.a);
+}
+
+vec4 image_color() {
+    vec4 sprite_color = texel_at(uv);
+    if (tint.x != 0) {
+        sprite_color = tinted(sprite_color, texel_at(uv + vec2(tint.y, 0)));
+    }
+    return sprite_color;
+}
+
+#if MODE == OUTLINE_SPRITE_MODE
+
+// Neighbors outside the image's border read as clear, as they would from a texture of its own.
+float alpha_at(vec2 at) {
+    return texel_at(clamp(at, bounds.xy, bounds.zw)).w;
+}
 
 void main() {
-    vec4 sprite_color = texture(sprite, uv);
-    if (color_mode == FILL_MODE) {
-        frag_color = color;
-    } else if (color_mode == DITHER_MODE) {
+    float alpha        = texel_at(uv).w;
+    float neighborhood = alpha_at(uv + vec2(-unit.s, -unit.t)) +
+                         alpha_at(uv + vec2(-unit.s, 0)) +
+                         alpha_at(uv + vec2(-unit.s, unit.t)) +
+                         alpha_at(uv + vec2(0, -unit.t)) +
+                         alpha_at(uv + vec2(0, unit.t)) +
+                         alpha_at(uv + vec2(unit.s, -unit.t)) +
+                         alpha_at(uv + vec2(unit.s, 0)) +
+                         alpha_at(uv + vec2(unit.s, unit.t));
+    if (alpha > (neighborhood / 8)) {
+        frag_color = outline_color;
+    } else if (alpha > 0) {
         frag_color = color;
+    } else {
+        frag_color = vec4(0, 0, 0, 0);
+    }
+}
+
+#elif (MODE == FILL_MODE) || (MODE == DITHER_MODE)
+
+void main() {
+    frag_color = color;
+    if (mode == DITHER_MODE) {
         frag_color.a /= 2;
-    } else if (color_mode == DRAW_SPRITE_MODE) {
+    }
+}
+
+#else
+
+void main() {
+    vec4 sprite_color = image_color();
+    if (mode == DRAW_SPRITE_MODE) {
         frag_color = sprite_color;
-    } else if (color_mode == TINT_SPRITE_MODE) {
+    } else if (mode == TINT_SPRITE_MODE) {
         frag_color = color * sprite_color;
-    } else if (color_mode == STATIC_SPRITE_MODE) {
+    } else if (mode == STATIC_SPRITE_MODE) {
+#if (MODE == STATIC_SPRITE_MODE) || (MODE == ANY_SPRITE_MODE)
         float f            = scale / 256.0;
         vec2  uv2          = (screen_position + vec2(seed * f, seed)) * vec2(f, f);
         vec4  static_color = texture(static_image, uv2).rrrg;
@@ -61,21 +138,8 @@ void main() {
         } else {
             frag_color = sprite_color;
         }
-    } else if (color_mode == OUTLINE_SPRITE_MODE) {
-        float neighborhood = texture(sprite, uv + vec2(-unit.s, -unit.t)).w +
-                             texture(sprite, uv + vec2(-unit.s, 0)).w +
-                             texture(sprite, uv + vec2(-unit.s, unit.t)).w +
-                             texture(sprite, uv + vec2(0, -unit.t)).w +
-                             texture(sprite, uv + vec2(0, unit.t)).w +
-                             texture(sprite, uv + vec2(unit.s, -unit.t)).w +
-                             texture(sprite, uv + vec2(unit.s, 0)).w +
-                             texture(sprite, uv + vec2(unit.s, unit.t)).w;
-        if (sprite_color.w > (neighborhood / 8)) {
-            frag_color = outline_color;
-        } else if (sprite_color.w > 0) {
-            frag_color = color;
-        } else {
-            frag_color = vec4(0, 0, 0, 0);
-        }
+#endif
     }
 }
+
+#endif
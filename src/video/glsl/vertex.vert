@@ -18,22 +18,55 @@
 
 #version 330 core
 
+// Programs that draw instances are built with INSTANCED defined as 1, and others with 0.
+
 in vec2 vertex;
 in vec4 in_color;
 in vec2 tex_coord;
+in int   in_page;
+in ivec2 in_tint;
+#if INSTANCED
+in vec4  in_dest;    // An instance's quad: left, top, right, bottom.
+in vec4  in_source;  // The same, in texels.
+in ivec2 in_style;   // The color mode, and the static fraction out of 255.
+#endif
 
 out vec2 uv;
 out vec4 color;
 out vec2 screen_position;
+flat out int   page;
+flat out ivec2 tint;
+#if INSTANCED
+flat out int   mode;
+flat out float static_fraction;
+#endif
 
 uniform vec2 screen;
 
+#if INSTANCED
+// An instance's corners, in the order that Batch::add_quad() makes a quad's triangles.
+const vec2 corners[6] =
+        vec2[6](vec2(0, 0), vec2(0, 1), vec2(1, 1), vec2(0, 0), vec2(1, 1), vec2(1, 0));
+#endif
+
 void main() {
     mat4 transform =
             mat4(2.0 / screen.x, 0, 0, 0, 0, -2.0 / screen.y, 0, 0, 0, 0, 0, 0, -1.0, 1.0, 0, 1);
 
-    gl_Position     = transform * vec4(vertex, 0, 1);
-    uv              = tex_coord;
-    screen_position = vertex;
+#if INSTANCED
+    vec2 corner     = corners[gl_VertexID];
+    vec2 position   = mix(in_dest.xy, in_dest.zw, corner);
+    uv              = mix(in_source.xy, in_source.zw, corner);
+    mode            = in_style.x;
+    static_fraction = in_style.y / 255.0;
+#else
+    vec2 position = vertex;
+    uv            = tex_coord;
+#endif
+
+    gl_Position     = transform * vec4(position, 0, 1);
+    screen_position = position;
     color           = in_color;
+    page            = in_page;
+    tint            = in_tint;
 }
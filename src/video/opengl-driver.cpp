@@ -18,14 +18,19 @@
 
 #include "video/opengl-driver.hpp"
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
+#include <memory>
 #include <pn/output>
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
 #include "drawing/shapes.hpp"
 #include "game/globals.hpp"
+#include "game/profile.hpp"
+#include "lang/trace.hpp"
 #include "math/geometry.hpp"
 #include "math/random.hpp"
 #include "ui/card.hpp"
@@ -50,31 +55,69 @@ using std::unique_ptr;
 
 namespace antares {
 
-template <typename T>
-void Uniform<T>::load(int program) {
-    location = glGetUniformLocation(program, name);
-}
-
 template <>
-void Uniform<int>::set(int value) const {
+void Uniform<int>::upload(int location) const {
     glUniform1i(location, value);
 }
 
 template <>
-void Uniform<float>::set(float value) const {
+void Uniform<float>::upload(int location) const {
     glUniform1f(location, value);
 }
 
 template <>
-void Uniform<vec2>::set(vec2 value) const {
+void Uniform<vec2>::upload(int location) const {
     glUniform2f(location, value.x, value.y);
 }
 
 template <>
-void Uniform<vec4>::set(vec4 value) const {
+void Uniform<vec4>::upload(int location) const {
     glUniform4f(location, value.x, value.y, value.z, value.w);
 }
 
+template <typename T>
+void Uniform<T>::load(int index, int program) {
+    locations[index] = glGetUniformLocation(program, name);
+}
+
+// Must be called with the program at `index` in use.
+template <typename T>
+void Uniform<T>::apply(int index) {
+    const uint32_t bit = 1u << index;
+    if (stale & bit) {
+        upload(locations[index]);
+        stale &= ~bit;
+    }
+}
+
+void OpenGlVideoDriver::Uniforms::load(int index, uint32_t program) {
+    screen.load(index, program);
+    scale.load(index, program);
+    sprite.load(index, program);
+    atlas.load(index, program);
+    use_atlas.load(index, program);
+    static_image.load(index, program);
+    tints.load(index, program);
+    unit.load(index, program);
+    bounds.load(index, program);
+    outline_color.load(index, program);
+    seed.load(index, program);
+}
+
+void OpenGlVideoDriver::Uniforms::apply(int index) {
+    screen.apply(index);
+    scale.apply(index);
+    sprite.apply(index);
+    atlas.apply(index);
+    use_atlas.apply(index);
+    static_image.apply(index);
+    tints.apply(index);
+    unit.apply(index);
+    bounds.apply(index);
+    outline_color.apply(index);
+    seed.apply(index);
+}
+
 namespace {
 
 enum {
@@ -84,6 +127,17 @@ enum {
     TINT_SPRITE_MODE    = 3,
     STATIC_SPRITE_MODE  = 4,
     OUTLINE_SPRITE_MODE = 5,
+    ANY_SPRITE_MODE     = 6,  // Instances in more than one of the sprite modes.
+};
+
+static_assert(ANY_SPRITE_MODE + 1 == kShaderPrograms, "one program per mode");
+static_assert(
+        kShaderPrograms <= (sizeof(VideoDriver::DrawStats::program_times) /
+                            sizeof(VideoDriver::DrawStats::ProgramTime)),
+        "a time for each program");
+
+const char* const kProgramNames[kShaderPrograms] = {
+        "fill", "dither", "sprite", "tint", "static", "outline", "any sprite",
 };
 
 #ifndef NDEBUG
@@ -117,6 +171,7 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 
 #define glActiveTexture(texture) _GL(glActiveTexture, texture)
 #define glAttachShader(program, shader) _GL(glAttachShader, program, shader)
+#define glBeginQuery(target, id) _GL(glBeginQuery, target, id)
 #define glBindTexture(target, texture) _GL(glBindTexture, target, texture)
 #define glBlendFunc(sfactor, dfactor) _GL(glBlendFunc, sfactor, dfactor)
 #define glClear(mask) _GL(glClear, mask)
@@ -127,6 +182,7 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 #define glDeleteTextures(n, textures) _GL(glDeleteTextures, n, textures)
 #define glDisable(cap) _GL(glDisable, cap)
 #define glEnable(cap) _GL(glEnable, cap)
+#define glEndQuery(target) _GL(glEndQuery, target)
 #define glFinish() _GL(glFinish)
 #define glGenTextures(n, textures) _GL(glGenTextures, n, textures)
 // Skip glGetError().
@@ -156,12 +212,18 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 #define glEnableClientState(array) _GL(glEnableClientState, array)
 #define glDisableClientState(array) _GL(glDisableClientState, array)
 #define glDrawArrays(mode, first, count) _GL(glDrawArrays, mode, first, count)
+#define glDrawArraysInstanced(mode, first, count, instancecount) \
+    _GL(glDrawArraysInstanced, mode, first, count, instancecount)
 #define glGenBuffers(n, buffers) _GL(glGenBuffers, n, buffers)
 #define glBindBuffer(target, buffer) _GL(glBindBuffer, target, buffer)
 #define glBufferData(target, size, data, usage) _GL(glBufferData, target, size, data, usage)
+#define glMapBufferRange(target, offset, length, access) \
+    _GLV(glMapBufferRange, target, offset, length, access)
+#define glUnmapBuffer(target) _GLV(glUnmapBuffer, target)
 #define glVertexAttribPointer(index, size, type, normalized, stride, pointer) \
     _GL(glVertexAttribPointer, index, size, type, normalized, stride, pointer)
 #define glEnableVertexAttribArray(index) _GL(glEnableVertexAttribArray, index)
+#define glVertexAttribDivisor(index, divisor) _GL(glVertexAttribDivisor, index, divisor)
 #define glDisableVertexAttribArray(index) _GL(glDisableVertexAttribArray, index)
 
 #endif  // NDEBUG
@@ -185,174 +247,154 @@ void gl_log(GLint object) {
     pn::err.format("object {0} log: {1}\n", object, (const char*)log.get());
 }
 
-class OpenGlTextureImpl : public Texture::Impl {
-  public:
-    OpenGlTextureImpl(
-            pn::string_view name, const PixMap& image, int scale,
-            const OpenGlVideoDriver::Uniforms& uniforms, GLuint vbuf[3])
-            : _name(name.copy()),
-              _size(image.size()),
-              _scale(scale),
-              _uniforms(uniforms),
-              _vbuf(vbuf) {
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+// Big enough for any frame the game draws, so each buffer is orphaned at most once per frame.
+const size_t kRingVertices  = 1 << 16;
+const size_t kRingInstances = 1 << 14;
+
+// GL 3.2 guarantees at least this much for both dimensions of a texture, and it fits plenty of
+// sprites per page.
+const int32_t kAtlasPageSize = 1024;
+
 #if defined(__LITTLE_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8;
+const GLenum kPixelType = GL_UNSIGNED_INT_8_8_8_8;
 #elif defined(__BIG_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8_REV;
+const GLenum kPixelType = GL_UNSIGNED_INT_8_8_8_8_REV;
 #else
 #error "Couldn't determine endianness of platform"
 #endif
 
-        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
-        Size size = image.size();
-        size.width += 2;
-        size.height += 2;
-        ArrayPixMap copy(size);
-        copy.fill(RgbColor::clear());
-        copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
-        glTexImage2D(
-                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA, type,
-                copy.bytes());
-    }
+// Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
+ArrayPixMap with_border(const PixMap& image) {
+    Size size = image.size();
+    size.width += 2;
+    size.height += 2;
+    ArrayPixMap copy(size);
+    copy.fill(RgbColor::clear());
+    copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
+    return copy;
+}
 
+// Draws through the batch; subclasses say where the texture's texels are.
+class OpenGlTextureImpl : public Texture::Impl {
+  public:
     virtual pn::string_view name() const { return _name; }
 
     virtual void draw(const Rect& draw_rect) const {
-        _uniforms.color_mode.set(DRAW_SPRITE_MODE);
-        draw_internal(draw_rect, RgbColor::white());
+        draw_instance(draw_rect, DRAW_SPRITE_MODE, RgbColor::white(), 0);
     }
 
     virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {
-        begin_quads();
         draw_quad(dest, source, tint);
-        end_quads();
     }
 
     virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        draw_internal(draw_rect, tint);
+        draw_instance(draw_rect, TINT_SPRITE_MODE, tint, 0);
     }
 
     virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
-        _uniforms.color_mode.set(STATIC_SPRITE_MODE);
-        _uniforms.static_fraction.set(frac / 255.0f);
-        draw_internal(draw_rect, color);
+        draw_instance(draw_rect, STATIC_SPRITE_MODE, color, frac);
     }
 
     virtual void draw_outlined(
             const Rect& draw_rect, const RgbColor& outline_color,
             const RgbColor& fill_color) const {
-        _uniforms.color_mode.set(OUTLINE_SPRITE_MODE);
+        _batch.flush();
         _uniforms.unit.set({float(_size.width) / draw_rect.width(),
                             float(_size.height) / draw_rect.height()});
         _uniforms.outline_color.set({outline_color.red / 255.0f, outline_color.green / 255.0f,
                                      outline_color.blue / 255.0f, outline_color.alpha / 255.0f});
-        draw_internal(draw_rect, fill_color);
+
+        // Keep the outline's samples within the border, as if the texture were clamped to it.
+        const Point o = origin();
+        _uniforms.bounds.set({o.h - 0.5f, o.v - 0.5f, o.h + _size.width + 0.5f,
+                              o.v + _size.height + 0.5f});
+        use(OUTLINE_SPRITE_MODE);
+        _batch.add_quad(draw_rect, image_rect(), fill_color, _sheet);
     }
 
     virtual const Size& size() const { return _size; }
 
-  private:
-    virtual void draw_internal(const Rect& draw_rect, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(draw_rect.left),   GLshort(draw_rect.top),   GLshort(draw_rect.left),
-                GLshort(draw_rect.bottom), GLshort(draw_rect.right), GLshort(draw_rect.bottom),
-                GLshort(draw_rect.right),  GLshort(draw_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        const int32_t w            = _size.width / _scale;
-        const int32_t h            = _size.height / _scale;
-        GLshort       tex_coords[] = {
-                GLshort(1),     GLshort(1),     GLshort(1),     GLshort(h + 1),
-                GLshort(w + 1), GLshort(h + 1), GLshort(w + 1), GLshort(1),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
+  protected:
+    OpenGlTextureImpl(
+            pn::string_view name, Size size, int scale,
+            OpenGlVideoDriver::Uniforms& uniforms, OpenGlVideoDriver::Batch& batch)
+            : _uniforms(uniforms), _batch(batch), _name(name.copy()), _size(size), _scale(scale) {}
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    // Readies the batch for quads drawn from this texture in `color_mode`, or for instances.
+    virtual void use(int color_mode) const = 0;
+    virtual void use_instances() const     = 0;
 
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
-    }
+    // Where the image starts, inside its border.
+    virtual Point origin() const = 0;
 
-    virtual void begin_quads() const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+    OpenGlVideoDriver::Uniforms& _uniforms;
+    OpenGlVideoDriver::Batch&          _batch;
+    OpenGlVideoDriver::Batch::Sheet    _sheet = {0, 0, 0};
+
+  private:
+    Rect image_rect() const {
+        Rect texture_rect(0, 0, _size.width / _scale, _size.height / _scale);
+        texture_rect.offset(origin().h, origin().v);
+        return texture_rect;
     }
 
-    virtual void end_quads() const {}
+    void draw_instance(
+            const Rect& draw_rect, int color_mode, const RgbColor& tint, uint8_t frac) const {
+        use_instances();
+        _batch.add_instance(draw_rect, image_rect(), tint, color_mode, frac, _sheet);
+    }
 
     virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(dest.left),   GLshort(dest.top),   GLshort(dest.left),
-                GLshort(dest.bottom), GLshort(dest.right), GLshort(dest.bottom),
-                GLshort(dest.right),  GLshort(dest.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
         Rect texture_rect = source;
         texture_rect.scale(_scale, _scale);
-        texture_rect.offset(1, 1);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        GLshort tex_coords[] = {
-                GLshort(texture_rect.left),  GLshort(texture_rect.top),
-                GLshort(texture_rect.left),  GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
+        texture_rect.offset(origin().h, origin().v);
+        use_instances();
+        _batch.add_instance(dest, texture_rect, tint, TINT_SPRITE_MODE, 0, _sheet);
+    }
 
-        glActiveTexture(GL_TEXTURE0);
+    const pn::string _name;
+    Size             _size;
+    int              _scale;
+};
+
+// A texture of its own.
+class RectTextureImpl : public OpenGlTextureImpl {
+  public:
+    RectTextureImpl(
+            pn::string_view name, const PixMap& image, int scale,
+            OpenGlVideoDriver::Uniforms& uniforms, OpenGlVideoDriver::Batch& batch,
+            int64_t* texture_bytes)
+            : OpenGlTextureImpl(name, image.size(), scale, uniforms, batch),
+              _texture_bytes(texture_bytes) {
+        ANTARES_TRACE("gl", "upload texture", name);
+        _batch.flush();
         glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+        _batch.forget_texture();
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
+        ArrayPixMap copy = with_border(image);
+        glTexImage2D(
+                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, copy.size().width, copy.size().height, 0,
+                GL_BGRA, kPixelType, copy.bytes());
+        _bytes = int64_t{4} * copy.size().width * copy.size().height;
+        *_texture_bytes += _bytes;
+    }
+
+    ~RectTextureImpl() {
+        // Pending vertices may sample the texture that's about to be deleted.
+        _batch.flush();
+        _batch.forget_texture();
+        *_texture_bytes -= _bytes;
     }
 
+  private:
+    virtual void  use(int color_mode) const { _batch.use(GL_TRIANGLES, color_mode, _texture.id); }
+    virtual void  use_instances() const { _batch.use_instances(_texture.id); }
+    virtual Point origin() const { return Point(1, 1); }
+
     struct Texture {
         Texture() { glGenTextures(1, &id); }
         Texture(const Texture&) = delete;
@@ -362,99 +404,488 @@ class OpenGlTextureImpl : public Texture::Impl {
         GLuint id;
     };
 
-    const pn::string                   _name;
-    Texture                            _texture;
-    Size                               _size;
-    int                                _scale;
-    const OpenGlVideoDriver::Uniforms& _uniforms;
-    GLuint*                            _vbuf;
+    Texture  _texture;
+    int64_t* _texture_bytes;
+    int64_t  _bytes;
 };
 
-}  // namespace
+// Space in the atlas, shared by each hue an image is drawn in.
+struct AtlasSpace {
+    AtlasSpace(OpenGlVideoDriver::Atlas& atlas, const OpenGlVideoDriver::Atlas::Entry& entry)
+            : atlas(atlas), entry(entry) {}
+    AtlasSpace(const AtlasSpace&) = delete;
+    AtlasSpace& operator=(const AtlasSpace&) = delete;
+    ~AtlasSpace() { atlas.remove(entry); }
 
-OpenGlVideoDriver::OpenGlVideoDriver() : _static_seed{0} {}
+    OpenGlVideoDriver::Atlas&             atlas;
+    const OpenGlVideoDriver::Atlas::Entry entry;
+};
 
-int OpenGlVideoDriver::scale() const { return viewport_size().width / screen_size().width; }
+// An image packed into the atlas, and maybe its overlay, tinted with `hue`.
+class AtlasTextureImpl : public OpenGlTextureImpl {
+  public:
+    AtlasTextureImpl(
+            pn::string_view name, Size size, OpenGlVideoDriver::Uniforms& uniforms,
+            OpenGlVideoDriver::Batch& batch, std::shared_ptr<const AtlasSpace> space,
+            bool has_overlay, Hue hue)
+            : OpenGlTextureImpl(name, size, 1, uniforms, batch),
+              _space(std::move(space)),
+              _has_overlay(has_overlay) {
+        _sheet.page = _space->entry.page;
+        if (_has_overlay) {
+            _sheet.hue     = static_cast<int16_t>(hue);
+            _sheet.overlay = size.width + 2;
+        }
+    }
 
-Texture OpenGlVideoDriver::texture(pn::string_view name, const PixMap& content, int scale) {
-    return unique_ptr<Texture::Impl>(
-            new OpenGlTextureImpl(name, content, scale, _uniforms, _vbuf));
+    virtual unique_ptr<Texture::Impl> tinted(Hue hue) const {
+        if (!_has_overlay) {
+            return nullptr;
+        }
+        return unique_ptr<Texture::Impl>(
+                new AtlasTextureImpl(name(), size(), _uniforms, _batch, _space, true, hue));
+    }
+
+  private:
+    virtual void  use(int color_mode) const { _batch.use(GL_TRIANGLES, color_mode, 0, true); }
+    virtual void  use_instances() const { _batch.use_instances(0, true); }
+    virtual Point origin() const {
+        return Point(_space->entry.rect.left + 1, _space->entry.rect.top + 1);
+    }
+
+    const std::shared_ptr<const AtlasSpace> _space;
+    const bool                              _has_overlay;
+};
+
+}  // namespace
+
+OpenGlVideoDriver::Batch::Batch(Uniforms& uniforms) : _uniforms(uniforms) {
+    _vertices.reserve(kRingVertices);
+    _instances.reserve(kRingInstances);
 }
 
-void OpenGlVideoDriver::begin_rects() { _uniforms.color_mode.set(FILL_MODE); }
+void OpenGlVideoDriver::Batch::setup(const uint32_t* programs) {
+    std::copy(programs, programs + kShaderPrograms, _programs);
+
+    glGenVertexArrays(1, &_instance_array);
+    glBindVertexArray(_instance_array);
+    glGenBuffers(1, &_instance_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+    glBufferData(
+            GL_ARRAY_BUFFER, kRingInstances * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+    point_instances(0);
+    for (GLuint index : {1, 3, 4, 5, 6, 7}) {
+        glEnableVertexAttribArray(index);
+        glVertexAttribDivisor(index, 1);
+    }
 
-void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    glGenVertexArrays(1, &_vertex_array);
+    glBindVertexArray(_vertex_array);
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    glBufferData(GL_ARRAY_BUFFER, kRingVertices * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+    glVertexAttribPointer(
+            1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, r));
+    glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+    glVertexAttribIPointer(3, 1, GL_SHORT, sizeof(Vertex), (void*)offsetof(Vertex, sheet.page));
+    glVertexAttribIPointer(4, 2, GL_SHORT, sizeof(Vertex), (void*)offsetof(Vertex, sheet.hue));
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+    glEnableVertexAttribArray(4);
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLshort vertices[] = {
-            GLshort(rect.right), GLshort(rect.top),    GLshort(rect.left),  GLshort(rect.top),
-            GLshort(rect.left),  GLshort(rect.bottom), GLshort(rect.right), GLshort(rect.bottom),
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,  color.green, color.blue, color.alpha, color.red,  color.green,
-            color.blue, color.alpha, color.red,  color.green, color.blue, color.alpha,
-            color.red,  color.green, color.blue, color.alpha,
+void OpenGlVideoDriver::Batch::use(
+        uint32_t primitive, int color_mode, uint32_t texture, bool atlas) {
+    if (!_instanced && (primitive == _primitive) && (color_mode == _color_mode) &&
+        same_texture(texture, atlas)) {
+        return;
+    }
+    flush();
+    set_instanced(false);
+    _primitive  = primitive;
+    _color_mode = color_mode;
+    bind(texture, atlas);
+}
+
+void OpenGlVideoDriver::Batch::use_instances(uint32_t texture, bool atlas) {
+    if (_instanced && same_texture(texture, atlas)) {
+        return;
+    }
+    flush();
+    set_instanced(true);
+    bind(texture, atlas);
+}
+
+bool OpenGlVideoDriver::Batch::same_texture(uint32_t texture, bool atlas) const {
+    return atlas ? _atlas : ((texture == 0) || (!_atlas && (texture == _texture)));
+}
+
+void OpenGlVideoDriver::Batch::bind(uint32_t texture, bool atlas) {
+    if (same_texture(texture, atlas)) {
+        return;
+    }
+    // The atlas stays bound to its own texture unit, so switching to it binds nothing.
+    if (atlas != _atlas) {
+        _uniforms.use_atlas.set(atlas);
+        _atlas = atlas;
+    }
+    if (!atlas && (texture != _texture)) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_RECTANGLE, texture);
+        _texture = texture;
+    }
+    _stats.texture_switches += 1;
+}
+
+// Vertices and instances each have a vertex array of their own.
+void OpenGlVideoDriver::Batch::set_instanced(bool instanced) {
+    if (instanced == _instanced) {
+        return;
+    }
+    glBindVertexArray(instanced ? _instance_array : _vertex_array);
+    _instanced = instanced;
+}
+
+// GL 3.3 can't start an instanced draw partway through its instances, so the attributes are
+// pointed at the first one to draw instead.
+void OpenGlVideoDriver::Batch::point_instances(size_t first) {
+    const size_t base = first * sizeof(Instance);
+    glVertexAttribPointer(
+            5, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+            (void*)(base + offsetof(Instance, left)));
+    glVertexAttribPointer(
+            6, 4, GL_SHORT, GL_FALSE, sizeof(Instance),
+            (void*)(base + offsetof(Instance, u_left)));
+    glVertexAttribPointer(
+            1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance),
+            (void*)(base + offsetof(Instance, r)));
+    glVertexAttribIPointer(
+            7, 2, GL_UNSIGNED_BYTE, sizeof(Instance),
+            (void*)(base + offsetof(Instance, color_mode)));
+    glVertexAttribIPointer(
+            3, 1, GL_SHORT, sizeof(Instance), (void*)(base + offsetof(Instance, sheet.page)));
+    glVertexAttribIPointer(
+            4, 2, GL_SHORT, sizeof(Instance), (void*)(base + offsetof(Instance, sheet.hue)));
+}
+
+OpenGlVideoDriver::Batch::Vertex* OpenGlVideoDriver::Batch::add(size_t count) {
+    if (_vertices.size() + count > kRingVertices) {
+        flush();
+    }
+    size_t size = _vertices.size();
+    _vertices.resize(size + count);
+    return &_vertices[size];
+}
+
+void OpenGlVideoDriver::Batch::add_quad(
+        const Rect& dest, const Rect& source, const RgbColor& tint, const Sheet& sheet) {
+    const Vertex corners[] = {
+            {float(dest.left), float(dest.top), tint.red, tint.green, tint.blue, tint.alpha,
+             int16_t(source.left), int16_t(source.top), sheet},
+            {float(dest.left), float(dest.bottom), tint.red, tint.green, tint.blue, tint.alpha,
+             int16_t(source.left), int16_t(source.bottom), sheet},
+            {float(dest.right), float(dest.bottom), tint.red, tint.green, tint.blue, tint.alpha,
+             int16_t(source.right), int16_t(source.bottom), sheet},
+            {float(dest.right), float(dest.top), tint.red, tint.green, tint.blue, tint.alpha,
+             int16_t(source.right), int16_t(source.top), sheet},
     };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
+    Vertex* v = add(6);
+    v[0]      = corners[0];
+    v[1]      = corners[1];
+    v[2]      = corners[2];
+    v[3]      = corners[0];
+    v[4]      = corners[2];
+    v[5]      = corners[3];
+}
+
+void OpenGlVideoDriver::Batch::add_instance(
+        const Rect& dest, const Rect& source, const RgbColor& tint, int color_mode,
+        uint8_t fraction, const Sheet& sheet) {
+    if (_instances.size() == kRingInstances) {
+        flush();
+    }
+    _instance_modes |= 1u << color_mode;
+    _instances.push_back(Instance{
+            float(dest.left), float(dest.top), float(dest.right), float(dest.bottom),
+            int16_t(source.left), int16_t(source.top), int16_t(source.right),
+            int16_t(source.bottom), tint.red, tint.green, tint.blue, tint.alpha,
+            uint8_t(color_mode), fraction, sheet});
+}
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+void OpenGlVideoDriver::Batch::flush() {
+    if (_instanced) {
+        flush_instances();
+        return;
+    } else if (_vertices.empty()) {
+        return;
+    }
+    ANTARES_TRACE("gl", "flush");
+
+    // Once the ring is full, orphan it: the driver hands back fresh storage, and the old storage
+    // is freed once the draws reading from it are done. Until then, each flush writes past the
+    // last, so it can't overwrite anything a pending draw still reads.
+    const size_t count = _vertices.size();
+    if (_offset + count > kRingVertices) {
+        glBufferData(GL_ARRAY_BUFFER, kRingVertices * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        _offset = 0;
+    }
+    void* dest = glMapBufferRange(
+            GL_ARRAY_BUFFER, _offset * sizeof(Vertex), count * sizeof(Vertex),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    memcpy(dest, _vertices.data(), count * sizeof(Vertex));
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    start_draw(_color_mode);
+    glDrawArrays(_primitive, _offset, count);
+    finish_draw();
+    _offset += count;
+    _stats.draw_calls += 1;
+    _stats.vertices += count;
+    _vertices.clear();
+}
 
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+void OpenGlVideoDriver::Batch::flush_instances() {
+    if (_instances.empty()) {
+        return;
+    }
+    ANTARES_TRACE("gl", "flush instances");
+
+    // Streamed like vertices, through a ring of their own.
+    const size_t count = _instances.size();
+    glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+    if (_instance_offset + count > kRingInstances) {
+        glBufferData(
+                GL_ARRAY_BUFFER, kRingInstances * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+        _instance_offset = 0;
+    }
+    void* dest = glMapBufferRange(
+            GL_ARRAY_BUFFER, _instance_offset * sizeof(Instance), count * sizeof(Instance),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    memcpy(dest, _instances.data(), count * sizeof(Instance));
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    point_instances(_instance_offset);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+
+    // Instances in a single mode get the program for it.
+    int program = ANY_SPRITE_MODE;
+    for (int mode : {DRAW_SPRITE_MODE, TINT_SPRITE_MODE, STATIC_SPRITE_MODE}) {
+        if (_instance_modes == (1u << mode)) {
+            program = mode;
+        }
+    }
+    start_draw(program);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+    finish_draw();
+    _instance_offset += count;
+    _stats.draw_calls += 1;
+    _stats.instances += count;
+    _instances.clear();
+    _instance_modes = 0;
 }
 
-void OpenGlVideoDriver::end_rects() {}
+void OpenGlVideoDriver::Batch::start_draw(int program) {
+    if (program != _program) {
+        glUseProgram(_programs[program]);
+        _program = program;
+        _stats.program_switches += 1;
+    }
+    _uniforms.apply(program);
+
+    if (_timing) {
+        if (_free_queries.empty()) {
+            GLuint query;
+            glGenQueries(1, &query);
+            _free_queries.push_back(query);
+        }
+        _queries.emplace_back(_free_queries.back(), program);
+        _free_queries.pop_back();
+        glBeginQuery(GL_TIME_ELAPSED, _queries.back().first);
+    }
+}
 
-void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
-    _uniforms.color_mode.set(DITHER_MODE);
-    batch_rect(rect, color);
+void OpenGlVideoDriver::Batch::finish_draw() {
+    if (_timing) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
 }
 
-void OpenGlVideoDriver::begin_points() { _uniforms.color_mode.set(FILL_MODE); }
+void OpenGlVideoDriver::Batch::collect_times() {
+    for (const auto& q : _queries) {
+        GLuint64 nsecs;
+        glGetQueryObjectui64v(q.first, GL_QUERY_RESULT, &nsecs);
+        _stats.program_times[q.second].nsecs += nsecs;
+        _free_queries.push_back(q.first);
+    }
+    _queries.clear();
+}
 
-void OpenGlVideoDriver::end_points() {}
+VideoDriver::DrawStats OpenGlVideoDriver::Batch::take_stats() {
+    DrawStats stats = _stats;
+    for (int i = 0; i < kShaderPrograms; ++i) {
+        stats.program_times[i].name = kProgramNames[i];
+    }
+    _stats = DrawStats();
+    return stats;
+}
 
-void OpenGlVideoDriver::batch_point(const Point& at, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
+OpenGlVideoDriver::Atlas::Atlas(Batch& batch) : _batch(batch) {}
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {GLfloat(at.h + 0.5), GLfloat(at.v + 0.5)};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,
-            color.green,
-            color.blue,
-            color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
+OpenGlVideoDriver::Atlas::~Atlas() {
+    if (_texture) {
+        glDeleteTextures(1, &_texture);
+    }
+}
 
-    glDrawArrays(GL_POINTS, 0, 1);
+bool OpenGlVideoDriver::Atlas::add(const PixMap& image, const PixMap* overlay, Entry* entry) {
+    const Size size((image.size().width + 2) * (overlay ? 2 : 1), image.size().height + 2);
+    if ((size.width > kAtlasPageSize) || (size.height > kAtlasPageSize)) {
+        return false;
+    }
 
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    Point  at;
+    size_t page = 0;
+    while ((page < _pages.size()) && !_pages[page].packer.add(size, &at)) {
+        ++page;
+    }
+    if (page == _pages.size()) {
+        _pages.push_back(Page{SkylinePacker({kAtlasPageSize, kAtlasPageSize}), 0});
+        _pages.back().packer.add(size, &at);
+    }
+    if (_pages.size() > size_t(_layers)) {
+        grow();
+    }
+    ++_pages[page].images;
+    *entry = Entry{int16_t(page), Rect(at, size)};
+
+    // Pending vertices may sample a cleared page that this image is about to overwrite.
+    _batch.flush();
+    ArrayPixMap copy(size);
+    copy.fill(RgbColor::clear());
+    copy.view(Rect(Point(1, 1), image.size())).copy(image);
+    if (overlay) {
+        copy.view(Rect(Point(image.size().width + 3, 1), image.size())).copy(*overlay);
+    }
+    glActiveTexture(GL_TEXTURE2);
+    glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, at.h, at.v, page, size.width, size.height, 1, GL_BGRA,
+            kPixelType, copy.bytes());
+    glActiveTexture(GL_TEXTURE0);
+    return true;
 }
 
-void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
-    begin_points();
-    batch_point(at, color);
-    end_points();
+void OpenGlVideoDriver::Atlas::remove(const Entry& entry) {
+    Page& page = _pages[entry.page];
+    if (--page.images == 0) {
+        page.packer.clear();
+    } else {
+        page.packer.remove(entry.rect);
+    }
 }
 
-void OpenGlVideoDriver::begin_lines() { _uniforms.color_mode.set(FILL_MODE); }
+int64_t OpenGlVideoDriver::Atlas::bytes() const {
+    return int64_t{4} * kAtlasPageSize * kAtlasPageSize * _layers;
+}
+
+void OpenGlVideoDriver::Atlas::grow() {
+    ANTARES_TRACE("gl", "grow atlas");
+    _batch.flush();
+    int32_t layers = max(_layers * 2, 1);
+    while (size_t(layers) < _pages.size()) {
+        layers *= 2;
+    }
 
-void OpenGlVideoDriver::end_lines() {}
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, kAtlasPageSize, kAtlasPageSize, layers, 0, GL_BGRA,
+            kPixelType, nullptr);
+
+    // GL 3.2 can't copy between textures directly, so read the old pages through a framebuffer.
+    if (_texture) {
+        GLint read_framebuffer;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+        GLuint framebuffer;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        for (int32_t layer = 0; layer < _layers; ++layer) {
+            glFramebufferTextureLayer(
+                    GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _texture, 0, layer);
+            glCopyTexSubImage3D(
+                    GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0, kAtlasPageSize, kAtlasPageSize);
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &_texture);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    _texture = texture;
+    _layers  = layers;
+}
+
+OpenGlVideoDriver::OpenGlVideoDriver() : _static_seed{0} {}
+
+int OpenGlVideoDriver::scale() const { return viewport_size().width / screen_size().width; }
+
+Texture OpenGlVideoDriver::texture(pn::string_view name, const PixMap& content, int scale) {
+    return unique_ptr<Texture::Impl>(
+            new RectTextureImpl(name, content, scale, _uniforms, _batch, &_texture_bytes));
+}
+
+Texture OpenGlVideoDriver::sprite_texture(pn::string_view name, const PixMap& content) {
+    Atlas::Entry entry;
+    if (!_atlas.add(content, nullptr, &entry)) {
+        return texture(name, content, 1);
+    }
+    std::shared_ptr<const AtlasSpace> space(new AtlasSpace(_atlas, entry));
+    return unique_ptr<Texture::Impl>(new AtlasTextureImpl(
+            name, content.size(), _uniforms, _batch, space, false, Hue::GRAY));
+}
+
+Texture OpenGlVideoDriver::sprite_texture(
+        pn::string_view name, const PixMap& content, const PixMap& overlay) {
+    Atlas::Entry entry;
+    if (!_atlas.add(content, &overlay, &entry)) {
+        return nullptr;
+    }
+    std::shared_ptr<const AtlasSpace> space(new AtlasSpace(_atlas, entry));
+    return unique_ptr<Texture::Impl>(new AtlasTextureImpl(
+            name, content.size(), _uniforms, _batch, space, true, Hue::GRAY));
+}
+
+VideoDriver::DrawStats OpenGlVideoDriver::draw_stats() const {
+    DrawStats stats     = _draw_stats;
+    stats.texture_bytes = _texture_bytes + _atlas.bytes();
+    return stats;
+}
+
+void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    _batch.use(GL_TRIANGLES, FILL_MODE, 0);
+    _batch.add_quad(rect, Rect(), color);
+}
+
+void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    _batch.use(GL_TRIANGLES, DITHER_MODE, 0);
+    _batch.add_quad(rect, Rect(), color);
+}
+
+void OpenGlVideoDriver::batch_point(const Point& at, const RgbColor& color) {
+    _batch.use(GL_POINTS, FILL_MODE, 0);
+    *_batch.add(1) = {float(at.h + 0.5), float(at.v + 0.5), color.red, color.green, color.blue,
+                      color.alpha, 0, 0, {}};
+}
+
+void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
+    batch_point(at, color);
+}
 
 void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const RgbColor& color) {
     //
@@ -489,26 +920,10 @@ void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const Rgb
         y2 += 1.0f;
     }
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {x1, y1, x2, y2};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red, color.green, color.blue, color.alpha,
-            color.red, color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_LINES, 0, 2);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    _batch.use(GL_LINES, FILL_MODE, 0);
+    Batch::Vertex* v = _batch.add(2);
+    v[0]             = {x1, y1, color.red, color.green, color.blue, color.alpha, 0, 0, {}};
+    v[1]             = {x2, y2, color.red, color.green, color.blue, color.alpha, 0, 0, {}};
 }
 
 void OpenGlVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
@@ -556,9 +971,19 @@ void OpenGlVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
     _pluses[size].draw_shaded(to, color);
 }
 
-static GLuint make_shader(GLenum shader_type, const GLchar* source) {
-    GLuint shader = glCreateShader(shader_type);
-    glShaderSource(shader, 1, &source, NULL);
+// Compiles `source` with `defines` inserted just after its #version line. Only comments may come
+// before that line, and the defines must follow it, so they can't simply be prepended.
+static GLuint make_shader(GLenum shader_type, const GLchar* source, const GLchar* defines) {
+    const GLchar* version = strstr(source, "#version");
+    if (!version) {
+        throw std::runtime_error("shader has no #version line");
+    }
+    const GLchar* end       = strchr(version, '\n');
+    const GLchar* body      = end ? (end + 1) : (version + strlen(version));
+    const GLchar* parts[]   = {source, "\n", defines, body};
+    const GLint   lengths[] = {GLint(body - source), -1, -1, -1};
+    GLuint        shader    = glCreateShader(shader_type);
+    glShaderSource(shader, 4, parts, lengths);
     glCompileShader(shader);
     GLint compiled;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
@@ -569,17 +994,14 @@ static GLuint make_shader(GLenum shader_type, const GLchar* source) {
     return shader;
 }
 
-OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glClearColor(0, 0, 0, 1);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-
-    GLuint fragment = make_shader(GL_FRAGMENT_SHADER, glsl::fragment);
-    GLuint vertex   = make_shader(GL_VERTEX_SHADER, glsl::vertex);
+// Builds the program for `mode`, from the same source as every other.
+static GLuint make_program(int mode) {
+    const bool instanced = (mode == DRAW_SPRITE_MODE) || (mode == TINT_SPRITE_MODE) ||
+                           (mode == STATIC_SPRITE_MODE) || (mode == ANY_SPRITE_MODE);
+    pn::string defines =
+            pn::format("#define MODE {0}\n#define INSTANCED {1}\n", mode, instanced ? 1 : 0);
+    GLuint fragment = make_shader(GL_FRAGMENT_SHADER, glsl::fragment, defines.c_str());
+    GLuint vertex   = make_shader(GL_VERTEX_SHADER, glsl::vertex, defines.c_str());
 
     GLuint program = glCreateProgram();
     glAttachShader(program, fragment);
@@ -587,6 +1009,11 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glBindAttribLocation(program, 0, "vertex");
     glBindAttribLocation(program, 1, "in_color");
     glBindAttribLocation(program, 2, "tex_coord");
+    glBindAttribLocation(program, 3, "in_page");
+    glBindAttribLocation(program, 4, "in_tint");
+    glBindAttribLocation(program, 5, "in_dest");
+    glBindAttribLocation(program, 6, "in_source");
+    glBindAttribLocation(program, 7, "in_style");
     glLinkProgram(program);
     glValidateProgram(program);
     GLint linked;
@@ -595,23 +1022,24 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
         gl_log(program);
         throw std::runtime_error("linking failed");
     }
+    return program;
+}
 
-    GLuint array;
-    glGenVertexArrays(1, &array);
-    glBindVertexArray(array);
-
-    glGenBuffers(3, driver._vbuf);
+OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glClearColor(0, 0, 0, 1);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 
-    driver._uniforms.screen.load(program);
-    driver._uniforms.scale.load(program);
-    driver._uniforms.color_mode.load(program);
-    driver._uniforms.sprite.load(program);
-    driver._uniforms.static_image.load(program);
-    driver._uniforms.static_fraction.load(program);
-    driver._uniforms.unit.load(program);
-    driver._uniforms.outline_color.load(program);
-    driver._uniforms.seed.load(program);
-    glUseProgram(program);
+    GLuint programs[kShaderPrograms];
+    for (int mode = 0; mode < kShaderPrograms; ++mode) {
+        programs[mode] = make_program(mode);
+        driver._uniforms.load(mode, programs[mode]);
+    }
+    driver._batch.setup(programs);
 
     GLuint static_texture;
     glGenTextures(1, &static_texture);
@@ -630,8 +1058,27 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glTexImage2D(
             GL_TEXTURE_2D, 0, GL_RG, size, size, 0, GL_RG, GL_UNSIGNED_BYTE, static_data.get());
 
+    // Each shade of each hue, as RgbColor::tint() makes it, for tinting sprite overlays.
+    GLuint tint_texture;
+    glGenTextures(1, &tint_texture);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, tint_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ArrayPixMap tints(256, 16);
+    for (int hue = 0; hue < 16; ++hue) {
+        for (int shade = 0; shade < 256; ++shade) {
+            tints.set(shade, hue, RgbColor::tint(static_cast<Hue>(hue), shade));
+        }
+    }
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 16, 0, GL_BGRA, kPixelType, tints.bytes());
+
+    glActiveTexture(GL_TEXTURE0);
+
     driver._uniforms.sprite.set(0);
     driver._uniforms.static_image.set(1);
+    driver._uniforms.atlas.set(2);
+    driver._uniforms.tints.set(3);
 }
 
 OpenGlVideoDriver::MainLoop::MainLoop(OpenGlVideoDriver& driver, Card* initial)
@@ -641,6 +1088,15 @@ void OpenGlVideoDriver::MainLoop::draw() {
     if (done()) {
         return;
     }
+    record();
+    submit();
+}
+
+void OpenGlVideoDriver::MainLoop::record() {
+    if (done()) {
+        return;
+    }
+    ANTARES_TRACE("gl", "draw");
 
     glClear(GL_COLOR_BUFFER_BIT);
     glViewport(0, 0, _driver.viewport_size().width, _driver.viewport_size().height);
@@ -654,9 +1110,18 @@ void OpenGlVideoDriver::MainLoop::draw() {
     seed += _driver._static_seed.next(256);
     _driver._uniforms.seed.set(seed);
 
+    _driver._batch.set_timing(tick_profile.enabled());
     _stack.top()->draw();
+}
+
+void OpenGlVideoDriver::MainLoop::submit() {
+    ANTARES_TRACE("gl", "flush");
+    _driver._batch.flush();
 
+    ANTARES_TRACE("gl", "glFinish");
     glFinish();
+    _driver._batch.collect_times();
+    _driver._draw_stats = _driver._batch.take_stats();
 }
 
 bool OpenGlVideoDriver::MainLoop::done() const { return _stack.empty(); }